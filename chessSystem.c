@@ -1,5 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <limits.h>
 
 #include "chessSystem.h"
 #include "./mtm_map/map.h"
@@ -8,13 +10,76 @@
 #include "game.h"
 #include "player.h"
 #include "playerInTournament.h"
+#include "idFilter.h"
+#include "snapshot.h"
+#include "journal.h"
+#include "leaderboard.h"
 
 #define CHESS_INVALID_INPUT -10
-#define PLAYER_PLAYS_NO_GAMES_LVL -11
+#define CHESS_LOOKUP_BATCH 16
+#define CHESS_LOAD_BUFFER_SIZE (1 << 16)  // Longer lines of a game log are invalid
+#define CHESS_LOAD_BATCH 1024
 
 struct chess_system_t {
-    Map tournaments;
-    Map players;
+    TournamentMap tournaments;
+    PlayerMap players;
+
+    // Answer lookups of ids that were never added without searching the maps
+    IdFilter tournament_filter;
+    IdFilter player_filter;
+
+    Leaderboard leaderboard;    // All the players, ranked by their level
+
+    Journal journal;            // NULL if the calls are not journaled
+    int journal_sequence;       // The amount of calls that changed the system
+};
+
+// helper struct - prints the players' levels in a leaderboard walk
+typedef struct chess_level_printer_t {
+    FILE *file;
+    bool is_failed;
+} ChessLevelPrinter;
+
+// helper struct - the leading players' ids, filled by a leaderboard walk
+typedef struct chess_top_players_t {
+    int *player_ids;
+    int amount;
+    int amount_found;
+} ChessTopPlayers;
+
+// helper struct - a record of a batch (see chessAddGames), grouped by its tournament
+typedef struct chess_batch_entry_t {
+    int tournament_id;
+    int index;
+} ChessBatchEntry;
+
+// helper struct - the games of a game log that wait to be added as a batch
+typedef struct chess_game_loader_t {
+    ChessSystem chess;
+    FILE *error_file;               // NULL if the errors are not reported
+    ChessGameRecord *records;
+    int *line_numbers;              // The line of each record in the log
+    ChessResult *results;
+    int amount_of_records;
+} ChessGameLoader;
+
+static const char *const chess_result_names[] = {
+    "CHESS_OUT_OF_MEMORY",
+    "CHESS_NULL_ARGUMENT",
+    "CHESS_INVALID_ID",
+    "CHESS_INVALID_LOCATION",
+    "CHESS_INVALID_MAX_GAMES",
+    "CHESS_TOURNAMENT_ALREADY_EXISTS",
+    "CHESS_TOURNAMENT_NOT_EXIST",
+    "CHESS_GAME_ALREADY_EXISTS",
+    "CHESS_INVALID_PLAY_TIME",
+    "CHESS_EXCEEDED_GAMES",
+    "CHESS_PLAYER_NOT_EXIST",
+    "CHESS_TOURNAMENT_ENDED",
+    "CHESS_NO_TOURNAMENTS_ENDED",
+    "CHESS_NO_GAMES",
+    "CHESS_SAVE_FAILURE",
+    "CHESS_SUCCESS"
 };
 
 //==============================================================//
@@ -22,6 +87,106 @@ struct chess_system_t {
 //==============================================================//
 
 
+// Resets a filter to fit twice the ids of its map, and adds all of them to it.
+// If that fails, the filter is left disabled (so it never answers a wrong "no")
+static void chessRebuildIdFilter(IdFilter filter, Map map)
+{
+    if (idFilterReset(filter, 2 * mapGetSize(map)) != ID_FILTER_SUCCESS)
+    {
+        return;
+    }
+
+    MapCursor cursor;
+    bool has_id = mapCursorBeginReadOnly(map, &cursor);
+    if (!has_id && mapGetSize(map) > 0)
+    {
+        idFilterDisable(filter);
+        return;
+    }
+    while (has_id)
+    {
+        idFilterAdd(filter, *(int*)mapCursorKey(&cursor));
+        has_id = mapCursorNext(&cursor);
+    }
+}
+
+
+// Adds an id that was just put in a map to the map's filter, growing the filter if needed
+static void chessIdFilterAdd(IdFilter filter, Map map, int id)
+{
+    if (idFilterIsFull(filter))
+    {
+        chessRebuildIdFilter(filter, map);
+        return;
+    }
+    idFilterAdd(filter, id);
+}
+
+
+// Returns the player with a given ID, NULL if it doesn't exist.
+// Most IDs that don't exist are turned down by the filter, without searching the map
+static Player chessGetPlayer(ChessSystem chess, int player_id)
+{
+    if (!idFilterMayContain(chess->player_filter, player_id))
+    {
+        return NULL;
+    }
+    return PlayerMapGet(chess->players, player_id);
+}
+
+
+// Returns the tournament with a given ID, NULL if it doesn't exist (see chessGetPlayer)
+static Tournament chessGetTournament(ChessSystem chess, int tournament_id)
+{
+    if (!idFilterMayContain(chess->tournament_filter, tournament_id))
+    {
+        return NULL;
+    }
+    return TournamentMapGet(chess->tournaments, tournament_id);
+}
+
+
+// Returns a player that won't be changed, NULL if it doesn't exist (see mapGetReadOnly)
+static Player chessGetPlayerReadOnly(ChessSystem chess, int player_id)
+{
+    if (!idFilterMayContain(chess->player_filter, player_id))
+    {
+        return NULL;
+    }
+    return PlayerMapGetReadOnly(chess->players, player_id);
+}
+
+
+// Returns a tournament that won't be changed, NULL if it doesn't exist (see mapGetReadOnly)
+static Tournament chessGetTournamentReadOnly(ChessSystem chess, int tournament_id)
+{
+    if (!idFilterMayContain(chess->tournament_filter, tournament_id))
+    {
+        return NULL;
+    }
+    return TournamentMapGetReadOnly(chess->tournaments, tournament_id);
+}
+
+
+// Records a call that is about to change the system, in the journal if one is open
+static void chessJournalCall(ChessSystem chess, JournalRecordType type, const int values[],
+                             int amount_of_values, const char *location)
+{
+    (chess->journal_sequence)++;
+    if (chess->journal == NULL)
+    {
+        return;
+    }
+
+    JournalRecord record = { chess->journal_sequence, type, { 0 }, location };
+    for (int i = 0 ; i < amount_of_values ; i++)
+    {
+        record.values[i] = values[i];
+    }
+    journalAppend(chess->journal, &record);
+}
+
+
 // Translate error code from tournament to chess
 static ChessResult translateTournamentResultToChessResult(TournamentResult result)
 {
@@ -55,26 +220,8 @@ static ChessResult translateTournamentResultToChessResult(TournamentResult resul
 }
 
 
-// Checks if a player plays in a given tournament
-static bool isPlayerPlayingInTournament(ChessSystem chess, int player_id, int tournament_id)
-{
-    if (chess == NULL || player_id <= 0 || tournament_id <= 0)
-    {
-        return false;
-    }
-
-    Player wanted_player = mapGet(chess->players, &player_id);
-    if (wanted_player == NULL)
-    {
-        return false;
-    }
-
-    return playerIsPlayingInTournament(wanted_player, tournament_id);
-}
-
-
 // Checks if 2 players play against each other in a given tournament
-static bool isGameBetweenPlayersExists(ChessSystem chess, int tournament_id,
+static bool isGameBetweenPlayersExists(ChessSystem chess, Tournament tournament, int tournament_id,
                                        int first_player_id, int second_player_id)
 {
     if (chess == NULL)
@@ -82,8 +229,7 @@ static bool isGameBetweenPlayersExists(ChessSystem chess, int tournament_id,
         return false;
     }
     
-    Player first_player = mapGet(chess->players, &first_player_id);
-    Tournament tournament = mapGet(chess->tournaments, &tournament_id);
+    Player first_player = chessGetPlayerReadOnly(chess, first_player_id);
     
     if (first_player == NULL || tournament == NULL)
     {
@@ -116,42 +262,27 @@ static bool isGameBetweenPlayersExists(ChessSystem chess, int tournament_id,
 }
 
 
-// Checks if a given player is about to  exceed the maximum amount of game in a tournament
-static bool isPlayerInTournamentExceededGames(ChessSystem chess, int player_id,
-                                              int tournament_id)
-{
-    Player player = mapGet(chess->players, &player_id);
-    bool return_value = playerCanPlayMoreGamesInTournament(player, tournament_id);
-    return !(return_value);
-}
-
-
-// Verify the input is valid for the chessAddGame function
-static ChessResult chessAddGameVerifyInput(ChessSystem chess, int tournament_id, int first_player,
-                                int second_player, int play_time)
+// Verify the input is valid for the chessAddGame function.
+// The tournament was looked up by the caller, NULL if it doesn't exist
+static ChessResult chessAddGameVerifyInput(ChessSystem chess, Tournament tournament, int tournament_id,
+                                int first_player, int second_player)
 {
-    if (chess == NULL)
-    {
-        return CHESS_NULL_ARGUMENT;
-    }
-
     if (tournament_id <= 0 || first_player <= 0 || second_player <= 0  || first_player == second_player)
     {
         return CHESS_INVALID_ID;
     }
 
-    if (mapContains(chess->tournaments , &tournament_id) == false)
+    if (tournament == NULL)
     {
         return CHESS_TOURNAMENT_NOT_EXIST;
     }
      
-    Tournament tournament = mapGet(chess->tournaments, &tournament_id);
     if (tournamentGetWinner(tournament) > 0)
     {
         return CHESS_TOURNAMENT_ENDED;
     }
 
-    if (isGameBetweenPlayersExists(chess, tournament_id, first_player, second_player) == true)
+    if (isGameBetweenPlayersExists(chess, tournament, tournament_id, first_player, second_player) == true)
     {
         return CHESS_GAME_ALREADY_EXISTS;
     }
@@ -160,53 +291,68 @@ static ChessResult chessAddGameVerifyInput(ChessSystem chess, int tournament_id,
 }
 
 
-// Creates players if needed. Returns ChessResult according to the function's outcome
-static ChessResult chessAddGameCreatePlayersIfNeeded(ChessSystem chess,
-                                        int first_player, int second_player)
+// Gets the players' structs, creating the players if needed (a single map lookup each).
+// Structs that are already given (not NULL) are not looked up again.
+// Returns ChessResult according to the function's outcome
+static ChessResult chessAddGameGetOrCreatePlayers(ChessSystem chess, int first_player, int second_player,
+                                        Player *first_player_struct, Player *second_player_struct)
 {
     // Creating first_player if needed
     bool first_player_created = false; 
-    if (mapContains(chess->players, &first_player) == false)
+    if (*first_player_struct == NULL)
     {
-        Player first_player_struct = playerCreate(first_player);
-        if (first_player_struct == NULL)
-        {
-            return CHESS_OUT_OF_MEMORY;
-        }
-
-        MapResult put_result = mapPut(chess->players, &first_player, first_player_struct);
-        playerDestroy(first_player_struct);
+        *first_player_struct = mapGetOrCreate(PlayerMapAsMap(chess->players), &first_player,
+                                              playerCreateWrapper, &first_player_created);
+    }
+    if (*first_player_struct == NULL)
+    {
+        return CHESS_OUT_OF_MEMORY;
+    }
 
-        if (put_result != MAP_SUCCESS)
+    // Creating second_player if needed
+    bool second_player_created = false;
+    if (*second_player_struct == NULL)
+    {
+        *second_player_struct = mapGetOrCreate(PlayerMapAsMap(chess->players), &second_player,
+                                               playerCreateWrapper, &second_player_created);
+    }
+    if (*second_player_struct == NULL)
+    {
+        // Removing the first player if the operation failed
+        if (first_player_created)
         {
-            return CHESS_OUT_OF_MEMORY;
+            PlayerMapRemove(chess->players, first_player);
         }
-        first_player_created = true;
+        return CHESS_OUT_OF_MEMORY;
     }
 
-    // Creating second_player if needed
-    if (mapContains(chess->players, &second_player) == false)
+    // New players join the leaderboard (unranked until their game is added)
+    if ((first_player_created &&
+         leaderboardAdd(chess->leaderboard, first_player) != LEADERBOARD_SUCCESS) ||
+        (second_player_created &&
+         leaderboardAdd(chess->leaderboard, second_player) != LEADERBOARD_SUCCESS))
     {
-        Player second_player_struct = playerCreate(second_player);
-        if (second_player_struct == NULL)
+        if (first_player_created)
         {
-            return CHESS_OUT_OF_MEMORY;
+            leaderboardRemove(chess->leaderboard, first_player);
+            PlayerMapRemove(chess->players, first_player);
         }
-
-        MapResult put_result = mapPut(chess->players, &second_player, second_player_struct);
-        playerDestroy(second_player_struct);
-
-        if (put_result != MAP_SUCCESS)
+        if (second_player_created)
         {
-            // Removing the first player if the operation failed
-            if (first_player_created)
-            {
-                mapRemove(chess->players, &first_player);
-            }
-            return CHESS_OUT_OF_MEMORY;
+            leaderboardRemove(chess->leaderboard, second_player);
+            PlayerMapRemove(chess->players, second_player);
         }
+        return CHESS_OUT_OF_MEMORY;
     }
 
+    if (first_player_created)
+    {
+        chessIdFilterAdd(chess->player_filter, PlayerMapAsMap(chess->players), first_player);
+    }
+    if (second_player_created)
+    {
+        chessIdFilterAdd(chess->player_filter, PlayerMapAsMap(chess->players), second_player);
+    }
     return CHESS_SUCCESS;
 }
 
@@ -247,47 +393,76 @@ static ChessResult chessAddGameTournamentAndPlayer(Tournament tournament, Player
 }
 
 
-// Creates PlayerInTournaments for the players if needed,
-// updating the amount_of_new_players pointer in the process
-static ChessResult chessAddGameCreatePlayerInTournamentsIfNeeded(int tournament_id,
-                  Player first_player_struct, Player second_player_struct,
-                  int max_games_per_player, int *amount_of_new_players)
+// Creates a PlayerInTournament for a player if needed, and adds the player to the
+// tournament's participants. Updates the amount_of_new_players pointer in the process
+static ChessResult chessAddGameCreatePlayerInTournamentIfNeeded(Tournament tournament,
+                  int tournament_id, Player player_struct, int *amount_of_new_players)
 {
     // player's first game in tournament
-    if (playerGetGameIdsInTournament(first_player_struct, tournament_id) == NULL)
+    if (playerGetGameIdsInTournament(player_struct, tournament_id) != NULL)
     {
-        *amount_of_new_players += 1;
-        if (playerAddTournament(first_player_struct, tournament_id,
-                            max_games_per_player) == PLAYER_OUT_OF_MEMORY)
-        {
-            return CHESS_OUT_OF_MEMORY;
-        }
+        return CHESS_SUCCESS;
     }
 
-    if (playerGetGameIdsInTournament(second_player_struct, tournament_id) == NULL)
+    *amount_of_new_players += 1;
+    if (playerAddTournament(player_struct, tournament_id,
+                        tournamentGetMaxGamesPerPlayer(tournament)) == PLAYER_OUT_OF_MEMORY)
     {
-        *amount_of_new_players += 1;
-        if (playerAddTournament(second_player_struct, tournament_id,
-                            max_games_per_player) == PLAYER_OUT_OF_MEMORY)
-        {
-            return CHESS_OUT_OF_MEMORY;
-        }
+        return CHESS_OUT_OF_MEMORY;
+    }
+
+    if (tournamentAddParticipant(tournament, playerGetID(player_struct)) != TOURNAMENT_SUCCESS)
+    {
+        playerRemoveTournament(player_struct, tournament_id);
+        return CHESS_OUT_OF_MEMORY;
     }
 
     return CHESS_SUCCESS;
 }
 
 
+// Creates PlayerInTournaments for the players if needed,
+// updating the amount_of_new_players pointer in the process
+static ChessResult chessAddGameCreatePlayerInTournamentsIfNeeded(Tournament tournament,
+                  int tournament_id, Player first_player_struct, Player second_player_struct,
+                  int *amount_of_new_players)
+{
+    ChessResult create_result = chessAddGameCreatePlayerInTournamentIfNeeded(tournament,
+                                    tournament_id, first_player_struct, amount_of_new_players);
+    if (create_result != CHESS_SUCCESS)
+    {
+        return create_result;
+    }
+
+    return chessAddGameCreatePlayerInTournamentIfNeeded(tournament, tournament_id,
+                                    second_player_struct, amount_of_new_players);
+}
+
+
+// Sets the level of a player in the leaderboard, after the player's results changed
+static void chessUpdatePlayerLevel(ChessSystem chess, Player player)
+{
+    leaderboardUpdate(chess->leaderboard, playerGetID(player), playerGetLevelScore(player),
+                      playerGetTotalGames(player));
+}
+
+
+// Sets a player's standing in a tournament to the player's current record in it
+static void chessUpdateStanding(Tournament tournament, int tournament_id, Player player)
+{
+    tournamentUpdateStanding(tournament, playerGetID(player),
+                             playerGetWinsInTournament(player, tournament_id),
+                             playerGetDrawsInTournament(player, tournament_id),
+                             playerGetLossesInTournament(player, tournament_id));
+}
+
+
 // Updates the result of a game after a player was removed
-static void chessRemovePlayerUpdateGameResult(ChessSystem chess, int tournament_id,
-                                              int game_id, int player_id)
-{
-    // Get game, get opponent, update outcome
-    Tournament tournament = mapGet(chess->tournaments, &tournament_id);
-    Game current_game     = tournamentGetGame(tournament, game_id);
-    int opponent_id       = gameGetPlayersOpponent(current_game, player_id);
-    Player opponent       = mapGet(chess->players, &opponent_id);
-    int game_winner       = gameGetIdOfWinner(current_game);
+static void chessRemovePlayerUpdateGameResult(Game current_game, int tournament_id,
+                                              int opponent_id, Player opponent)
+{
+    // Update outcome
+    int game_winner = gameGetIdOfWinner(current_game);
     if (game_winner  == opponent_id)
     {
         return;
@@ -302,6 +477,47 @@ static void chessRemovePlayerUpdateGameResult(ChessSystem chess, int tournament_
 }
 
 
+// Updates the results of the games a removed player played in a tournament.
+// The opponents are looked up a batch at a time, so their lookups overlap
+static void chessRemovePlayerUpdateGameResults(ChessSystem chess, Tournament tournament,
+                                               int tournament_id, int *game_ids,
+                                               int amount_of_games, int player_id)
+{
+    for (int first = 0 ; first < amount_of_games ; first += CHESS_LOOKUP_BATCH)
+    {
+        Game games[CHESS_LOOKUP_BATCH];
+        int opponent_ids[CHESS_LOOKUP_BATCH];
+        MapKeyElement opponent_keys[CHESS_LOOKUP_BATCH];
+        MapDataElement opponents[CHESS_LOOKUP_BATCH];
+        int batch_size = amount_of_games - first < CHESS_LOOKUP_BATCH ?
+                         amount_of_games - first : CHESS_LOOKUP_BATCH;
+
+        for (int i = 0 ; i < batch_size ; i++)
+        {
+            games[i]         = tournamentGetGame(tournament, game_ids[first + i]);
+            opponent_ids[i]  = gameGetPlayersOpponent(games[i], player_id);
+            opponent_keys[i] = &(opponent_ids[i]);
+        }
+        if (mapGetMany(PlayerMapAsMap(chess->players), opponent_keys, batch_size,
+                       opponents) != MAP_SUCCESS)
+        {
+            return;
+        }
+
+        for (int i = 0 ; i < batch_size ; i++)
+        {
+            chessRemovePlayerUpdateGameResult(games[i], tournament_id, opponent_ids[i],
+                                              opponents[i]);
+            if (opponents[i] != NULL)
+            {
+                chessUpdateStanding(tournament, tournament_id, opponents[i]);
+                chessUpdatePlayerLevel(chess, opponents[i]);
+            }
+        }
+    }
+}
+
+
 // Verifies input for the chessRemovePlayer function
 static ChessResult chessRemovePlayerVerifyInput(ChessSystem chess, int player_id)
 {
@@ -315,7 +531,7 @@ static ChessResult chessRemovePlayerVerifyInput(ChessSystem chess, int player_id
         return CHESS_INVALID_ID;
     }
 
-    if (!mapContains(chess->players, &player_id))
+    if (chessGetPlayerReadOnly(chess, player_id) == NULL)
     {
         return CHESS_PLAYER_NOT_EXIST;
     }
@@ -324,238 +540,645 @@ static ChessResult chessRemovePlayerVerifyInput(ChessSystem chess, int player_id
 }
 
 
-// Calculates the score of a given player in a tournament
-static int chessCalculatePlayerScore(ChessSystem chess, int player_id, int tournament_id)
+// Returns the ID of the player that should win a tournament, by the tournament's standings.
+// A tournament whose players were all removed is won by the first player of the system
+static int chessTournamentGetWinner(ChessSystem chess, Tournament tournament)
 {
-    if (chess == NULL)
-    {
-        return CHESS_INVALID_INPUT;
-    }
-    
-    Player player = mapGet(chess->players, &player_id);
-    if (player == NULL)
+    int leader = tournamentGetLeader(tournament);
+    if (leader != INVALID_PLAYER)
     {
-        return CHESS_INVALID_INPUT;
+        return leader;
     }
 
-    int *game_ids = playerGetGameIdsInTournament(player, tournament_id);
-    if (game_ids == NULL)
+    MapCursor player_cursor;
+    if (!mapCursorBeginReadOnly(PlayerMapAsMap(chess->players), &player_cursor))
     {
-        return CHESS_INVALID_INPUT;
+        return INVALID_PLAYER;
     }
+    return *(int*)mapCursorKey(&player_cursor);
+}
 
-    Tournament tournament = mapGet(chess->tournaments, &tournament_id);
-    if (tournament == NULL)
-    {
-        return CHESS_INVALID_INPUT;
-    }
-    
-    int max_games_per_player = tournamentGetMaxGamesPerPlayer(tournament);
-    int score = 0;
-    for (int i = 0 ; i < max_games_per_player ; i++)
-    {
-        Game game = tournamentGetGame(tournament, game_ids[i]);
-        int game_winner = gameGetIdOfWinner(game);
-        if (game_winner == player_id)
-        {
-            score += TOURNAMENT_WIN_WEIGHT;
-        }
 
-        if (game_winner == INVALID_PLAYER)
+// Removes the records of a tournament from its participants
+static void chessRemoveTournamentFromPlayers(ChessSystem chess, Tournament tournament,
+                                             int tournament_id)
+{
+    int *participants = tournamentGetParticipants(tournament);
+    int amount_of_participants = tournamentGetSizeParticipants(tournament);
+    for (int i = 0 ; i < amount_of_participants ; i++)
+    {
+        Player player = chessGetPlayer(chess, participants[i]);
+        if (player != NULL)
         {
-            score += TOURNAMENT_DRAW_WEIGHT;
+            playerRemoveTournament(player, tournament_id);
+            chessUpdatePlayerLevel(chess, player);
         }
     }
+}
+
 
-    return score;
+// Adds the counters of a map to a total
+static void chessAddMapStats(ChessMapStats *total, const MapStats *stats)
+{
+    total->comparisons     += stats->comparisons;
+    total->lookups         += stats->lookups;
+    total->nodes_traversed += stats->nodes_traversed;
+    total->copy_calls      += stats->copy_calls;
+    total->free_calls      += stats->free_calls;
+    total->peak_size       += stats->peak_size;
 }
 
 
-// Returns the ID of the player that should be the winner, determined by score, wins, id...
-static int ChessTournamentComparePlayerWithWinner (ChessSystem chess, int tournament_id,
-                    int winner_id, int winner_score, int player_id, int *player_score)
+// mapForEachReadOnly visitor - adds the counters of a player's tournament records to a total
+static bool chessAddPlayerMapStats(void *player_id, void *player, void *total)
 {
-    if (chess == NULL || player_score == NULL)
+    MapStats stats;
+    if (playerGetTournamentsMapStats(player, &stats) == MAP_SUCCESS)
     {
-        return INVALID_PLAYER;
+        chessAddMapStats(total, &stats);
     }
+    return true;
+}
+
+
+// mapForEach visitor - zeroes the counters of a player's tournament records
+static bool chessResetPlayerMapStats(void *player_id, void *player, void *context)
+{
+    playerResetTournamentsMapStats(player);
+    return true;
+}
+
 
-    *player_score = chessCalculatePlayerScore(chess, player_id, tournament_id);
-    if (*player_score < winner_score)
+// Leaderboard visitor - prints a player's level, stopping the walk if printing failed
+static bool chessPrintPlayerLevel(int player_id, int level_score, int amount_of_games,
+                                  void *level_printer)
+{
+    ChessLevelPrinter *printer = level_printer;
+    double level = (double)level_score / amount_of_games;
+    printer->is_failed = fprintf(printer->file, "%d %.2f\n", player_id, level) < 0;
+    return !printer->is_failed;
+}
+
+
+// Leaderboard visitor - adds a player to the leading players, until there are enough of them
+static bool chessAddTopPlayer(int player_id, int level_score, int amount_of_games,
+                              void *top_players)
+{
+    ChessTopPlayers *top = top_players;
+    top->player_ids[top->amount_found] = player_id;
+    (top->amount_found)++;
+    return top->amount_found < top->amount;
+}
+
+
+// Adds a game to a tournament that was looked up already (NULL if it doesn't exist).
+// The players' structs that were looked up already are given, the rest are NULL
+static ChessResult chessAddGameToTournament(ChessSystem chess, Tournament tournament,
+                                const ChessGameRecord *record, Player first_player_struct,
+                                Player second_player_struct)
+{
+    // Verifying basic input
+    ChessResult verify_input = chessAddGameVerifyInput(chess, tournament, record->tournament_id,
+                                    record->first_player, record->second_player);
+    if (verify_input != CHESS_SUCCESS)
     {
-        return winner_id;
+        return verify_input;
     }
 
-    if (*player_score > winner_score)
+    // From here on the call may change the system, even if it fails
+    int journal_values[] = { record->tournament_id, record->first_player, record->second_player,
+                             record->winner, record->play_time };
+    chessJournalCall(chess, JOURNAL_ADD_GAME, journal_values, JOURNAL_MAX_VALUES, NULL);
+    
+    // Get the players' structs, creating the players if they don't exist in the system
+    ChessResult player_create_result = chessAddGameGetOrCreatePlayers(chess, record->first_player,
+                                        record->second_player, &first_player_struct,
+                                        &second_player_struct);
+    if (player_create_result != CHESS_SUCCESS)
     {
-        return player_id;
+        return player_create_result;
     }
 
-    // Both player share the same score
-    Player winner = mapGet(chess->players, &winner_id);
-    Player player = mapGet(chess->players, &player_id);
-    int loss_compare = playerGetLossesInTournament(winner, tournament_id) -
-                        playerGetLossesInTournament(player, tournament_id);
+    // Handling cases of a player never played in the tournament before
+    int amount_of_new_players = 0;
 
-    if (loss_compare < 0)
+    // Creating new PlayerInTournaments for the players if needed
+    ChessResult create_result = chessAddGameCreatePlayerInTournamentsIfNeeded(tournament,
+                        record->tournament_id, first_player_struct, second_player_struct,
+                        &amount_of_new_players);
+    if (create_result != CHESS_SUCCESS)
     {
-        return winner_id;
+        return create_result;
     }
 
-    if (loss_compare > 0)
+    // Check play time
+    if (record->play_time < 0)
     {
-        return player_id;
+        return CHESS_INVALID_PLAY_TIME;
     }
-    // Both players share the same amount of losses
-    int win_compare = playerGetWinsInTournament(winner, tournament_id) -
-                        playerGetWinsInTournament(player,tournament_id);
 
-    if (win_compare > 0)
+    // EXCEEDED GAMES
+    if (!playerCanPlayMoreGamesInTournament(first_player_struct, record->tournament_id) ||
+        !playerCanPlayMoreGamesInTournament(second_player_struct, record->tournament_id))
     {
-        return winner_id;
+        return CHESS_EXCEEDED_GAMES;
     }
 
-    if (win_compare < 0)
+    // Try to add the game
+    ChessResult add_result = chessAddGameTournamentAndPlayer(tournament,
+                        first_player_struct, second_player_struct,
+                        record->winner, record->play_time, amount_of_new_players);
+    if (add_result != CHESS_SUCCESS)
     {
-        return player_id;
+        return add_result;
     }
-    // Both players share the same amount of wins
-    return winner_id < player_id ? winner_id : player_id;
+
+    // Update the players' standings in the tournament, and their levels
+    chessUpdateStanding(tournament, record->tournament_id, first_player_struct);
+    chessUpdateStanding(tournament, record->tournament_id, second_player_struct);
+    chessUpdatePlayerLevel(chess, first_player_struct);
+    chessUpdatePlayerLevel(chess, second_player_struct);
+    return CHESS_SUCCESS;
 }
 
 
-// Calculates the winner in a given tournament and returns their ID
-static int ChessTournamentCalculateWinner (ChessSystem chess, int tournament_id)
+// qsort comparator - orders batch entries by tournament, keeping the records' order in each one
+static int chessCompareBatchEntries(const void *first, const void *second)
 {
-    if (chess == NULL)
+    const ChessBatchEntry *first_entry  = first;
+    const ChessBatchEntry *second_entry = second;
+    if (first_entry->tournament_id != second_entry->tournament_id)
     {
-        return INVALID_PLAYER;
+        return first_entry->tournament_id < second_entry->tournament_id ? -1 : 1;
     }
+    return first_entry->index - second_entry->index;
+}
 
-    // Initialize variables
-    Tournament tournament = mapGet(chess->tournaments, &tournament_id);
-    if (tournament == NULL)
-    {
-        return INVALID_PLAYER;
-    }
-    int amount_of_games = tournamentGetSizeGames(tournament);
-    int *player_iterator = mapGetFirst(chess->players);
-    if (player_iterator == NULL || amount_of_games == 0)
-    {
-        return INVALID_PLAYER;
-    }
 
-    // Iterate players, calculating winner
-    int winner_id     = *player_iterator;
-    int winner_score  = chessCalculatePlayerScore(chess, winner_id, tournament_id);
-    while (player_iterator)
+// Adds the games of a batch that belong to the same tournament, in the batch's order.
+// The tournament is looked up once, and the players a few records at a time
+static void chessAddGamesToTournament(ChessSystem chess, const ChessGameRecord *records,
+                                      ChessBatchEntry *entries, int amount_of_entries,
+                                      ChessResult *results)
+{
+    Tournament tournament = chessGetTournament(chess, entries[0].tournament_id);
+
+    // Make room for all of the games at once. If that fails, they make room one by one
+    tournamentReserveGames(tournament, amount_of_entries);
+
+    for (int first = 0 ; first < amount_of_entries ; first += CHESS_LOOKUP_BATCH / 2)
     {
-        bool is_playing = isPlayerPlayingInTournament(chess, *player_iterator, tournament_id);
-        if (!is_playing)
+        int player_ids[CHESS_LOOKUP_BATCH];
+        MapKeyElement player_keys[CHESS_LOOKUP_BATCH];
+        MapDataElement players[CHESS_LOOKUP_BATCH] = { NULL };
+        int batch_size = amount_of_entries - first < CHESS_LOOKUP_BATCH / 2 ?
+                         amount_of_entries - first : CHESS_LOOKUP_BATCH / 2;
+
+        // Players missing here (or created by an earlier record) are looked up again later
+        for (int i = 0 ; i < batch_size ; i++)
         {
-            free(player_iterator);
-            player_iterator = mapGetNext(chess->players);
-            continue;
+            const ChessGameRecord *record = &(records[entries[first + i].index]);
+            player_ids[2 * i]      = record->first_player;
+            player_ids[2 * i + 1]  = record->second_player;
+            player_keys[2 * i]     = &(player_ids[2 * i]);
+            player_keys[2 * i + 1] = &(player_ids[2 * i + 1]);
+        }
+        if (tournament != NULL && mapGetMany(PlayerMapAsMap(chess->players), player_keys,
+                                             2 * batch_size, players) != MAP_SUCCESS)
+        {
+            for (int i = 0 ; i < 2 * batch_size ; i++)
+            {
+                players[i] = NULL;
+            }
         }
 
-        int player_score = 0;
-        int new_winner = ChessTournamentComparePlayerWithWinner(chess, tournament_id, winner_id,
-                                            winner_score, *player_iterator, &player_score);
-        
-        if (new_winner == *player_iterator)
+        for (int i = 0 ; i < batch_size ; i++)
         {
-            winner_id = new_winner;
-            winner_score = player_score;
+            int index = entries[first + i].index;
+            results[index] = chessAddGameToTournament(chess, tournament, &(records[index]),
+                                                      players[2 * i], players[2 * i + 1]);
         }
-        free(player_iterator);
-        player_iterator = mapGetNext(chess->players);
     }
-
-    return winner_id;
 }
 
+// Checks if a char separates the fields of a game log line
+static bool chessIsLoadSeparator(char character)
+{
+    return character == ' ' || character == '\t' || character == ',' || character == '\r';
+}
 
 
-// Given a chess system, 2 arrays and their lengths, the function will get player
-// information (id & level) and write it to the given arrays
-static ChessResult buildPlayerIdAndLevelArrays(ChessSystem chess, int amount_of_players,
-                                                 int* player_id, double* player_level)
+// Parses an int field of a game log line, advancing the position past it.
+// Returns false if there is no valid int at the position
+static bool chessParseLoadInt(const char **position, const char *end, int *value)
 {
-    if (chess == NULL || player_id == NULL || player_level == NULL)
+    const char *current = *position;
+    while (current < end && chessIsLoadSeparator(*current))
     {
-        return CHESS_NULL_ARGUMENT;
+        current++;
     }
 
-    // Initialize iterator
-    int *player_iterator = mapGetFirst(chess->players);
-    int current_index = 0;
-    while (player_iterator)
+    bool is_negative = current < end && *current == '-';
+    if (is_negative)
     {
-        // Case - player played no games - doesn't count on the level calculation
-        // Initialize to needed values and move on
-        if (playerGetTotalGames(mapGet(chess->players, player_iterator)) == 0)
-        {
-            player_id[current_index]    = INVALID_PLAYER;
-            player_level[current_index] = PLAYER_PLAYS_NO_GAMES_LVL;
-            free(player_iterator);
-            player_iterator = mapGetNext(chess->players);
-            current_index++;
-            continue;
-        }
-        // Add player id and level to their array and move on
-        player_id[current_index]    = *player_iterator;
-        player_level[current_index] = playerGetLevel(mapGet(chess->players, player_iterator));
-        free(player_iterator);
-        player_iterator             = mapGetNext(chess->players);
-        current_index++;
+        current++;
     }
-    
-    return CHESS_SUCCESS;
-}
-
-
-// compares two doubles
-static int chessDoubleCompare (double num1, double num2)
-{
-    if (num1 - num2 < 0.00001 && num2 - num1 < 0.00001)
+    if (current == end || *current < '0' || *current > '9')
     {
-        return 0;
+        return false;
     }
-    if (num1 > num2)
+
+    // Accumulated as a negative number, so INT_MIN fits as well
+    int result = 0;
+    for ( ; current < end && *current >= '0' && *current <= '9' ; current++)
     {
-        return 1;
+        int digit = *current - '0';
+        if (result < (INT_MIN + digit) / 10)
+        {
+            return false;
+        }
+        result = result * 10 - digit;
+    }
+    if (!is_negative && result == INT_MIN)
+    {
+        return false;
+    }
+
+    // The field must end at a separator or at the end of the line
+    if (current < end && !chessIsLoadSeparator(*current))
+    {
+        return false;
+    }
+
+    *value    = is_negative ? result : -result;
+    *position = current;
+    return true;
+}
+
+
+// Parses a game log line - "tournament_id first_player second_player winner play_time",
+// separated by spaces, tabs or commas. winner is 0/1/2 (FIRST_PLAYER/SECOND_PLAYER/DRAW).
+// Returns false if the line is invalid
+static bool chessParseLoadLine(const char *line, const char *end, ChessGameRecord *record)
+{
+    int winner = 0;
+    if (!chessParseLoadInt(&line, end, &(record->tournament_id)) ||
+        !chessParseLoadInt(&line, end, &(record->first_player))  ||
+        !chessParseLoadInt(&line, end, &(record->second_player)) ||
+        !chessParseLoadInt(&line, end, &winner)                  ||
+        !chessParseLoadInt(&line, end, &(record->play_time)))
+    {
+        return false;
+    }
+
+    if (winner != FIRST_PLAYER && winner != SECOND_PLAYER && winner != DRAW)
+    {
+        return false;
+    }
+    record->winner = winner;
+
+    while (line < end && chessIsLoadSeparator(*line))
+    {
+        line++;
+    }
+    return line == end;
+}
+
+
+// Checks if a game log line has no game - it is empty or a comment (starts with '#')
+static bool chessIsLoadLineEmpty(const char *line, const char *end)
+{
+    while (line < end && chessIsLoadSeparator(*line))
+    {
+        line++;
+    }
+    return line == end || *line == '#';
+}
+
+
+// Reports an error of a game log line, if the errors are reported
+static void chessReportLoadError(ChessGameLoader *loader, int line_number, const char *error)
+{
+    if (loader->error_file != NULL)
+    {
+        fprintf(loader->error_file, "line %d: %s\n", line_number, error);
+    }
+}
+
+
+// Adds the games waiting in the loader as a batch, and reports the ones that weren't added
+static void chessFlushLoader(ChessGameLoader *loader)
+{
+    chessAddGames(loader->chess, loader->records, loader->amount_of_records, loader->results);
+    for (int i = 0 ; i < loader->amount_of_records ; i++)
+    {
+        if (loader->results[i] != CHESS_SUCCESS)
+        {
+            chessReportLoadError(loader, loader->line_numbers[i],
+                                 chess_result_names[loader->results[i]]);
+        }
+    }
+    loader->amount_of_records = 0;
+}
+
+
+// Handles a line of a game log - its game waits in the loader until the batch is full.
+// An invalid line is reported after the games before it, so errors are in the lines' order
+static void chessLoadLine(ChessGameLoader *loader, const char *line, const char *end,
+                          int line_number)
+{
+    if (chessIsLoadLineEmpty(line, end))
+    {
+        return;
+    }
+
+    ChessGameRecord *record = &(loader->records[loader->amount_of_records]);
+    if (!chessParseLoadLine(line, end, record))
+    {
+        chessFlushLoader(loader);
+        chessReportLoadError(loader, line_number, "invalid line");
+        return;
+    }
+
+    loader->line_numbers[loader->amount_of_records] = line_number;
+    (loader->amount_of_records)++;
+    if (loader->amount_of_records == CHESS_LOAD_BATCH)
+    {
+        chessFlushLoader(loader);
+    }
+}
+
+
+// Reads a game log through a buffer, a line at a time, handling each line.
+// Returns false if reading the file failed
+static bool chessLoadStream(ChessGameLoader *loader, FILE *file, char *buffer)
+{
+    int filled      = 0;
+    int line_number = 1;
+    bool skip_line  = false;    // The rest of a line too long for the buffer
+    bool is_eof     = false;
+    while (!is_eof || filled > 0)
+    {
+        if (!is_eof)
+        {
+            size_t read = fread(buffer + filled, 1, CHESS_LOAD_BUFFER_SIZE - filled, file);
+            filled += (int)read;
+            is_eof  = read == 0;
+            if (is_eof && ferror(file))
+            {
+                return false;
+            }
+        }
+
+        // Handle the complete lines of the buffer
+        char *line = buffer;
+        char *end  = buffer + filled;
+        char *newline;
+        while ((newline = memchr(line, '\n', end - line)) != NULL)
+        {
+            if (!skip_line)
+            {
+                chessLoadLine(loader, line, newline, line_number);
+            }
+            skip_line = false;
+            line = newline + 1;
+            line_number++;
+        }
+
+        // The last line of the file may have no newline
+        if (is_eof && line < end)
+        {
+            if (!skip_line)
+            {
+                chessLoadLine(loader, line, end, line_number);
+            }
+            line = end;
+        }
+
+        // Keep the start of the next line. A line that fills the buffer is invalid
+        filled = (int)(end - line);
+        if (filled == CHESS_LOAD_BUFFER_SIZE)
+        {
+            if (!skip_line)
+            {
+                chessFlushLoader(loader);
+                chessReportLoadError(loader, line_number, "line too long");
+            }
+            skip_line = true;
+            filled    = 0;
+        }
+        memmove(buffer, line, filled);
+    }
+    return true;
+}
+
+// Moves elements read from a snapshot, sorted by id, into an empty map at once.
+// On failure the reader fails, and the elements still belong to the caller
+static bool chessBuildMapFromSnapshot(SnapshotReader reader, Map map, int *ids,
+                                      MapDataElement *elements, int amount_of_elements)
+{
+    MapKeyElement *keys = malloc(amount_of_elements * sizeof(*keys));
+    if (keys == NULL && amount_of_elements > 0)
+    {
+        snapshotReaderFail(reader, SNAPSHOT_OUT_OF_MEMORY);
+        return false;
+    }
+    for (int i = 0 ; i < amount_of_elements ; i++)
+    {
+        keys[i] = &(ids[i]);
+    }
+
+    MapResult build_result = mapBuildFromSortedMove(map, keys, elements, amount_of_elements);
+    free(keys);
+    if (build_result != MAP_SUCCESS)
+    {
+        snapshotReaderFail(reader, build_result == MAP_OUT_OF_MEMORY ? SNAPSHOT_OUT_OF_MEMORY
+                                                                     : SNAPSHOT_INVALID_FILE);
+        return false;
+    }
+    return true;
+}
+
+
+// Reads the tournaments of a snapshot into the (empty) tournaments map
+static bool chessReadTournamentsSnapshot(ChessSystem chess, SnapshotReader reader)
+{
+    int amount_of_tournaments = 0;
+    if (!snapshotReadCount(reader, INT_MAX / (int)sizeof(MapKeyElement), SNAPSHOT_INT_SIZE,
+                           &amount_of_tournaments))
+    {
+        return false;
+    }
+
+    int *ids = malloc(amount_of_tournaments * sizeof(*ids));
+    MapDataElement *tournaments = malloc(amount_of_tournaments * sizeof(*tournaments));
+    int amount_read = 0;
+    if ((ids == NULL || tournaments == NULL) && amount_of_tournaments > 0)
+    {
+        snapshotReaderFail(reader, SNAPSHOT_OUT_OF_MEMORY);
+    }
+    else
+    {
+        for ( ; amount_read < amount_of_tournaments ; amount_read++)
+        {
+            tournaments[amount_read] = tournamentReadSnapshot(reader);
+            if (tournaments[amount_read] == NULL)
+            {
+                break;
+            }
+            ids[amount_read] = tournamentGetID(tournaments[amount_read]);
+        }
     }
 
-    return -1;
+    bool is_built = amount_read == amount_of_tournaments &&
+                    chessBuildMapFromSnapshot(reader, TournamentMapAsMap(chess->tournaments),
+                                              ids, tournaments, amount_of_tournaments);
+    if (!is_built)
+    {
+        for (int i = 0 ; i < amount_read ; i++)
+        {
+            tournamentDestroy(tournaments[i]);
+        }
+    }
+    free(ids);
+    free(tournaments);
+    return is_built;
 }
 
 
-// BUBBLE SORT -- update to merge/quick if there's time
-// Sorts 2 arrays, one of them being sorted in a regular fashion, the other one being
-// sorted according to the first one (values from same cells in 2 arrays are linked)
-static void sortLinkedArrays (double referenced_array[], int second_array[], int array_size)
+// Reads the players of a snapshot into the (empty) players map
+static bool chessReadPlayersSnapshot(ChessSystem chess, SnapshotReader reader)
 {
-    for (int i = 0 ; i < array_size ; i++)
+    int amount_of_players = 0;
+    if (!snapshotReadCount(reader, INT_MAX / (int)sizeof(MapKeyElement), SNAPSHOT_INT_SIZE,
+                           &amount_of_players))
+    {
+        return false;
+    }
+
+    int *ids = malloc(amount_of_players * sizeof(*ids));
+    MapDataElement *players = malloc(amount_of_players * sizeof(*players));
+    int amount_read = 0;
+    if ((ids == NULL || players == NULL) && amount_of_players > 0)
+    {
+        snapshotReaderFail(reader, SNAPSHOT_OUT_OF_MEMORY);
+    }
+    else
     {
-        for (int j = 0 ; j < array_size - i - 1 ; j++)
+        for ( ; amount_read < amount_of_players ; amount_read++)
         {
-            // Bubble sort - swap the cells if needed
-            int comparasion = chessDoubleCompare(referenced_array[j], referenced_array[j+1]);
-            if (comparasion < 0 || (comparasion == 0 && second_array[j] > second_array[j+1]))
+            players[amount_read] = playerReadSnapshot(reader);
+            if (players[amount_read] == NULL)
             {
-                double temp_double   = referenced_array[j];
-                referenced_array[j]   = referenced_array[j+1];
-                referenced_array[j+1] = temp_double;
+                break;
+            }
+            ids[amount_read] = playerGetID(players[amount_read]);
+        }
+    }
+
+    bool is_built = amount_read == amount_of_players &&
+                    chessBuildMapFromSnapshot(reader, PlayerMapAsMap(chess->players),
+                                              ids, players, amount_of_players);
+    if (!is_built)
+    {
+        for (int i = 0 ; i < amount_read ; i++)
+        {
+            playerDestroy(players[i]);
+        }
+    }
+    free(ids);
+    free(players);
+    return is_built;
+}
 
-                int temp_int = second_array[j];
-                second_array[j]   = second_array[j+1];
-                second_array[j+1] = temp_int;
+
+// Puts the players of a restored system in its leaderboard. Returns false if an
+// allocation failed
+static bool chessRestoreLeaderboard(ChessSystem chess)
+{
+    MapCursor player_cursor;
+    bool has_player = mapCursorBeginReadOnly(PlayerMapAsMap(chess->players), &player_cursor);
+
+    for ( ; has_player ; has_player = mapCursorNext(&player_cursor))
+    {
+        Player player = mapCursorData(&player_cursor);
+        if (leaderboardAdd(chess->leaderboard, playerGetID(player)) != LEADERBOARD_SUCCESS)
+        {
+            return false;
+        }
+        chessUpdatePlayerLevel(chess, player);
+    }
+    return true;
+}
+
+
+// Sets the standings of the active tournaments from their participants' records
+static void chessRestoreStandings(ChessSystem chess)
+{
+    MapCursor tournament_cursor;
+    bool has_tournament = mapCursorBegin(TournamentMapAsMap(chess->tournaments), &tournament_cursor);
+    for ( ; has_tournament ; has_tournament = mapCursorNext(&tournament_cursor))
+    {
+        Tournament tournament = mapCursorData(&tournament_cursor);
+        if (tournamentGetWinner(tournament) != INVALID_PLAYER)
+        {
+            continue;
+        }
+
+        int tournament_id = *(int*)mapCursorKey(&tournament_cursor);
+        int *participants = tournamentGetParticipants(tournament);
+        int amount_of_participants = tournamentGetSizeParticipants(tournament);
+        for (int i = 0 ; i < amount_of_participants ; i++)
+        {
+            Player player = PlayerMapGetReadOnly(chess->players, participants[i]);
+            if (player != NULL)
+            {
+                chessUpdateStanding(tournament, tournament_id, player);
             }
         }
     }
 }
 
 
+// Replays a journaled call on a system, unless its snapshot has the call already
+static bool chessReplayJournalRecord(const JournalRecord *record, void *context)
+{
+    ChessSystem chess = context;
+    if (record->sequence <= chess->journal_sequence)
+    {
+        return true;
+    }
+    // Calls between the snapshot and the journal are missing
+    if (record->sequence != chess->journal_sequence + 1)
+    {
+        return false;
+    }
+
+    // A call is replayed to the same result it had, unless an allocation fails
+    const int *values = record->values;
+    ChessResult result = CHESS_SUCCESS;
+    switch (record->type)
+    {
+        case JOURNAL_ADD_TOURNAMENT:
+            result = chessAddTournament(chess, values[0], values[1], record->location);
+            break;
+        case JOURNAL_ADD_GAME:
+            result = chessAddGame(chess, values[0], values[1], values[2], values[3], values[4]);
+            break;
+        case JOURNAL_REMOVE_TOURNAMENT:
+            result = chessRemoveTournament(chess, values[0]);
+            break;
+        case JOURNAL_REMOVE_PLAYER:
+            result = chessRemovePlayer(chess, values[0]);
+            break;
+        case JOURNAL_END_TOURNAMENT:
+            result = chessEndTournament(chess, values[0]);
+            break;
+    }
+    chess->journal_sequence = record->sequence;
+    return result != CHESS_OUT_OF_MEMORY;
+}
+
 //============================================================//
 //================== INTERNAL FUNCTIONS END ==================//
 //============================================================//
@@ -569,23 +1192,40 @@ ChessSystem chessCreate()
         return NULL;
     }
 
-    Map players     = createPlayersMap();
+    PlayerMap players         = createPlayersMap();
     if (players == NULL)
     {
         free(chess_system);
         return NULL;
     }
-    Map tournaments = createTournamentsMap();
+    TournamentMap tournaments = createTournamentsMap();
 
     if (tournaments == NULL)
     {
-        free(players);
+        PlayerMapDestroy(players);
+        free(chess_system);
+        return NULL;
+    }
+
+    chess_system->tournament_filter = idFilterCreate();
+    chess_system->player_filter     = idFilterCreate();
+    chess_system->leaderboard       = leaderboardCreate();
+    if (chess_system->tournament_filter == NULL || chess_system->player_filter == NULL ||
+        chess_system->leaderboard == NULL)
+    {
+        idFilterDestroy(chess_system->tournament_filter);
+        idFilterDestroy(chess_system->player_filter);
+        leaderboardDestroy(chess_system->leaderboard);
+        TournamentMapDestroy(tournaments);
+        PlayerMapDestroy(players);
         free(chess_system);
         return NULL;
     }
 
     chess_system->players = players;
     chess_system->tournaments = tournaments;
+    chess_system->journal = NULL;
+    chess_system->journal_sequence = 0;
 
     return chess_system;
 }
@@ -597,8 +1237,12 @@ void chessDestroy(ChessSystem chess)
         return;
     }
 
-    mapDestroy(chess->players);
-    mapDestroy(chess->tournaments);
+    journalClose(chess->journal);
+    leaderboardDestroy(chess->leaderboard);
+    PlayerMapDestroy(chess->players);
+    TournamentMapDestroy(chess->tournaments);
+    idFilterDestroy(chess->player_filter);
+    idFilterDestroy(chess->tournament_filter);
     free(chess);
 }
 
@@ -616,7 +1260,7 @@ ChessResult chessAddTournament (ChessSystem chess, int tournament_id,
         return CHESS_INVALID_ID;
     }
 
-    if (mapContains(chess->tournaments, &tournament_id))
+    if (chessGetTournamentReadOnly(chess, tournament_id) != NULL)
     {
         return CHESS_TOURNAMENT_ALREADY_EXISTS;
     }
@@ -631,18 +1275,22 @@ ChessResult chessAddTournament (ChessSystem chess, int tournament_id,
         return CHESS_INVALID_MAX_GAMES;
     }
 
+    int journal_values[] = { tournament_id, max_games_per_player };
+    chessJournalCall(chess, JOURNAL_ADD_TOURNAMENT, journal_values, 2, tournament_location);
+
     Tournament new_tournament = tournamentCreate(tournament_id, max_games_per_player, tournament_location);
     if (new_tournament == NULL)
     {
         return CHESS_OUT_OF_MEMORY;
     }
-    MapResult tournament_put_result = mapPut(chess->tournaments, &tournament_id, new_tournament);
-    tournamentDestroy(new_tournament); // A copy was sent to the map, no need for the object at this point
-
-    if (tournament_put_result == MAP_OUT_OF_MEMORY)
+    // The map takes the tournament itself, no copy is made
+    MapResult tournament_put_result = TournamentMapPutMove(chess->tournaments, tournament_id, new_tournament);
+    if (tournament_put_result != MAP_SUCCESS)
     {
+        tournamentDestroy(new_tournament);
         return CHESS_OUT_OF_MEMORY;
     }
+    chessIdFilterAdd(chess->tournament_filter, TournamentMapAsMap(chess->tournaments), tournament_id);
 
     return CHESS_SUCCESS;
 }
@@ -651,68 +1299,107 @@ ChessResult chessAddTournament (ChessSystem chess, int tournament_id,
 ChessResult chessAddGame(ChessSystem chess, int tournament_id, int first_player,
                                 int second_player, Winner winner, int play_time)
 {
-    // Verifying basic input
-    ChessResult verify_input = chessAddGameVerifyInput(chess, tournament_id,
-                                    first_player, second_player, play_time);
-    
-    if (verify_input != CHESS_SUCCESS)
+    if (chess == NULL)
     {
-        return verify_input;
+        return CHESS_NULL_ARGUMENT;
     }
-    
-    // Checks if players already exist in the system
-    ChessResult player_create_result = chessAddGameCreatePlayersIfNeeded(
-                                        chess, first_player, second_player);
-    if (player_create_result != CHESS_SUCCESS)
+
+    ChessGameRecord record = { tournament_id, first_player, second_player, winner, play_time };
+    return chessAddGameToTournament(chess, chessGetTournament(chess, tournament_id), &record,
+                                    NULL, NULL);
+}
+
+
+ChessResult chessAddGames(ChessSystem chess, const ChessGameRecord *records,
+                          int amount_of_records, ChessResult *results)
+{
+    if (chess == NULL || (amount_of_records > 0 && (records == NULL || results == NULL)))
     {
-        return player_create_result;
+        return CHESS_NULL_ARGUMENT;
     }
 
-    // Get the players' structs
-    Player first_player_struct = mapGet(chess->players, &first_player);
-    Player second_player_struct = mapGet(chess->players, &second_player);
-    if (first_player_struct == NULL || second_player_struct == NULL)
+    if (amount_of_records <= 0)
     {
-        return CHESS_OUT_OF_MEMORY; // Shouldn't get here
+        return CHESS_SUCCESS;
     }
 
-    // Handling cases of a player never played in the tournament before
-    int amount_of_new_players = 0;
-    Tournament tournament = mapGet(chess->tournaments, &tournament_id);
-    int max_games_per_player = tournamentGetMaxGamesPerPlayer(tournament);
-
-    // Creating new PlayerInTournaments for the players if needed
-    chessAddGameCreatePlayerInTournamentsIfNeeded(tournament_id, first_player_struct,
-                        second_player_struct, max_games_per_player, &amount_of_new_players);
+    // No room to group the records - add them one by one
+    ChessBatchEntry *entries = malloc(amount_of_records * sizeof(*entries));
+    if (entries == NULL)
+    {
+        for (int i = 0 ; i < amount_of_records ; i++)
+        {
+            results[i] = chessAddGame(chess, records[i].tournament_id, records[i].first_player,
+                                      records[i].second_player, records[i].winner,
+                                      records[i].play_time);
+        }
+        return CHESS_SUCCESS;
+    }
 
+    // Group the records by tournament. Games of different tournaments don't affect each
+    // other, so only the order within each tournament matters
+    for (int i = 0 ; i < amount_of_records ; i++)
+    {
+        entries[i].tournament_id = records[i].tournament_id;
+        entries[i].index         = i;
+    }
+    qsort(entries, amount_of_records, sizeof(*entries), chessCompareBatchEntries);
 
-    if (isGameBetweenPlayersExists(chess, tournament_id, first_player, second_player))
+    int group_start = 0;
+    for (int i = 1 ; i <= amount_of_records ; i++)
     {
-        return CHESS_GAME_ALREADY_EXISTS;
+        if (i == amount_of_records || entries[i].tournament_id != entries[group_start].tournament_id)
+        {
+            chessAddGamesToTournament(chess, records, entries + group_start, i - group_start,
+                                      results);
+            group_start = i;
+        }
     }
 
-    // Check play time
-    if (play_time < 0)
+    free(entries);
+    return CHESS_SUCCESS;
+}
+
+
+ChessResult chessLoadGamesFromFile (ChessSystem chess, const char* path_file, FILE* error_file)
+{
+    if (chess == NULL || path_file == NULL)
     {
-        return CHESS_INVALID_PLAY_TIME;
+        return CHESS_NULL_ARGUMENT;
     }
 
-    // EXCEEDED GAMES
-    if (isPlayerInTournamentExceededGames(chess, first_player, tournament_id) ||
-        isPlayerInTournamentExceededGames(chess, second_player, tournament_id))
+    // The buffers are allocated once, and reused for every line & batch of the file
+    ChessGameLoader loader = { chess, error_file, NULL, NULL, NULL, 0 };
+    char *buffer        = malloc(CHESS_LOAD_BUFFER_SIZE);
+    loader.records      = malloc(CHESS_LOAD_BATCH * sizeof(*(loader.records)));
+    loader.line_numbers = malloc(CHESS_LOAD_BATCH * sizeof(*(loader.line_numbers)));
+    loader.results      = malloc(CHESS_LOAD_BATCH * sizeof(*(loader.results)));
+    if (buffer == NULL || loader.records == NULL || loader.line_numbers == NULL ||
+        loader.results == NULL)
     {
-        return CHESS_EXCEEDED_GAMES;
+        free(buffer);
+        free(loader.records);
+        free(loader.line_numbers);
+        free(loader.results);
+        return CHESS_OUT_OF_MEMORY;
     }
 
-    // Try to add the game, return the result
-    return chessAddGameTournamentAndPlayer(tournament,
-                        first_player_struct, second_player_struct,
-                        winner, play_time, amount_of_new_players);
+    ChessResult result = CHESS_SAVE_FAILURE;
+    FILE *file = fopen(path_file, "r");
+    if (file != NULL)
+    {
+        result = chessLoadStream(&loader, file, buffer) ? CHESS_SUCCESS : CHESS_SAVE_FAILURE;
+        chessFlushLoader(&loader);
+        fclose(file);
+    }
 
+    free(buffer);
+    free(loader.records);
+    free(loader.line_numbers);
+    free(loader.results);
+    return result;
 }
 
-
-
 ChessResult chessRemoveTournament (ChessSystem chess, int tournament_id)
 {
     if (chess == NULL)
@@ -725,26 +1412,19 @@ ChessResult chessRemoveTournament (ChessSystem chess, int tournament_id)
         return CHESS_INVALID_ID;
     }
 
-    if (!(mapContains(chess->tournaments, &tournament_id)))
+    Tournament tournament = chessGetTournamentReadOnly(chess, tournament_id);
+    if (tournament == NULL)
     {
         return CHESS_TOURNAMENT_NOT_EXIST;
     }
+    chessJournalCall(chess, JOURNAL_REMOVE_TOURNAMENT, &tournament_id, 1, NULL);
 
-    // Remove the tournament 
-    mapRemove(chess->tournaments, &tournament_id);
+    // Remove tournament records and stats from its players
+    chessRemoveTournamentFromPlayers(chess, tournament, tournament_id);
 
-    // Remove tournament records and stats from players
-    int  *player_iterator = mapGetFirst(chess->players);
-    while (player_iterator != NULL)
-    {
-        Player player = mapGet(chess->players, player_iterator);
-        if (playerIsPlayingInTournament(player, tournament_id))
-        {
-            playerRemoveTournament(player, tournament_id);
-        }
-        free(player_iterator);
-        player_iterator = mapGetNext(chess->players);
-    }
+    // Remove the tournament 
+    TournamentMapRemove(chess->tournaments, tournament_id);
+    idFilterRemove(chess->tournament_filter, tournament_id);
 
     return CHESS_SUCCESS;
 }
@@ -757,9 +1437,10 @@ ChessResult chessRemovePlayer(ChessSystem chess, int player_id)
     {
         return input_verification;
     }
+    chessJournalCall(chess, JOURNAL_REMOVE_PLAYER, &player_id, 1, NULL);
 
     // Get the player, initialize iterator for his tournaments
-    Player player = mapGet(chess->players, &player_id);
+    Player player = chessGetPlayer(chess, player_id);
     int *tournament_id_ptr = playerGetFirstTournamentID(player);
     
     // Scan the tournaments that the player participated in
@@ -768,11 +1449,12 @@ ChessResult chessRemovePlayer(ChessSystem chess, int player_id)
         int tournament_id = *tournament_id_ptr;
         free(tournament_id_ptr);
         tournament_id_ptr = playerGetNextTournamentID(player);
-        Tournament tournament = mapGet(chess->tournaments, &tournament_id);
+        Tournament tournament = chessGetTournament(chess, tournament_id);
 
         // Tournament ended, advance to the next one
         if (tournamentGetWinner(tournament) != INVALID_PLAYER)
         {
+            tournamentRemoveParticipant(tournament, player_id);
             continue;
         }
 
@@ -780,23 +1462,23 @@ ChessResult chessRemovePlayer(ChessSystem chess, int player_id)
         int *game_ids = playerGetGameIdsInTournament(player, tournament_id);
         int max_games_per_player = tournamentGetMaxGamesPerPlayer(tournament);
 
-        // Scan games
-        for (int i = 0 ; i < max_games_per_player ; i++)
+        // Scan games, updating the opponents' stats
+        int amount_of_games = 0;
+        while (amount_of_games < max_games_per_player &&
+               game_ids[amount_of_games] != INVALID_GAME_ID)
         {
-            if (game_ids[i] == INVALID_GAME_ID)
-            {
-                break;
-            }
-            
-            // Update the opponent's stats 
-            chessRemovePlayerUpdateGameResult(chess, tournament_id, game_ids[i], player_id);
+            amount_of_games++;
         }
+        chessRemovePlayerUpdateGameResults(chess, tournament, tournament_id, game_ids,
+                                           amount_of_games, player_id);
 
         // Remove player from tournament - updates all game records
         tournamentRemovePlayer(tournament, player_id, game_ids);
     }
     
-    mapRemove(chess->players, &player_id);
+    leaderboardRemove(chess->leaderboard, player_id);
+    PlayerMapRemove(chess->players, player_id);
+    idFilterRemove(chess->player_filter, player_id);
     return CHESS_SUCCESS;
 }
 
@@ -812,7 +1494,7 @@ ChessResult chessEndTournament (ChessSystem chess, int tournament_id)
         return CHESS_INVALID_ID;
     }
 
-    Tournament tournament = mapGet(chess->tournaments, &tournament_id);
+    Tournament tournament = chessGetTournament(chess, tournament_id);
     if (tournament == NULL)
     {
         return CHESS_TOURNAMENT_NOT_EXIST;
@@ -827,13 +1509,51 @@ ChessResult chessEndTournament (ChessSystem chess, int tournament_id)
     {
         return CHESS_NO_GAMES;
     }
-    
-    // Calculate the winner, end the tournament and return the result
-    int tournament_winner = ChessTournamentCalculateWinner(chess, tournament_id);
+    chessJournalCall(chess, JOURNAL_END_TOURNAMENT, &tournament_id, 1, NULL);
+
+    // Get the winner, end the tournament and return the result
+    int tournament_winner = chessTournamentGetWinner(chess, tournament);
     return translateTournamentResultToChessResult(tournamentEnd(tournament, tournament_winner));
 
 }
 
+int chessGetTournamentLeader (ChessSystem chess, int tournament_id, ChessResult* chess_result)
+{
+    // Input validation
+    if (chess_result == NULL)
+    {
+        return CHESS_INVALID_INPUT;
+    }
+
+    if (chess == NULL)
+    {
+        *chess_result = CHESS_NULL_ARGUMENT;
+        return CHESS_INVALID_INPUT;
+    }
+
+    if (tournament_id <= 0)
+    {
+        *chess_result = CHESS_INVALID_ID;
+        return CHESS_INVALID_INPUT;
+    }
+
+    Tournament tournament = chessGetTournamentReadOnly(chess, tournament_id);
+    if (tournament == NULL)
+    {
+        *chess_result = CHESS_TOURNAMENT_NOT_EXIST;
+        return CHESS_INVALID_INPUT;
+    }
+
+    if (tournamentGetSizeGames(tournament) == 0)
+    {
+        *chess_result = CHESS_NO_GAMES;
+        return CHESS_INVALID_INPUT;
+    }
+
+    *chess_result = CHESS_SUCCESS;
+    return chessTournamentGetWinner(chess, tournament);
+}
+
 double chessCalculateAveragePlayTime (ChessSystem chess, int player_id, ChessResult* chess_result)
 {
     // Input validation
@@ -854,7 +1574,7 @@ double chessCalculateAveragePlayTime (ChessSystem chess, int player_id, ChessRes
         return CHESS_INVALID_INPUT;
     }
 
-    Player player = mapGet(chess->players, &player_id);
+    Player player = chessGetPlayerReadOnly(chess, player_id);
     if (player == NULL)
     {
         *chess_result = CHESS_PLAYER_NOT_EXIST;
@@ -864,51 +1584,69 @@ double chessCalculateAveragePlayTime (ChessSystem chess, int player_id, ChessRes
     return playerGetFinishedGamesAverageTime(player);
 }
 
-ChessResult chessSavePlayersLevels (ChessSystem chess, FILE* file)
+int chessGetPlayerRank (ChessSystem chess, int player_id, ChessResult* chess_result)
 {
+    if (chess_result == NULL)
+    {
+        return CHESS_INVALID_INPUT;
+    }
+
     if (chess == NULL)
     {
-        return CHESS_NULL_ARGUMENT;
+        *chess_result = CHESS_NULL_ARGUMENT;
+        return CHESS_INVALID_INPUT;
     }
-    
-    // Initialize arrays for player levels and ids
-    int amount_of_players = mapGetSize(chess->players);
-    int *player_id_array    = malloc(amount_of_players*sizeof(int));
-    if (player_id_array == NULL)
+
+    if (player_id <= 0)
     {
-        return CHESS_OUT_OF_MEMORY;
+        *chess_result = CHESS_INVALID_ID;
+        return CHESS_INVALID_INPUT;
     }
-    double *player_level_array = malloc(amount_of_players*sizeof(double));
-    if (player_level_array == NULL)
+
+    if (chessGetPlayerReadOnly(chess, player_id) == NULL)
     {
-        free(player_id_array);
-        return CHESS_OUT_OF_MEMORY;
+        *chess_result = CHESS_PLAYER_NOT_EXIST;
+        return CHESS_INVALID_INPUT;
     }
 
-    // Fill the arrays with values and sort the arrays according to the levels
-    buildPlayerIdAndLevelArrays(chess, amount_of_players, player_id_array, player_level_array);
-    sortLinkedArrays(player_level_array, player_id_array, amount_of_players);
+    *chess_result = CHESS_SUCCESS;
+    return leaderboardGetRank(chess->leaderboard, player_id);
+}
 
-    // Print the levels to files
-    for (int i = 0 ; i < amount_of_players ; i++)
+int chessGetTopPlayers (ChessSystem chess, int amount, int* player_ids, ChessResult* chess_result)
+{
+    if (chess_result == NULL)
     {
-        if (player_id_array[i] < 0)
-        {
-            break;
-        }
-        int result = fprintf(file, "%d %.2f\n", player_id_array[i], player_level_array[i]);
-        if (result < 0)
-        {
-            free(player_level_array);
-            free(player_id_array);
-            return CHESS_SAVE_FAILURE;
-        }
+        return CHESS_INVALID_INPUT;
     }
 
-    free(player_level_array);
-    free(player_id_array);
+    if (chess == NULL || (amount > 0 && player_ids == NULL))
+    {
+        *chess_result = CHESS_NULL_ARGUMENT;
+        return CHESS_INVALID_INPUT;
+    }
 
-    return CHESS_SUCCESS;
+    // Only the first players of the leaderboard are walked
+    ChessTopPlayers top_players = { player_ids, amount, 0 };
+    if (amount > 0)
+    {
+        leaderboardForEach(chess->leaderboard, chessAddTopPlayer, &top_players);
+    }
+    *chess_result = CHESS_SUCCESS;
+    return top_players.amount_found;
+}
+
+ChessResult chessSavePlayersLevels (ChessSystem chess, FILE* file)
+{
+    if (chess == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    // The players are printed by a walk of the leaderboard, in rank order
+    ChessLevelPrinter printer = { file, false };
+    leaderboardForEach(chess->leaderboard, chessPrintPlayerLevel, &printer);
+    return printer.is_failed ? CHESS_SAVE_FAILURE : CHESS_SUCCESS;
 }
 
 
@@ -921,19 +1659,19 @@ ChessResult chessSaveTournamentStatistics (ChessSystem chess, char* path_file)
 
     // Initialize variables
     bool is_tournament_ended = false;
-    int *tournament_id_iterator = mapGetFirst(chess->tournaments);
+    MapCursor tournament_cursor;
+    bool has_tournament = mapCursorBeginReadOnly(TournamentMapAsMap(chess->tournaments),
+                                                 &tournament_cursor);
     FILE *output_file = fopen(path_file, "w+");
 
     // Iteration
-    while (tournament_id_iterator != NULL)
+    for ( ; has_tournament ; has_tournament = mapCursorNext(&tournament_cursor))
     {
-        Tournament tournament = mapGet(chess->tournaments, tournament_id_iterator);
+        Tournament tournament = mapCursorData(&tournament_cursor);
         
         // Tournament is ongoing
         if (tournamentGetWinner(tournament) == INVALID_PLAYER)
         {
-            free(tournament_id_iterator);
-            tournament_id_iterator = mapGetNext(chess->tournaments);
             continue;
         }
 
@@ -945,11 +1683,8 @@ ChessResult chessSaveTournamentStatistics (ChessSystem chess, char* path_file)
         if (print_result == false)
         {
             fclose(output_file);
-            free(tournament_id_iterator);
             return CHESS_SAVE_FAILURE;
         }
-        free(tournament_id_iterator);
-        tournament_id_iterator = mapGetNext(chess->tournaments);
     }
 
     fclose(output_file);
@@ -959,4 +1694,226 @@ ChessResult chessSaveTournamentStatistics (ChessSystem chess, char* path_file)
     }
 
     return CHESS_SUCCESS;
-}
\ No newline at end of file
+}
+
+ChessResult chessSaveSnapshot (ChessSystem chess, const char* path_file)
+{
+    if (chess == NULL || path_file == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    // Both maps are written in ascending id order, so they can be built at once
+    MapCursor tournament_cursor;
+    MapCursor player_cursor;
+    bool has_tournament = mapCursorBeginReadOnly(TournamentMapAsMap(chess->tournaments),
+                                                 &tournament_cursor);
+    bool has_player     = mapCursorBeginReadOnly(PlayerMapAsMap(chess->players), &player_cursor);
+    if ((!has_tournament && TournamentMapGetSize(chess->tournaments) > 0) ||
+        (!has_player && PlayerMapGetSize(chess->players) > 0))
+    {
+        return CHESS_OUT_OF_MEMORY;
+    }
+
+    SnapshotWriter writer = snapshotWriterCreate(path_file);
+    if (writer == NULL)
+    {
+        return CHESS_SAVE_FAILURE;
+    }
+
+    snapshotWriteInt(writer, chess->journal_sequence);
+    snapshotWriteInt(writer, TournamentMapGetSize(chess->tournaments));
+    for ( ; has_tournament ; has_tournament = mapCursorNext(&tournament_cursor))
+    {
+        tournamentWriteSnapshot(mapCursorData(&tournament_cursor), writer);
+    }
+
+    bool is_written = true;
+    snapshotWriteInt(writer, PlayerMapGetSize(chess->players));
+    for ( ; has_player && is_written ; has_player = mapCursorNext(&player_cursor))
+    {
+        is_written = playerWriteSnapshot(mapCursorData(&player_cursor), writer) == PLAYER_SUCCESS;
+    }
+
+    // A partial snapshot must not replace the previous one - the journal isn't restarted
+    // either, so recovering still has both of them
+    if (!is_written)
+    {
+        snapshotWriterAbort(writer);
+        return CHESS_OUT_OF_MEMORY;
+    }
+    if (snapshotWriterClose(writer) != SNAPSHOT_SUCCESS)
+    {
+        return CHESS_SAVE_FAILURE;
+    }
+
+    // The snapshot has every journaled call now. If emptying the journal fails, its
+    // calls are skipped when recovering, and the error is kept by the journal
+    if (chess->journal != NULL)
+    {
+        journalRestart(chess->journal);
+    }
+    return CHESS_SUCCESS;
+}
+
+ChessSystem chessLoadSnapshot (const char* path_file)
+{
+    SnapshotReader reader = snapshotReaderCreate(path_file);
+    if (reader == NULL)
+    {
+        return NULL;
+    }
+
+    ChessSystem chess = chessCreate();
+    if (chess == NULL)
+    {
+        snapshotReaderClose(reader);
+        return NULL;
+    }
+
+    // The whole file is read before it's known to be valid
+    if (snapshotReadCount(reader, INT_MAX, 0, &(chess->journal_sequence)) &&
+        chessReadTournamentsSnapshot(chess, reader))
+    {
+        chessReadPlayersSnapshot(chess, reader);
+    }
+    if (snapshotReaderClose(reader) != SNAPSHOT_SUCCESS)
+    {
+        chessDestroy(chess);
+        return NULL;
+    }
+
+    if (!chessRestoreLeaderboard(chess))
+    {
+        chessDestroy(chess);
+        return NULL;
+    }
+    chessRestoreStandings(chess);
+    chessRebuildIdFilter(chess->tournament_filter, TournamentMapAsMap(chess->tournaments));
+    chessRebuildIdFilter(chess->player_filter, PlayerMapAsMap(chess->players));
+    return chess;
+}
+
+ChessResult chessJournalOpen (ChessSystem chess, const char* path_file, int sync_every_calls,
+                              int sync_every_ms)
+{
+    if (chess == NULL || path_file == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    ChessResult close_result = chessJournalClose(chess);
+    if (close_result != CHESS_SUCCESS)
+    {
+        return close_result;
+    }
+
+    int last_sequence = JOURNAL_NO_RECORDS;
+    Journal journal = journalOpen(path_file, sync_every_calls, sync_every_ms, &last_sequence);
+    if (journal == NULL)
+    {
+        return CHESS_SAVE_FAILURE;
+    }
+
+    // A journal of calls this system doesn't have yet is kept - it should be recovered
+    if (last_sequence > chess->journal_sequence)
+    {
+        journalClose(journal);
+        return CHESS_SAVE_FAILURE;
+    }
+    // Otherwise the journal continues from this system's calls
+    if (last_sequence != chess->journal_sequence && journalRestart(journal) != JOURNAL_SUCCESS)
+    {
+        journalClose(journal);
+        return CHESS_SAVE_FAILURE;
+    }
+
+    chess->journal = journal;
+    return CHESS_SUCCESS;
+}
+
+ChessResult chessJournalSync (ChessSystem chess)
+{
+    if (chess == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    if (chess->journal == NULL)
+    {
+        return CHESS_SUCCESS;
+    }
+    return journalSync(chess->journal) == JOURNAL_SUCCESS ? CHESS_SUCCESS : CHESS_SAVE_FAILURE;
+}
+
+ChessResult chessJournalClose (ChessSystem chess)
+{
+    if (chess == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    if (chess->journal == NULL)
+    {
+        return CHESS_SUCCESS;
+    }
+    JournalResult close_result = journalClose(chess->journal);
+    chess->journal = NULL;
+    return close_result == JOURNAL_SUCCESS ? CHESS_SUCCESS : CHESS_SAVE_FAILURE;
+}
+
+ChessSystem chessRecover (const char* snapshot_path_file, const char* journal_path_file)
+{
+    ChessSystem chess = snapshot_path_file == NULL ? chessCreate()
+                                                   : chessLoadSnapshot(snapshot_path_file);
+    if (chess == NULL)
+    {
+        return NULL;
+    }
+
+    if (journal_path_file != NULL &&
+        journalReplay(journal_path_file, chessReplayJournalRecord, chess) != JOURNAL_SUCCESS)
+    {
+        chessDestroy(chess);
+        return NULL;
+    }
+    return chess;
+}
+
+ChessResult chessGetMapStats (ChessSystem chess, ChessMapStats* stats)
+{
+    if (chess == NULL || stats == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+
+    // Read the players map's counters before iterating over it adds to them
+    MapStats map_stats;
+    if (mapGetStats(PlayerMapAsMap(chess->players), &map_stats) == MAP_SUCCESS)
+    {
+        chessAddMapStats(stats, &map_stats);
+    }
+    if (mapGetStats(TournamentMapAsMap(chess->tournaments), &map_stats) == MAP_SUCCESS)
+    {
+        chessAddMapStats(stats, &map_stats);
+    }
+    mapForEachReadOnly(PlayerMapAsMap(chess->players), chessAddPlayerMapStats, stats);
+
+    return CHESS_SUCCESS;
+}
+
+ChessResult chessResetMapStats (ChessSystem chess)
+{
+    if (chess == NULL)
+    {
+        return CHESS_NULL_ARGUMENT;
+    }
+
+    mapForEach(PlayerMapAsMap(chess->players), chessResetPlayerMapStats, NULL);
+    mapResetStats(PlayerMapAsMap(chess->players));
+    mapResetStats(TournamentMapAsMap(chess->tournaments));
+
+    return CHESS_SUCCESS;
+}
@@ -33,6 +33,25 @@ typedef enum {
     DRAW
 } Winner;
 
+/** Type for a game to add to the system in a batch (see chessAddGames) */
+typedef struct {
+    int tournament_id;
+    int first_player;
+    int second_player;
+    Winner winner;
+    int play_time;
+} ChessGameRecord;
+
+/** Type for the counters of the work done by the maps of a system (see chessGetMapStats) */
+typedef struct {
+    long comparisons;       // Key comparisons
+    long lookups;           // Searches for a key
+    long nodes_traversed;   // Nodes (hashed maps - slots) visited by the searches
+    long copy_calls;        // Calls to the elements' copy functions
+    long free_calls;        // Calls to the elements' free functions
+    int peak_size;          // Sum of the greatest amounts of elements the maps held at once
+} ChessMapStats;
+
 /** Type for representing a chess system that organizes chess tournaments */
 typedef struct chess_system_t *ChessSystem;
 
@@ -100,6 +119,55 @@ ChessResult chessAddTournament (ChessSystem chess, int tournament_id,
 ChessResult chessAddGame(ChessSystem chess, int tournament_id, int first_player,
                          int second_player, Winner winner, int play_time);
 
+/**
+ * chessAddGames: adds a batch of games, with the same result for every game as adding
+ *                the games one by one (in the records' order) with chessAddGame.
+ *                The records are grouped by tournament, so each tournament is looked up
+ *                once and makes room for its games at once.
+ *
+ * @param chess - chess system that contains the tournaments. Must be non-NULL.
+ * @param records - the games to add.
+ * @param amount_of_records - the amount of records.
+ * @param results - an array of amount_of_records results. results[i] is set to the result
+ *                  of records[i], as returned by chessAddGame.
+ *
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess is NULL, or there are records and records/results are NULL.
+ *     CHESS_SUCCESS - otherwise (even if some of the games weren't added).
+ */
+ChessResult chessAddGames(ChessSystem chess, const ChessGameRecord *records,
+                          int amount_of_records, ChessResult *results);
+
+/**
+ * chessLoadGamesFromFile: adds the games of a game log file, in the file's order, as if
+ *                         each of them was added with chessAddGame. The file is read in a
+ *                         single pass through a fixed size buffer, so it may be of any size.
+ *
+ *                         Every line of the file is a game -
+ *                         "tournament_id first_player second_player winner play_time",
+ *                         separated by spaces, tabs or commas, where winner is 0 (FIRST_PLAYER),
+ *                         1 (SECOND_PLAYER) or 2 (DRAW). Empty lines and lines starting with '#'
+ *                         are skipped.
+ *
+ *                         Lines that couldn't be added are reported to error_file, in the
+ *                         file's order, one per line - "line <number>: <error>", where error
+ *                         is the name of the ChessResult of the game, "invalid line" if
+ *                         the line couldn't be parsed, or "line too long" if the line
+ *                         doesn't fit in the buffer.
+ *
+ * @param chess - chess system to add the games to. Must be non-NULL.
+ * @param path_file - the path of the game log.
+ * @param error_file - an open, writable output stream for the errors, or NULL to not
+ *                     report them.
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or path_file are NULL.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed. No games were added.
+ *     CHESS_SAVE_FAILURE - if the file couldn't be opened or read. The games that were
+ *                          read before a read error were added.
+ *     CHESS_SUCCESS - if the whole file was read (even if some of the games weren't added).
+ */
+ChessResult chessLoadGamesFromFile (ChessSystem chess, const char* path_file, FILE* error_file);
+
 /**
  * chessRemoveTournament: removes the tournament and all the games played in it from the chess system
  *                        updates all players statistics (wins, losses, draws, average play time).
@@ -156,6 +224,24 @@ ChessResult chessRemovePlayer(ChessSystem chess, int player_id);
  */
 ChessResult chessEndTournament (ChessSystem chess, int tournament_id);
 
+/**
+ * chessGetTournamentLeader: returns the id of the player that would win the tournament
+ *                           if it ended now (see chessEndTournament), without ending it.
+ *                           If the tournament already ended, its winner is returned.
+ *
+ * @param chess - chess system that contains the tournament. Must be non-NULL.
+ * @param tournament_id - the tournament id. Must be positive.
+ * @param chess_result - this variable will contain the returned error code.
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess is NULL.
+ *     CHESS_INVALID_ID - if the tournament ID number is invalid.
+ *     CHESS_TOURNAMENT_NOT_EXIST - if the tournament does not exist in the system.
+ *     CHESS_NO_GAMES - if the tournament does not have any games.
+ *     CHESS_SUCCESS - if the leader was returned successfully.
+ *     On failure, a negative value is returned.
+ */
+int chessGetTournamentLeader (ChessSystem chess, int tournament_id, ChessResult* chess_result);
+
 /**
  * chessCalculateAveragePlayTime: the function returns the average playing time for a particular player
  *
@@ -170,6 +256,40 @@ ChessResult chessEndTournament (ChessSystem chess, int tournament_id);
  */
 double chessCalculateAveragePlayTime (ChessSystem chess, int player_id, ChessResult* chess_result);
 
+/**
+ * chessGetPlayerRank: returns the rank of a player by their level (see
+ *                     chessSavePlayersLevels) - 1 for the player printed first - in O(log n).
+ *                     The ranking is kept up to date as games are added and removed.
+ *
+ * @param chess - a chess system that contains the player. Must be non-NULL.
+ * @param player_id - player ID. Must be positive.
+ * @param chess_result - this variable will contain the returned error code.
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess is NULL.
+ *     CHESS_INVALID_ID - if the player ID number is invalid.
+ *     CHESS_PLAYER_NOT_EXIST - if the player does not exist in the system.
+ *     CHESS_SUCCESS - if the rank was returned successfully. The rank is 0 if the player
+ *                     has no games (and so no level).
+ *     On failure, a negative value is returned.
+ */
+int chessGetPlayerRank (ChessSystem chess, int player_id, ChessResult* chess_result);
+
+/**
+ * chessGetTopPlayers: fills the ids of the leading players by their level, in the order
+ *                     chessSavePlayersLevels prints them, in O(log n + amount).
+ *
+ * @param chess - a chess system. Must be non-NULL.
+ * @param amount - the amount of players to return.
+ * @param player_ids - an array of at least amount ints, filled with the players' ids.
+ * @param chess_result - this variable will contain the returned error code.
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess is NULL, or player_ids is NULL and amount is positive.
+ *     CHESS_SUCCESS - if the players were returned successfully.
+ *     The amount of ids filled - less than amount if fewer players have games.
+ *     On failure, a negative value is returned.
+ */
+int chessGetTopPlayers (ChessSystem chess, int amount, int* player_ids, ChessResult* chess_result);
+
 /**
  * chessSavePlayersLevels: prints the rating of all players in the system as
  * explained in the *.pdf
@@ -197,4 +317,127 @@ ChessResult chessSavePlayersLevels (ChessSystem chess, FILE* file);
  */
 ChessResult chessSaveTournamentStatistics (ChessSystem chess, char* path_file);
 
+/**
+ * chessSaveSnapshot: saves the whole system (tournaments, games, players and their records)
+ *                    to a binary snapshot file, which chessLoadSnapshot restores.
+ *                    The file is versioned, and ends with a checksum of its contents.
+ *
+ * @param chess - a chess system. Must be non-NULL.
+ * @param path_file - the path of the snapshot file. An existing file is replaced.
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or path_file are NULL.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed.
+ *     CHESS_SAVE_FAILURE - if an error occurred while saving.
+ *     CHESS_SUCCESS - if the snapshot was saved successfully.
+ */
+ChessResult chessSaveSnapshot (ChessSystem chess, const char* path_file);
+
+/**
+ * chessLoadSnapshot: creates a chess system from a snapshot saved by chessSaveSnapshot.
+ *                    The system is built directly from the file, without adding the
+ *                    tournaments and games one by one.
+ *
+ * @param path_file - the path of the snapshot file.
+ * @return
+ *     The restored chess system, or NULL if path_file is NULL, the file couldn't be read,
+ *     is of another snapshot version, is corrupted (its checksum doesn't match), or in
+ *     case of an allocation error.
+ */
+ChessSystem chessLoadSnapshot (const char* path_file);
+
+/**
+ * chessJournalOpen: starts journaling the calls that change the system (adding tournaments
+ *                   and games, removing tournaments and players, ending tournaments) to an
+ *                   append-only file. Every such call is recorded before it's applied, and
+ *                   chessRecover replays the journal on top of the latest snapshot.
+ *
+ *                   Calls are made durable (synced to the disk) in groups, so a call
+ *                   doesn't cost a sync of its own. A group is synced once it has
+ *                   sync_every_calls calls, or once its first call waited sync_every_ms
+ *                   milliseconds (checked when calls are made), or by chessJournalSync.
+ *                   A snapshot saved by chessSaveSnapshot has every journaled call, so the
+ *                   journal is emptied once it's saved.
+ *
+ *                   The journal continues an existing file if its last call is the last
+ *                   call of the system (e.g. a system returned by chessRecover with the
+ *                   same file), and starts over otherwise. A journal already open is closed.
+ *
+ * @param chess - a chess system. Must be non-NULL.
+ * @param path_file - the path of the journal file.
+ * @param sync_every_calls - the amount of calls in a group. 0 or less for no limit.
+ * @param sync_every_ms - the time a call may wait for its group. 0 or less for no limit.
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or path_file are NULL.
+ *     CHESS_SAVE_FAILURE - if the file couldn't be opened, or it has calls that this system
+ *                          doesn't (recover the system from it first).
+ *     CHESS_SUCCESS - if the journal was opened successfully.
+ */
+ChessResult chessJournalOpen (ChessSystem chess, const char* path_file, int sync_every_calls,
+                              int sync_every_ms);
+
+/**
+ * chessJournalSync: makes every call journaled so far durable.
+ *
+ * @param chess - a chess system. Must be non-NULL.
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess is NULL.
+ *     CHESS_SAVE_FAILURE - if writing any call to the journal failed since it was opened.
+ *     CHESS_SUCCESS - otherwise (also if no journal is open).
+ */
+ChessResult chessJournalSync (ChessSystem chess);
+
+/**
+ * chessJournalClose: syncs the journal and stops journaling calls. chessDestroy closes the
+ *                    journal as well.
+ *
+ * @param chess - a chess system. Must be non-NULL.
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess is NULL.
+ *     CHESS_SAVE_FAILURE - if writing any call to the journal failed since it was opened.
+ *     CHESS_SUCCESS - otherwise (also if no journal is open).
+ */
+ChessResult chessJournalClose (ChessSystem chess);
+
+/**
+ * chessRecover: restores a chess system from its latest snapshot, and replays the calls of
+ *               its journal that came after the snapshot. A call that was cut while being
+ *               journaled (e.g. when the process died) ends the journal.
+ *
+ * @param snapshot_path_file - the path of the snapshot file, NULL to start from an empty
+ *     system (if no snapshot was saved).
+ * @param journal_path_file - the path of the journal file, NULL for no journal. A file that
+ *     doesn't exist is an empty journal.
+ * @return
+ *     The recovered chess system, or NULL if the snapshot couldn't be loaded, the journal
+ *     couldn't be read, calls between the snapshot and the journal are missing, or in case
+ *     of an allocation error.
+ */
+ChessSystem chessRecover (const char* snapshot_path_file, const char* journal_path_file);
+
+/**
+ * chessGetMapStats: sums the counters of the work done by all the maps of the system -
+ * the players map, the tournaments map and the tournament records of every player (the
+ * scans of the records a player keeps inline count as lookups, until they move to a map).
+ * The counters are collected only when compiled with MAP_STATS (cmake -DMAP_STATS=ON),
+ * otherwise they are all 0. peak_size is the sum of the maps' peak sizes.
+ *
+ * @param chess - a chess system. Must be non-NULL.
+ * @param stats - filled with the summed counters. Must be non-NULL.
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or stats are NULL.
+ *     CHESS_SUCCESS - otherwise.
+ */
+ChessResult chessGetMapStats (ChessSystem chess, ChessMapStats* stats);
+
+/**
+ * chessResetMapStats: zeroes the counters of all the maps of the system, e.g. to measure
+ * the work of a single operation with chessGetMapStats.
+ *
+ * @param chess - a chess system. Must be non-NULL.
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess is NULL.
+ *     CHESS_SUCCESS - otherwise.
+ */
+ChessResult chessResetMapStats (ChessSystem chess);
+
 #endif //HW1_CHESSSYSTEM_H
@@ -9,6 +9,7 @@ struct game_t {
     int second_player;
     int play_time;
     GameWinner winner;
+    int share_count;    // The amount of holders of the game (see gameShare)
 };
 
 
@@ -28,6 +29,7 @@ Game gameCreate(int tournament_id, int first_player, int second_player, GameWinn
     game->second_player = second_player;
     game->play_time     = play_time;
     game->winner        = winner;
+    game->share_count   = 1;
 
     return game;
 }
@@ -39,6 +41,13 @@ void gameDestroy(Game game)
     {
         return;
     }
+
+    // Other holders still use the game
+    (game->share_count)--;
+    if (game->share_count > 0)
+    {
+        return;
+    }
     free(game);
 }
 
@@ -57,6 +66,34 @@ Game gameCopy(Game game)
 }
 
 
+Game gameShare(Game game)
+{
+    if (game == NULL)
+    {
+        return NULL;
+    }
+    (game->share_count)++;
+    return game;
+}
+
+
+Game gameUnshare(Game game)
+{
+    if (game == NULL || game->share_count == 1)
+    {
+        return game;
+    }
+
+    Game new_game = gameCopy(game);
+    if (new_game == NULL)
+    {
+        return NULL;
+    }
+    (game->share_count)--;
+    return new_game;
+}
+
+
 GameResult gameRemovePlayer(Game game, int player_id)
 {
     // Validate input
@@ -171,4 +208,44 @@ int gameGetPlayersOpponent(Game game, int player_id)
     }
 
     return game->first_player;
-}
\ No newline at end of file
+}
+
+
+void gameWriteSnapshot(Game game, SnapshotWriter writer)
+{
+    if (game == NULL)
+    {
+        return;
+    }
+    snapshotWriteInt(writer, game->first_player);
+    snapshotWriteInt(writer, game->second_player);
+    snapshotWriteInt(writer, game->winner);
+    snapshotWriteInt(writer, game->play_time);
+}
+
+
+Game gameReadSnapshot(SnapshotReader reader, int tournament_id, int game_id)
+{
+    int first_player  = 0;
+    int second_player = 0;
+    int winner        = 0;
+    int play_time     = 0;
+    if (!snapshotReadInt(reader, &first_player) || !snapshotReadInt(reader, &second_player) ||
+        !snapshotReadInt(reader, &winner)       || !snapshotReadInt(reader, &play_time))
+    {
+        return NULL;
+    }
+
+    if (winner != GAME_FIRST_PLAYER && winner != GAME_SECOND_PLAYER && winner != GAME_DRAW)
+    {
+        snapshotReaderFail(reader, SNAPSHOT_INVALID_FILE);
+        return NULL;
+    }
+
+    Game game = gameCreate(tournament_id, first_player, second_player, winner, play_time, game_id);
+    if (game == NULL)
+    {
+        snapshotReaderFail(reader, SNAPSHOT_OUT_OF_MEMORY);
+    }
+    return game;
+}
@@ -3,6 +3,7 @@
 
 #include <stdio.h>
 #include <stdbool.h>
+#include "snapshot.h"
 
 #define INVALID_GAME_ID -1
 #define GAME_INVALID_INPUT -10
@@ -63,6 +64,30 @@ void gameDestroy(Game game);
 Game gameCopy(Game game);
 
 
+/**
+ * gameShare: Adds a holder to a game, without copying it. Every holder frees the game
+ * with gameDestroy - the game itself is freed once its last holder does.
+ *
+ * @param game - the game to share
+ *
+ * @return The same game, NULL if game is NULL
+ */
+Game gameShare(Game game);
+
+
+/**
+ * gameUnshare: Returns a game the caller may change without affecting the other holders
+ * of a game. If the caller is the only holder, the game itself is returned. Otherwise the
+ * caller gives up its hold on the game for a copy of it.
+ *
+ * @param game - the game the caller holds
+ *
+ * @return The caller's own game, NULL if game is NULL or in case of an allocation error
+ *     (the caller still holds the original game then)
+ */
+Game gameUnshare(Game game);
+
+
 /**
  * gameRemovePlayer: Remove a player from a game, updating the winner if needed
  *
@@ -156,4 +181,26 @@ int gameGetTournamentID(Game game);
  */
 int gameGetPlayersOpponent(Game game, int player_id);
 
+
+/**
+ * gameWriteSnapshot: writes a game to a snapshot. Its tournament & id aren't written -
+ *                    they are known from where it is in the snapshot.
+ *
+ * @param game   - the game
+ * @param writer - the snapshot writer
+ */
+void gameWriteSnapshot(Game game, SnapshotWriter writer);
+
+
+/**
+ * gameReadSnapshot: reads a game written by gameWriteSnapshot.
+ *
+ * @param reader        - the snapshot reader
+ * @param tournament_id - the id of the tournament of the game
+ * @param game_id       - the id of the game
+ *
+ * @return A new game in case of success, and NULL otherwise (the reader then fails)
+ */
+Game gameReadSnapshot(SnapshotReader reader, int tournament_id, int game_id);
+
 #endif // _GAME_H
\ No newline at end of file
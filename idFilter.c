@@ -0,0 +1,189 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+
+#include "idFilter.h"
+
+#define ID_FILTER_MIN_COUNTERS     64
+#define ID_FILTER_COUNTERS_PER_ID  16   // When reset - about 0.5% false positives
+#define ID_FILTER_MAX_LOAD         8    // Full at 1 id per 8 counters - about 3%
+#define ID_FILTER_HASH_COUNT       3
+
+
+struct id_filter_t {
+    unsigned char *counters;    // NULL when the filter is disabled
+    int amount_of_counters;     // A power of 2
+    int amount_of_ids;
+};
+
+//==============================================================//
+//================== INTERNAL FUNCTIONS START ==================//
+//==============================================================//
+
+// 32 bit finalizer of MurmurHash3 - spreads nearby ids over the whole filter
+static unsigned int idFilterHash(unsigned int key)
+{
+    key ^= key >> 16;
+    key *= 0x85ebca6bu;
+    key ^= key >> 13;
+    key *= 0xc2b2ae35u;
+    key ^= key >> 16;
+    return key;
+}
+
+// Fills the indexes of an id's counters (double hashing - h1 + i * h2)
+static void idFilterGetIndexes(IdFilter filter, int id, int indexes[])
+{
+    unsigned int first_hash  = idFilterHash((unsigned int)id);
+    unsigned int second_hash = idFilterHash(first_hash ^ 0x9e3779b9u) | 1u;
+    unsigned int mask        = (unsigned int)(filter->amount_of_counters - 1);
+    for (int i = 0 ; i < ID_FILTER_HASH_COUNT ; i++)
+    {
+        indexes[i] = (int)((first_hash + (unsigned int)i * second_hash) & mask);
+    }
+}
+
+//============================================================//
+//================== INTERNAL FUNCTIONS END ==================//
+//============================================================//
+
+
+IdFilter idFilterCreate()
+{
+    IdFilter filter = malloc(sizeof(*filter));
+    if (filter == NULL)
+    {
+        return NULL;
+    }
+
+    filter->counters           = NULL;
+    filter->amount_of_counters = 0;
+    filter->amount_of_ids      = 0;
+    if (idFilterReset(filter, 0) != ID_FILTER_SUCCESS)
+    {
+        free(filter);
+        return NULL;
+    }
+    return filter;
+}
+
+
+void idFilterDestroy(IdFilter filter)
+{
+    if (filter == NULL)
+    {
+        return;
+    }
+    free(filter->counters);
+    free(filter);
+}
+
+
+void idFilterAdd(IdFilter filter, int id)
+{
+    if (filter == NULL || filter->counters == NULL)
+    {
+        return;
+    }
+
+    int indexes[ID_FILTER_HASH_COUNT];
+    idFilterGetIndexes(filter, id, indexes);
+    for (int i = 0 ; i < ID_FILTER_HASH_COUNT ; i++)
+    {
+        if (filter->counters[indexes[i]] < UCHAR_MAX)
+        {
+            filter->counters[indexes[i]]++;
+        }
+    }
+    filter->amount_of_ids++;
+}
+
+
+void idFilterRemove(IdFilter filter, int id)
+{
+    if (filter == NULL || filter->counters == NULL)
+    {
+        return;
+    }
+
+    // Saturated counters may stand for more ids than they counted - keep them
+    int indexes[ID_FILTER_HASH_COUNT];
+    idFilterGetIndexes(filter, id, indexes);
+    for (int i = 0 ; i < ID_FILTER_HASH_COUNT ; i++)
+    {
+        if (filter->counters[indexes[i]] > 0 && filter->counters[indexes[i]] < UCHAR_MAX)
+        {
+            filter->counters[indexes[i]]--;
+        }
+    }
+    filter->amount_of_ids--;
+}
+
+
+bool idFilterMayContain(IdFilter filter, int id)
+{
+    if (filter == NULL || filter->counters == NULL)
+    {
+        return true;
+    }
+
+    int indexes[ID_FILTER_HASH_COUNT];
+    idFilterGetIndexes(filter, id, indexes);
+    for (int i = 0 ; i < ID_FILTER_HASH_COUNT ; i++)
+    {
+        if (filter->counters[indexes[i]] == 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+bool idFilterIsFull(IdFilter filter)
+{
+    if (filter == NULL)
+    {
+        return false;
+    }
+    return filter->counters == NULL ||
+           filter->amount_of_ids >= filter->amount_of_counters / ID_FILTER_MAX_LOAD;
+}
+
+
+IdFilterResult idFilterReset(IdFilter filter, int amount_of_ids)
+{
+    if (filter == NULL)
+    {
+        return ID_FILTER_NULL_ARGUMENT;
+    }
+
+    int amount_of_counters = ID_FILTER_MIN_COUNTERS;
+    while (amount_of_counters / ID_FILTER_COUNTERS_PER_ID < amount_of_ids &&
+           amount_of_counters <= INT_MAX / 2)
+    {
+        amount_of_counters *= 2;
+    }
+
+    idFilterDisable(filter);
+    filter->counters = calloc(amount_of_counters, sizeof(*(filter->counters)));
+    if (filter->counters == NULL)
+    {
+        return ID_FILTER_OUT_OF_MEMORY;
+    }
+    filter->amount_of_counters = amount_of_counters;
+    return ID_FILTER_SUCCESS;
+}
+
+
+void idFilterDisable(IdFilter filter)
+{
+    if (filter == NULL)
+    {
+        return;
+    }
+    free(filter->counters);
+    filter->counters           = NULL;
+    filter->amount_of_counters = 0;
+    filter->amount_of_ids      = 0;
+}
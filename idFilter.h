@@ -0,0 +1,106 @@
+#ifndef _ID_FILTER_H
+#define _ID_FILTER_H
+
+#include <stdio.h>
+#include <stdbool.h>
+
+typedef enum {
+    ID_FILTER_OUT_OF_MEMORY,
+    ID_FILTER_NULL_ARGUMENT,
+    ID_FILTER_SUCCESS
+} IdFilterResult ;
+
+
+/**
+ * Type for a counting Bloom filter over int ids. The filter answers "definitely
+ * not added" in O(1), without touching the map that holds the ids, and may rarely
+ * answer "maybe added" for an id that wasn't. Every id has a few small counters,
+ * so ids can be removed as well. A counter that reached its maximum is never
+ * decremented again, which keeps the filter correct (only less precise).
+ *
+ * A disabled filter (see idFilterDisable) answers "maybe added" for every id.
+ */
+typedef struct id_filter_t *IdFilter;
+
+/**
+ * idFilterCreate: create an empty filter.
+ *
+ * @return A new IdFilter in case of success, and NULL otherwise (e.g.
+ *     in case of an allocation error)
+ */
+IdFilter idFilterCreate();
+
+
+/**
+ * idFilterDestroy: free a filter from memory.
+ *
+ * @param filter - the filter to free from memory. A NULL value is
+ *     allowed, and in that case the function does nothing.
+ */
+void idFilterDestroy(IdFilter filter);
+
+
+/**
+ * idFilterAdd: adds an id to the filter.
+ *
+ * @param filter - the filter
+ * @param id - the id to add
+ */
+void idFilterAdd(IdFilter filter, int id);
+
+
+/**
+ * idFilterRemove: removes an id added to the filter.
+ *
+ * @param filter - the filter
+ * @param id - the id to remove. Must have been added (and not removed since).
+ */
+void idFilterRemove(IdFilter filter, int id);
+
+
+/**
+ * idFilterMayContain: checks whether an id may have been added to the filter.
+ *
+ * @param filter - the filter
+ * @param id - the id to check
+ *
+ * @return false if the id definitely wasn't added, true otherwise
+ *     (including a NULL filter)
+ */
+bool idFilterMayContain(IdFilter filter, int id);
+
+
+/**
+ * idFilterIsFull: checks whether the filter holds too many ids to stay precise.
+ * A full filter should be reset for a greater amount of ids, and refilled.
+ *
+ * @param filter - the filter
+ *
+ * @return true if the filter is full or disabled, false otherwise
+ */
+bool idFilterIsFull(IdFilter filter);
+
+
+/**
+ * idFilterReset: empties the filter, making room for a given amount of ids.
+ *
+ * @param filter - the filter
+ * @param amount_of_ids - the amount of ids the filter should fit
+ *
+ * @return
+ *     ID_FILTER_NULL_ARGUMENT - if filter is NULL
+ *     ID_FILTER_OUT_OF_MEMORY - if an allocation failed. The filter is then disabled
+ *     ID_FILTER_SUCCESS       - otherwise
+ */
+IdFilterResult idFilterReset(IdFilter filter, int amount_of_ids);
+
+
+/**
+ * idFilterDisable: makes the filter answer "maybe added" for every id, until it is
+ * reset. Used when the ids it should hold can't all be added to it.
+ *
+ * @param filter - the filter
+ */
+void idFilterDisable(IdFilter filter);
+
+#endif //_ID_FILTER_H
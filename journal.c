@@ -0,0 +1,460 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "journal.h"
+
+#define JOURNAL_BUFFER_SIZE (1 << 16)
+#define JOURNAL_MAGIC "CHSJ"
+#define JOURNAL_MAGIC_SIZE 4
+#define JOURNAL_INT_SIZE 4
+#define JOURNAL_HEADER_SIZE (JOURNAL_MAGIC_SIZE + JOURNAL_INT_SIZE)
+#define JOURNAL_FNV_OFFSET 2166136261u
+#define JOURNAL_FNV_PRIME  16777619u
+#define JOURNAL_MS_PER_SECOND 1000
+#define JOURNAL_NS_PER_MS 1000000
+
+
+// The amount of ints in a record of every type
+static const int journal_record_sizes[] = { 2, 5, 1, 1, 1 };
+
+struct journal_t {
+    FILE *file;
+    char *buffer;               // The buffer of the file
+    uint32_t record_checksum;   // FNV-1a of the record being written
+    int sync_every_records;
+    int sync_every_ms;
+    int waiting_records;        // Appended since the last sync
+    struct timespec first_waiting_time;
+    bool failed;
+};
+
+//==============================================================//
+//================== INTERNAL FUNCTIONS START ==================//
+//==============================================================//
+
+// Adds bytes to an FNV-1a checksum
+static uint32_t journalChecksum(uint32_t checksum, const unsigned char *bytes, int size)
+{
+    for (int i = 0 ; i < size ; i++)
+    {
+        checksum ^= bytes[i];
+        checksum *= JOURNAL_FNV_PRIME;
+    }
+    return checksum;
+}
+
+// Encodes an int as little endian bytes
+static void journalEncodeInt(int value, unsigned char bytes[JOURNAL_INT_SIZE])
+{
+    uint32_t bits = (uint32_t)value;
+    for (int i = 0 ; i < JOURNAL_INT_SIZE ; i++)
+    {
+        bytes[i] = (unsigned char)(bits >> (8 * i));
+    }
+}
+
+// Decodes an int from little endian bytes
+static int journalDecodeInt(const unsigned char bytes[JOURNAL_INT_SIZE])
+{
+    uint32_t bits = 0;
+    for (int i = 0 ; i < JOURNAL_INT_SIZE ; i++)
+    {
+        bits |= (uint32_t)bytes[i] << (8 * i);
+    }
+    return bits <= INT_MAX ? (int)bits : -(int)(UINT32_MAX - bits) - 1;
+}
+
+// Writes bytes of the record being written, adding them to its checksum
+static void journalWriteBytes(Journal journal, const void *bytes, int size)
+{
+    journal->record_checksum = journalChecksum(journal->record_checksum, bytes, size);
+    if (!journal->failed && size > 0 && fwrite(bytes, 1, size, journal->file) != (size_t)size)
+    {
+        journal->failed = true;
+    }
+}
+
+// Writes an int of the record being written
+static void journalWriteInt(Journal journal, int value)
+{
+    unsigned char bytes[JOURNAL_INT_SIZE];
+    journalEncodeInt(value, bytes);
+    journalWriteBytes(journal, bytes, JOURNAL_INT_SIZE);
+}
+
+// Reads bytes of a record, adding them to its checksum. Returns false if the file ended
+static bool journalReadBytes(FILE *file, void *bytes, int size, uint32_t *checksum)
+{
+    if (size > 0 && fread(bytes, 1, size, file) != (size_t)size)
+    {
+        return false;
+    }
+    *checksum = journalChecksum(*checksum, bytes, size);
+    return true;
+}
+
+// Reads an int of a record
+static bool journalReadInt(FILE *file, int *value, uint32_t *checksum)
+{
+    unsigned char bytes[JOURNAL_INT_SIZE];
+    if (!journalReadBytes(file, bytes, JOURNAL_INT_SIZE, checksum))
+    {
+        return false;
+    }
+    *value = journalDecodeInt(bytes);
+    return true;
+}
+
+// Writes the header of a journal file
+static bool journalWriteHeader(FILE *file)
+{
+    unsigned char header[JOURNAL_HEADER_SIZE];
+    memcpy(header, JOURNAL_MAGIC, JOURNAL_MAGIC_SIZE);
+    journalEncodeInt(JOURNAL_VERSION, header + JOURNAL_MAGIC_SIZE);
+    return fwrite(header, 1, JOURNAL_HEADER_SIZE, file) == JOURNAL_HEADER_SIZE;
+}
+
+// Reads and verifies the header of a journal file. An empty file is an empty journal,
+// and gets a header when it's open for writing
+static JournalResult journalReadHeader(FILE *file, bool is_writable)
+{
+    unsigned char header[JOURNAL_HEADER_SIZE];
+    size_t amount_read = fread(header, 1, JOURNAL_HEADER_SIZE, file);
+    if (ferror(file))
+    {
+        return JOURNAL_IO_ERROR;
+    }
+
+    if (amount_read == 0)
+    {
+        if (!is_writable)
+        {
+            return JOURNAL_SUCCESS;
+        }
+        rewind(file);
+        return journalWriteHeader(file) && fflush(file) == 0 ? JOURNAL_SUCCESS : JOURNAL_IO_ERROR;
+    }
+    if (amount_read != JOURNAL_HEADER_SIZE || memcmp(header, JOURNAL_MAGIC, JOURNAL_MAGIC_SIZE) != 0 ||
+        journalDecodeInt(header + JOURNAL_MAGIC_SIZE) != JOURNAL_VERSION)
+    {
+        return JOURNAL_INVALID_FILE;
+    }
+    return JOURNAL_SUCCESS;
+}
+
+// Returns the size of a file, keeping its position. -1 if it couldn't be found
+static long journalGetFileSize(FILE *file)
+{
+    long position = ftell(file);
+    if (position < 0 || fseek(file, 0, SEEK_END) != 0)
+    {
+        return -1;
+    }
+    long file_size = ftell(file);
+    return fseek(file, position, SEEK_SET) == 0 ? file_size : -1;
+}
+
+// Reads the next record of a journal file of a given size. Returns false if the journal
+// ended, i.e. the record is cut or corrupted. The location of the record is set to a new
+// string
+static bool journalReadRecord(FILE *file, long file_size, JournalRecord *record,
+                              char **location, JournalResult *result)
+{
+    uint32_t checksum = JOURNAL_FNV_OFFSET;
+    int type = 0;
+    *location = NULL;
+    if (!journalReadInt(file, &(record->sequence), &checksum) ||
+        !journalReadInt(file, &type, &checksum) ||
+        type < JOURNAL_ADD_TOURNAMENT || type > JOURNAL_END_TOURNAMENT)
+    {
+        return false;
+    }
+    record->type = type;
+
+    for (int i = 0 ; i < journal_record_sizes[type] ; i++)
+    {
+        if (!journalReadInt(file, &(record->values[i]), &checksum))
+        {
+            return false;
+        }
+    }
+
+    if (type == JOURNAL_ADD_TOURNAMENT)
+    {
+        // A location longer than the rest of the file (and the checksum after it) is
+        // cut, or its length is corrupted - either way nothing is allocated for it
+        int length = 0;
+        if (!journalReadInt(file, &length, &checksum) || length < 0 ||
+            length > file_size - ftell(file) - JOURNAL_INT_SIZE)
+        {
+            return false;
+        }
+        *location = malloc((size_t)length + 1);
+        if (*location == NULL)
+        {
+            *result = JOURNAL_OUT_OF_MEMORY;
+            return false;
+        }
+        if (!journalReadBytes(file, *location, length, &checksum))
+        {
+            free(*location);
+            *location = NULL;
+            return false;
+        }
+        (*location)[length] = '\0';
+    }
+    record->location = *location;
+
+    // The checksum isn't part of itself
+    uint32_t expected_checksum = checksum;
+    int file_checksum = 0;
+    if (!journalReadInt(file, &file_checksum, &checksum) ||
+        (uint32_t)file_checksum != expected_checksum)
+    {
+        free(*location);
+        *location = NULL;
+        return false;
+    }
+    return true;
+}
+
+// Reads the records of a journal file after its header, calling a function for every
+// one of them (if given). Sets the offset after the last record, and its sequence
+static JournalResult journalScan(FILE *file, replayJournalRecord replayRecord, void *context,
+                                 long *records_end, int *last_sequence)
+{
+    *last_sequence = JOURNAL_NO_RECORDS;
+    *records_end   = ftell(file);
+    long file_size = journalGetFileSize(file);
+    if (*records_end < 0 || file_size < 0)
+    {
+        return JOURNAL_IO_ERROR;
+    }
+
+    JournalResult result = JOURNAL_SUCCESS;
+    JournalRecord record;
+    char *location = NULL;
+    while (journalReadRecord(file, file_size, &record, &location, &result))
+    {
+        // Sequences grow by one - a record that doesn't follow is not part of the journal
+        if (record.sequence <= 0 ||
+            (*last_sequence != JOURNAL_NO_RECORDS && record.sequence != *last_sequence + 1))
+        {
+            free(location);
+            break;
+        }
+
+        bool is_replayed = replayRecord == NULL || replayRecord(&record, context);
+        free(location);
+        if (!is_replayed)
+        {
+            return JOURNAL_INVALID_FILE;
+        }
+        *last_sequence = record.sequence;
+        *records_end   = ftell(file);
+    }
+
+    if (result == JOURNAL_SUCCESS && ferror(file))
+    {
+        result = JOURNAL_IO_ERROR;
+    }
+    return result;
+}
+
+// Returns the milliseconds passed since a given time
+static long journalGetElapsedMs(const struct timespec *since)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long)(now.tv_sec - since->tv_sec) * JOURNAL_MS_PER_SECOND +
+           (now.tv_nsec - since->tv_nsec) / JOURNAL_NS_PER_MS;
+}
+
+//============================================================//
+//================== INTERNAL FUNCTIONS END ==================//
+//============================================================//
+
+
+Journal journalOpen(const char *path, int sync_every_records, int sync_every_ms,
+                    int *last_sequence)
+{
+    if (path == NULL || last_sequence == NULL)
+    {
+        return NULL;
+    }
+
+    Journal journal = malloc(sizeof(*journal));
+    if (journal == NULL)
+    {
+        return NULL;
+    }
+
+    journal->buffer = malloc(JOURNAL_BUFFER_SIZE);
+    if (journal->buffer == NULL)
+    {
+        free(journal);
+        return NULL;
+    }
+
+    // "r+b" keeps the records of an existing journal, "w+b" creates a new one
+    journal->file = fopen(path, "r+b");
+    if (journal->file == NULL && errno == ENOENT)
+    {
+        journal->file = fopen(path, "w+b");
+    }
+    if (journal->file == NULL)
+    {
+        free(journal->buffer);
+        free(journal);
+        return NULL;
+    }
+    setvbuf(journal->file, journal->buffer, _IOFBF, JOURNAL_BUFFER_SIZE);
+
+    // New records are appended after the last whole record, overwriting a cut one
+    long records_end = 0;
+    if (journalReadHeader(journal->file, true) != JOURNAL_SUCCESS ||
+        journalScan(journal->file, NULL, NULL, &records_end, last_sequence) != JOURNAL_SUCCESS ||
+        fseek(journal->file, records_end, SEEK_SET) != 0 ||
+        fflush(journal->file) != 0 ||
+        ftruncate(fileno(journal->file), records_end) != 0)
+    {
+        fclose(journal->file);
+        free(journal->buffer);
+        free(journal);
+        return NULL;
+    }
+
+    journal->record_checksum    = JOURNAL_FNV_OFFSET;
+    journal->sync_every_records = sync_every_records;
+    journal->sync_every_ms      = sync_every_ms;
+    journal->waiting_records    = 0;
+    journal->failed             = false;
+    return journal;
+}
+
+
+void journalAppend(Journal journal, const JournalRecord *record)
+{
+    if (journal == NULL || record == NULL || record->type < JOURNAL_ADD_TOURNAMENT ||
+        record->type > JOURNAL_END_TOURNAMENT)
+    {
+        return;
+    }
+
+    journal->record_checksum = JOURNAL_FNV_OFFSET;
+    journalWriteInt(journal, record->sequence);
+    journalWriteInt(journal, record->type);
+    for (int i = 0 ; i < journal_record_sizes[record->type] ; i++)
+    {
+        journalWriteInt(journal, record->values[i]);
+    }
+    if (record->type == JOURNAL_ADD_TOURNAMENT)
+    {
+        const char *location = record->location == NULL ? "" : record->location;
+        int length = (int)strlen(location);
+        journalWriteInt(journal, length);
+        journalWriteBytes(journal, location, length);
+    }
+    journalWriteInt(journal, (int)journal->record_checksum);
+
+    // Group commit - the records are synced together once their group is complete
+    if (journal->waiting_records == 0)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &(journal->first_waiting_time));
+    }
+    (journal->waiting_records)++;
+    if ((journal->sync_every_records > 0 &&
+         journal->waiting_records >= journal->sync_every_records) ||
+        (journal->sync_every_ms > 0 &&
+         journalGetElapsedMs(&(journal->first_waiting_time)) >= journal->sync_every_ms))
+    {
+        journalSync(journal);
+    }
+}
+
+
+JournalResult journalSync(Journal journal)
+{
+    if (journal == NULL)
+    {
+        return JOURNAL_NULL_ARGUMENT;
+    }
+
+    if (journal->waiting_records > 0 &&
+        (fflush(journal->file) != 0 || fsync(fileno(journal->file)) != 0))
+    {
+        journal->failed = true;
+    }
+    journal->waiting_records = 0;
+    return journal->failed ? JOURNAL_IO_ERROR : JOURNAL_SUCCESS;
+}
+
+
+JournalResult journalRestart(Journal journal)
+{
+    if (journal == NULL)
+    {
+        return JOURNAL_NULL_ARGUMENT;
+    }
+
+    if (fflush(journal->file) != 0 ||
+        ftruncate(fileno(journal->file), JOURNAL_HEADER_SIZE) != 0 ||
+        fseek(journal->file, JOURNAL_HEADER_SIZE, SEEK_SET) != 0 ||
+        fsync(fileno(journal->file)) != 0)
+    {
+        journal->failed = true;
+    }
+    journal->waiting_records = 0;
+    return journal->failed ? JOURNAL_IO_ERROR : JOURNAL_SUCCESS;
+}
+
+
+JournalResult journalClose(Journal journal)
+{
+    if (journal == NULL)
+    {
+        return JOURNAL_NULL_ARGUMENT;
+    }
+
+    JournalResult result = journalSync(journal);
+    if (fclose(journal->file) != 0)
+    {
+        result = JOURNAL_IO_ERROR;
+    }
+    free(journal->buffer);
+    free(journal);
+    return result;
+}
+
+
+JournalResult journalReplay(const char *path, replayJournalRecord replayRecord, void *context)
+{
+    if (path == NULL || replayRecord == NULL)
+    {
+        return JOURNAL_NULL_ARGUMENT;
+    }
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        return errno == ENOENT ? JOURNAL_SUCCESS : JOURNAL_IO_ERROR;
+    }
+
+    long records_end = 0;
+    int last_sequence = JOURNAL_NO_RECORDS;
+    JournalResult result = journalReadHeader(file, false);
+    if (result == JOURNAL_SUCCESS)
+    {
+        result = journalScan(file, replayRecord, context, &records_end, &last_sequence);
+    }
+    fclose(file);
+    return result;
+}
@@ -0,0 +1,153 @@
+#ifndef _JOURNAL_H
+#define _JOURNAL_H
+
+#include <stdio.h>
+#include <stdbool.h>
+
+#define JOURNAL_VERSION 1
+#define JOURNAL_MAX_VALUES 5
+#define JOURNAL_NO_RECORDS 0    // The sequence given when a journal has no records
+
+typedef enum {
+    JOURNAL_OUT_OF_MEMORY,
+    JOURNAL_NULL_ARGUMENT,
+    JOURNAL_IO_ERROR,
+    JOURNAL_INVALID_FILE,
+    JOURNAL_SUCCESS
+} JournalResult ;
+
+typedef enum {
+    JOURNAL_ADD_TOURNAMENT,     // tournament id, max games per player, location
+    JOURNAL_ADD_GAME,           // tournament id, first player, second player, winner, play time
+    JOURNAL_REMOVE_TOURNAMENT,  // tournament id
+    JOURNAL_REMOVE_PLAYER,      // player id
+    JOURNAL_END_TOURNAMENT      // tournament id
+} JournalRecordType ;
+
+
+/**
+ * A record of a call that changes the chess system. Records are numbered by their
+ * sequence, which grows by one from a record to the next.
+ */
+typedef struct journal_record_t {
+    int sequence;
+    JournalRecordType type;
+    int values[JOURNAL_MAX_VALUES];     // The ints of the call, by its type
+    const char *location;               // Only for JOURNAL_ADD_TOURNAMENT, NULL otherwise
+} JournalRecord;
+
+
+/**
+ * Type for an append-only journal file of records.
+ *
+ * The file starts with a magic number and JOURNAL_VERSION. Every record ends with a
+ * checksum of its own, so a record that was cut while written (e.g. when the process
+ * died) ends the journal - it and anything after it are ignored, and are overwritten
+ * once the journal is opened again.
+ *
+ * Records are written through a buffer, and are made durable (flushed and synced to
+ * the disk) in groups: once a given amount of records wait, or once the first of them
+ * waited a given time. The time is checked when records are appended.
+ * Write errors are kept by the journal, and returned when it's synced or closed.
+ */
+typedef struct journal_t *Journal;
+
+
+/**
+ * Type of function called by journalReplay for every record of the journal.
+ * Gets the record and the context given to journalReplay.
+ * Should return true to continue, false to stop the replay (the journal is then invalid).
+ */
+typedef bool(*replayJournalRecord)(const JournalRecord*, void*);
+
+
+/**
+ * journalOpen: opens a journal file for appending records, creating it if it doesn't
+ *              exist. A cut record at the end of the file is removed.
+ *
+ * @param path - the path of the file
+ * @param sync_every_records - records are synced once this many of them wait.
+ *     0 or less to not limit the amount of waiting records.
+ * @param sync_every_ms - records are synced once the first of them waited this many
+ *     milliseconds. 0 or less to not limit the time records wait.
+ * @param last_sequence - set to the sequence of the last record in the file,
+ *     JOURNAL_NO_RECORDS if there are none.
+ *
+ * @return A new Journal in case of success, and NULL otherwise (e.g. if the file
+ *     couldn't be opened, isn't a journal of JOURNAL_VERSION, or in case of an
+ *     allocation error)
+ */
+Journal journalOpen(const char *path, int sync_every_records, int sync_every_ms,
+                    int *last_sequence);
+
+
+/**
+ * journalAppend: appends a record to the journal, syncing the waiting records if
+ *                their group is complete.
+ *
+ * @param journal - the journal
+ * @param record  - the record to append
+ */
+void journalAppend(Journal journal, const JournalRecord *record);
+
+
+/**
+ * journalSync: makes every record appended so far durable.
+ *
+ * @param journal - the journal
+ *
+ * @return
+ *     JOURNAL_NULL_ARGUMENT - if journal is NULL
+ *     JOURNAL_IO_ERROR      - if writing or syncing any record failed
+ *     JOURNAL_SUCCESS       - otherwise
+ */
+JournalResult journalSync(Journal journal);
+
+
+/**
+ * journalRestart: removes all the records of the journal, e.g. once they're part of
+ *                 a snapshot.
+ *
+ * @param journal - the journal
+ *
+ * @return
+ *     JOURNAL_NULL_ARGUMENT - if journal is NULL
+ *     JOURNAL_IO_ERROR      - if the file couldn't be emptied, or a write failed before
+ *     JOURNAL_SUCCESS       - otherwise
+ */
+JournalResult journalRestart(Journal journal);
+
+
+/**
+ * journalClose: syncs the waiting records, closes the file and frees the journal.
+ *
+ * @param journal - the journal. A NULL value is allowed, and in that case the function
+ *     does nothing.
+ *
+ * @return
+ *     JOURNAL_NULL_ARGUMENT - if journal is NULL
+ *     JOURNAL_IO_ERROR      - if writing or syncing any record failed
+ *     JOURNAL_SUCCESS       - otherwise
+ */
+JournalResult journalClose(Journal journal);
+
+
+/**
+ * journalReplay: calls a function for every record of a journal file, in order.
+ *                Reading stops at the first cut or corrupted record.
+ *
+ * @param path - the path of the file. A file that doesn't exist is an empty journal.
+ * @param replayRecord - the function to call for every record
+ * @param context - passed to replayRecord
+ *
+ * @return
+ *     JOURNAL_NULL_ARGUMENT - if path or replayRecord are NULL
+ *     JOURNAL_IO_ERROR      - if the file couldn't be read
+ *     JOURNAL_INVALID_FILE  - if the file isn't a journal of JOURNAL_VERSION, or
+ *                             replayRecord stopped the replay
+ *     JOURNAL_OUT_OF_MEMORY - if an allocation failed
+ *     JOURNAL_SUCCESS       - otherwise
+ */
+JournalResult journalReplay(const char *path, replayJournalRecord replayRecord, void *context);
+
+#endif //_JOURNAL_H
@@ -0,0 +1,355 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "./mtm_map/typedMap.h"
+#include "leaderboard.h"
+
+
+// helper struct - a player in the leaderboard, and a node of its tree (a treap - a search
+// tree by rank, and a heap by the nodes' priorities, which keeps it balanced)
+typedef struct leaderboard_node_t {
+    int player_id;
+    int level_score;
+    int amount_of_games;        // 0 if the player is not ranked, and so not in the tree
+    unsigned int priority;
+    int size;                   // The amount of nodes in the subtree
+    struct leaderboard_node_t *left;    // Players ranked above
+    struct leaderboard_node_t *right;   // Players ranked below
+} LeaderboardNode;
+
+
+// Copies a node, for the nodes map
+static LeaderboardNode *leaderboardNodeCopy(LeaderboardNode *node)
+{
+    LeaderboardNode *new_node = malloc(sizeof(*new_node));
+    if (new_node == NULL)
+    {
+        return NULL;
+    }
+    *new_node = *node;
+    return new_node;
+}
+
+// Frees a node, for the nodes map
+static void leaderboardNodeFree(LeaderboardNode *node)
+{
+    free(node);
+}
+
+DEFINE_TYPED_HASH_MAP(LeaderboardNodeMap, LeaderboardNode*, leaderboardNodeCopy, leaderboardNodeFree)
+
+
+struct leaderboard_t {
+    LeaderboardNode *root;      // The tree of the ranked players
+    LeaderboardNodeMap nodes;   // Player id -> the player's node. Owns the nodes
+};
+
+
+//==============================================================//
+//================== INTERNAL FUNCTIONS START ==================//
+//==============================================================//
+
+// 32 bit finalizer of MurmurHash3 - gives nearby ids unrelated priorities
+static unsigned int leaderboardGetPriority(int player_id)
+{
+    unsigned int key = (unsigned int)player_id;
+    key ^= key >> 16;
+    key *= 0x85ebca6bu;
+    key ^= key >> 13;
+    key *= 0xc2b2ae35u;
+    key ^= key >> 16;
+    return key;
+}
+
+// Checks whether the first node ranks above the second one. Levels are compared exactly
+// as fractions, cross multiplied (the amounts of games are positive)
+static bool leaderboardNodeIsAbove(LeaderboardNode *first, LeaderboardNode *second)
+{
+    long long first_product  = (long long)first->level_score * second->amount_of_games;
+    long long second_product = (long long)second->level_score * first->amount_of_games;
+    if (first_product != second_product)
+    {
+        return first_product > second_product;
+    }
+    return first->player_id < second->player_id;
+}
+
+// Returns the size of a subtree
+static int leaderboardGetSubtreeSize(LeaderboardNode *node)
+{
+    return node == NULL ? 0 : node->size;
+}
+
+// Sets the size of a node's subtree from its children
+static void leaderboardResize(LeaderboardNode *node)
+{
+    node->size = 1 + leaderboardGetSubtreeSize(node->left) + leaderboardGetSubtreeSize(node->right);
+}
+
+// Splits a tree to the nodes ranked above a given node, and the nodes ranked below it
+static void leaderboardSplit(LeaderboardNode *tree, LeaderboardNode *node,
+                             LeaderboardNode **above, LeaderboardNode **below)
+{
+    if (tree == NULL)
+    {
+        *above = NULL;
+        *below = NULL;
+        return;
+    }
+
+    if (leaderboardNodeIsAbove(tree, node))
+    {
+        leaderboardSplit(tree->right, node, &(tree->right), below);
+        *above = tree;
+    }
+    else
+    {
+        leaderboardSplit(tree->left, node, above, &(tree->left));
+        *below = tree;
+    }
+    leaderboardResize(tree);
+}
+
+// Merges two trees, where all the nodes of the first rank above the nodes of the second
+static LeaderboardNode *leaderboardMerge(LeaderboardNode *above, LeaderboardNode *below)
+{
+    if (above == NULL || below == NULL)
+    {
+        return above == NULL ? below : above;
+    }
+
+    if (above->priority > below->priority)
+    {
+        above->right = leaderboardMerge(above->right, below);
+        leaderboardResize(above);
+        return above;
+    }
+    below->left = leaderboardMerge(above, below->left);
+    leaderboardResize(below);
+    return below;
+}
+
+// Links a node into a tree, returns the new root of the tree
+static LeaderboardNode *leaderboardLink(LeaderboardNode *tree, LeaderboardNode *node)
+{
+    if (tree == NULL || node->priority > tree->priority)
+    {
+        leaderboardSplit(tree, node, &(node->left), &(node->right));
+        leaderboardResize(node);
+        return node;
+    }
+
+    if (leaderboardNodeIsAbove(node, tree))
+    {
+        tree->left = leaderboardLink(tree->left, node);
+    }
+    else
+    {
+        tree->right = leaderboardLink(tree->right, node);
+    }
+    leaderboardResize(tree);
+    return tree;
+}
+
+// Unlinks a node of a tree, returns the new root of the tree
+static LeaderboardNode *leaderboardUnlink(LeaderboardNode *tree, LeaderboardNode *node)
+{
+    if (tree == node)
+    {
+        LeaderboardNode *merged = leaderboardMerge(node->left, node->right);
+        node->left  = NULL;
+        node->right = NULL;
+        return merged;
+    }
+
+    if (leaderboardNodeIsAbove(node, tree))
+    {
+        tree->left = leaderboardUnlink(tree->left, node);
+    }
+    else
+    {
+        tree->right = leaderboardUnlink(tree->right, node);
+    }
+    leaderboardResize(tree);
+    return tree;
+}
+
+// Visits the nodes of a tree in rank order. Returns false if the walk was stopped
+static bool leaderboardWalk(LeaderboardNode *tree, visitLeaderboardPlayer visitPlayer,
+                            void *context)
+{
+    if (tree == NULL)
+    {
+        return true;
+    }
+    return leaderboardWalk(tree->left, visitPlayer, context) &&
+           visitPlayer(tree->player_id, tree->level_score, tree->amount_of_games, context) &&
+           leaderboardWalk(tree->right, visitPlayer, context);
+}
+
+//============================================================//
+//================== INTERNAL FUNCTIONS END ==================//
+//============================================================//
+
+
+Leaderboard leaderboardCreate()
+{
+    Leaderboard leaderboard = malloc(sizeof(*leaderboard));
+    if (leaderboard == NULL)
+    {
+        return NULL;
+    }
+
+    leaderboard->nodes = LeaderboardNodeMapCreate();
+    if (leaderboard->nodes == NULL)
+    {
+        free(leaderboard);
+        return NULL;
+    }
+
+    leaderboard->root = NULL;
+    return leaderboard;
+}
+
+
+void leaderboardDestroy(Leaderboard leaderboard)
+{
+    if (leaderboard == NULL)
+    {
+        return;
+    }
+    LeaderboardNodeMapDestroy(leaderboard->nodes);
+    free(leaderboard);
+}
+
+
+LeaderboardResult leaderboardAdd(Leaderboard leaderboard, int player_id)
+{
+    if (leaderboard == NULL)
+    {
+        return LEADERBOARD_NULL_ARGUMENT;
+    }
+
+    if (LeaderboardNodeMapContains(leaderboard->nodes, player_id))
+    {
+        return LEADERBOARD_PLAYER_ALREADY_EXISTS;
+    }
+
+    LeaderboardNode node = { player_id, 0, 0, leaderboardGetPriority(player_id), 1, NULL, NULL };
+    if (LeaderboardNodeMapPut(leaderboard->nodes, player_id, &node) != MAP_SUCCESS)
+    {
+        return LEADERBOARD_OUT_OF_MEMORY;
+    }
+    return LEADERBOARD_SUCCESS;
+}
+
+
+LeaderboardResult leaderboardUpdate(Leaderboard leaderboard, int player_id, int level_score,
+                                    int amount_of_games)
+{
+    if (leaderboard == NULL)
+    {
+        return LEADERBOARD_NULL_ARGUMENT;
+    }
+
+    LeaderboardNode *node = LeaderboardNodeMapGet(leaderboard->nodes, player_id);
+    if (node == NULL)
+    {
+        return LEADERBOARD_PLAYER_NOT_EXIST;
+    }
+
+    if (node->level_score == level_score && node->amount_of_games == amount_of_games)
+    {
+        return LEADERBOARD_SUCCESS;
+    }
+
+    // The node is moved to its new rank
+    if (node->amount_of_games > 0)
+    {
+        leaderboard->root = leaderboardUnlink(leaderboard->root, node);
+    }
+    node->level_score     = level_score;
+    node->amount_of_games = amount_of_games;
+    if (node->amount_of_games > 0)
+    {
+        leaderboard->root = leaderboardLink(leaderboard->root, node);
+    }
+    return LEADERBOARD_SUCCESS;
+}
+
+
+LeaderboardResult leaderboardRemove(Leaderboard leaderboard, int player_id)
+{
+    if (leaderboard == NULL)
+    {
+        return LEADERBOARD_NULL_ARGUMENT;
+    }
+
+    LeaderboardNode *node = LeaderboardNodeMapGet(leaderboard->nodes, player_id);
+    if (node == NULL)
+    {
+        return LEADERBOARD_PLAYER_NOT_EXIST;
+    }
+
+    if (node->amount_of_games > 0)
+    {
+        leaderboard->root = leaderboardUnlink(leaderboard->root, node);
+    }
+    LeaderboardNodeMapRemove(leaderboard->nodes, player_id);
+    return LEADERBOARD_SUCCESS;
+}
+
+
+int leaderboardGetRank(Leaderboard leaderboard, int player_id)
+{
+    if (leaderboard == NULL)
+    {
+        return LEADERBOARD_INVALID_INPUT;
+    }
+
+    LeaderboardNode *node = LeaderboardNodeMapGet(leaderboard->nodes, player_id);
+    if (node == NULL || node->amount_of_games == 0)
+    {
+        return LEADERBOARD_NOT_RANKED;
+    }
+
+    // Every subtree passed on the left ranks above the node
+    int rank = 1;
+    LeaderboardNode *current = leaderboard->root;
+    while (current != node)
+    {
+        if (leaderboardNodeIsAbove(node, current))
+        {
+            current = current->left;
+        }
+        else
+        {
+            rank   += 1 + leaderboardGetSubtreeSize(current->left);
+            current = current->right;
+        }
+    }
+    return rank + leaderboardGetSubtreeSize(node->left);
+}
+
+
+int leaderboardGetSize(Leaderboard leaderboard)
+{
+    if (leaderboard == NULL)
+    {
+        return LEADERBOARD_INVALID_INPUT;
+    }
+    return leaderboardGetSubtreeSize(leaderboard->root);
+}
+
+
+LeaderboardResult leaderboardForEach(Leaderboard leaderboard, visitLeaderboardPlayer visitPlayer,
+                                     void *context)
+{
+    if (leaderboard == NULL || visitPlayer == NULL)
+    {
+        return LEADERBOARD_NULL_ARGUMENT;
+    }
+
+    leaderboardWalk(leaderboard->root, visitPlayer, context);
+    return LEADERBOARD_SUCCESS;
+}
@@ -0,0 +1,142 @@
+#ifndef _LEADERBOARD_H
+#define _LEADERBOARD_H
+
+#include <stdio.h>
+#include <stdbool.h>
+
+#define LEADERBOARD_INVALID_INPUT -10
+#define LEADERBOARD_NOT_RANKED    0
+
+typedef enum {
+    LEADERBOARD_OUT_OF_MEMORY,
+    LEADERBOARD_NULL_ARGUMENT,
+    LEADERBOARD_PLAYER_ALREADY_EXISTS,
+    LEADERBOARD_PLAYER_NOT_EXIST,
+    LEADERBOARD_SUCCESS
+} LeaderboardResult ;
+
+
+/**
+ * Type for the ranking of all the players of a system by their level.
+ * A player's level is the fraction level_score / amount_of_games, and players are ranked
+ * by their level (higher first, compared exactly), and then by their id (smaller first).
+ * Players who played no games are not ranked.
+ *
+ * The ranking is kept in a balanced search tree that knows the size of its subtrees,
+ * so a player's level is updated and their rank is found in O(log n), and the k
+ * leading players are walked in O(log n + k).
+ */
+typedef struct leaderboard_t *Leaderboard;
+
+
+/**
+ * Type of function called by leaderboardForEach for every ranked player, in rank order.
+ * Gets the player's id, level score, amount of games, and the context given to
+ * leaderboardForEach. Should return true to continue the walk, false to stop it.
+ */
+typedef bool(*visitLeaderboardPlayer)(int, int, int, void*);
+
+
+/**
+ * leaderboardCreate: create an empty leaderboard.
+ *
+ * @return A new Leaderboard in case of success, and NULL otherwise (e.g.
+ *     in case of an allocation error)
+ */
+Leaderboard leaderboardCreate();
+
+
+/**
+ * leaderboardDestroy: free a leaderboard, and all its contents, from memory.
+ *
+ * @param leaderboard - the leaderboard to free from memory. A NULL value is
+ *     allowed, and in that case the function does nothing.
+ */
+void leaderboardDestroy(Leaderboard leaderboard);
+
+
+/**
+ * leaderboardAdd: adds a player with no games (so not ranked yet) to the leaderboard.
+ *
+ * @param leaderboard - the leaderboard
+ * @param player_id   - the id of the player to add
+ * @return
+ *      LEADERBOARD_NULL_ARGUMENT         - if leaderboard is NULL
+ *      LEADERBOARD_PLAYER_ALREADY_EXISTS - if the player is already in the leaderboard
+ *      LEADERBOARD_OUT_OF_MEMORY         - if an allocation failed
+ *      LEADERBOARD_SUCCESS               - otherwise
+ */
+LeaderboardResult leaderboardAdd(Leaderboard leaderboard, int player_id);
+
+
+/**
+ * leaderboardUpdate: sets the level of a player in the leaderboard, moving them to their
+ *                    rank. Never allocates memory, so it can't fail for a player in the
+ *                    leaderboard.
+ *
+ * @param leaderboard     - the leaderboard
+ * @param player_id       - the id of the player
+ * @param level_score     - the numerator of the player's level
+ * @param amount_of_games - the player's amount of games. 0 if the player is not ranked.
+ * @return
+ *      LEADERBOARD_NULL_ARGUMENT    - if leaderboard is NULL
+ *      LEADERBOARD_PLAYER_NOT_EXIST - if the player is not in the leaderboard
+ *      LEADERBOARD_SUCCESS          - otherwise
+ */
+LeaderboardResult leaderboardUpdate(Leaderboard leaderboard, int player_id, int level_score,
+                                    int amount_of_games);
+
+
+/**
+ * leaderboardRemove: removes a player from the leaderboard.
+ *
+ * @param leaderboard - the leaderboard
+ * @param player_id   - the id of the player to remove
+ * @return
+ *      LEADERBOARD_NULL_ARGUMENT    - if leaderboard is NULL
+ *      LEADERBOARD_PLAYER_NOT_EXIST - if the player is not in the leaderboard
+ *      LEADERBOARD_SUCCESS          - otherwise
+ */
+LeaderboardResult leaderboardRemove(Leaderboard leaderboard, int player_id);
+
+
+/**
+ * leaderboardGetRank: returns the rank of a player (1 for the leading player), in O(log n).
+ *
+ * @param leaderboard - the leaderboard
+ * @param player_id   - the id of the player
+ * @return
+ *      LEADERBOARD_INVALID_INPUT - if leaderboard is NULL
+ *      LEADERBOARD_NOT_RANKED    - if the player is not ranked, or not in the leaderboard
+ *      The rank of the player otherwise
+ */
+int leaderboardGetRank(Leaderboard leaderboard, int player_id);
+
+
+/**
+ * leaderboardGetSize: returns the amount of ranked players in the leaderboard.
+ *
+ * @param leaderboard - the leaderboard
+ * @return
+ *      LEADERBOARD_INVALID_INPUT - if leaderboard is NULL
+ *      The amount of ranked players otherwise
+ */
+int leaderboardGetSize(Leaderboard leaderboard);
+
+
+/**
+ * leaderboardForEach: calls a function for every ranked player, in rank order, until the
+ *                     function stops the walk. Walking the first k players takes
+ *                     O(log n + k).
+ *
+ * @param leaderboard  - the leaderboard
+ * @param visitPlayer  - the function to call
+ * @param context      - passed to visitPlayer
+ * @return
+ *      LEADERBOARD_NULL_ARGUMENT - if leaderboard or visitPlayer are NULL
+ *      LEADERBOARD_SUCCESS       - otherwise
+ */
+LeaderboardResult leaderboardForEach(Leaderboard leaderboard, visitLeaderboardPlayer visitPlayer,
+                                     void *context);
+
+#endif //_LEADERBOARD_H
@@ -2,68 +2,58 @@
 #define _MAP_UTIL_H
 
 #include <stdio.h>
+#include "./mtm_map/typedMap.h"
+#include "game.h"
+#include "playerInTournament.h"
+#include "player.h"
+#include "tournament.h"
 
 
+// ============================================================//
+// ============ Typed int keyed maps of the system ============//
+// ============================================================//
+
+DEFINE_TYPED_HASH_MAP(GameMap, Game, gameCopy, gameDestroy)
+
+DEFINE_TYPED_HASH_MAP(PlayerInTournamentMap, PlayerInTournament,
+                      playerInTournamentCopy, playerInTournamentDestroy)
+
+DEFINE_TYPED_HASH_MAP(PlayerMap, Player, playerCopy, playerDestroy)
+
+DEFINE_TYPED_MAP(TournamentMap, Tournament, tournamentCopy, tournamentDestroy)
 
 
 /**
  * createGamesMap: creates a games map.
+ *                 Games are looked up by id, so the map is hashed.
  *
  * @return a map that uses int as keys and games as data
  */
-Map createGamesMap();
+GameMap createGamesMap();
 
 
 /**
  * createPlayerInTournamentsMap: creates a playerInTournament map.
+ *                               The map is hashed (looked up by tournament id).
  *
  * @return a map that uses int as keys and PlayerInTournament as data
  */
-Map createPlayerInTournamentsMap();
+PlayerInTournamentMap createPlayerInTournamentsMap();
 
 /**
  * createPlayersMap: creates a player map.
+ *                   The map is hashed (looked up by player id).
  *
  * @return a map that uses int as keys and player as data
  */
-Map createPlayersMap();
+PlayerMap createPlayersMap();
 
 /**
  * createTournamentsMap: creates a tournaments map.
  *
  * @return a map that uses int as keys and tournaments as data
  */
-Map createTournamentsMap();
-
-
-/**
- * intCopy: copy an integer.
- *
- * @param num - pointer to int
- * 
- * @return a pointer to the coppied int
- */
-void* intCopy (void *num);
-
-/**
- * intFree: free an integer.
- *
- * @param num - pointer to int
- */
-void intFree (void *num);
-
-
-/**
- * intCompare: compare 2 integers.
- *
- * @param num1 - pointer to first int
- * @param num2 - pointer to second int
- * 
- * @return a number greater than 0 if num1's value is bigger
- *         a number lesser  than 0 if num2's value is bigger
- *         0 if *num1 = *num2
- */
-int intCompare (void *num1, void *num2);
+TournamentMap createTournamentsMap();
 
 
 /**
@@ -88,20 +78,6 @@ void gamePtrFree (void* game);
 // === Wrapper functions - uses void* for generic ADT usage ===//
 // ============================================================//
 
-void* playerInTournamentCopyWrapper(void *player_in_tournament);
-
-void playerInTournamentDestroyWrapper(void *player_in_tournament);
-
-void* gameCopyWrapper(void *game);
-
-void gameDestroyWrapper(void *game);
-
-void* playerCopyWrapper(void *player);
-
-void playerDestroyWrapper(void *player);
-
-void* tournamentCopyWrapper(void *tournament);
-
-void tournamentDestroyWrapper(void *tournament);
+void* playerCreateWrapper(void *player_id);
 
 #endif //_MAP_UTIL_H
\ No newline at end of file
@@ -0,0 +1,384 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "concurrentMap.h"
+
+// helper struct - a part of the keys, in a map guarded by its own lock
+typedef struct concurrent_map_shard_t {
+
+    Map map;
+    pthread_rwlock_t lock;
+
+} ConcurrentMapShard;
+
+
+struct ConcurrentMap_t {
+
+    ConcurrentMapShard* shards;
+    int shard_count;            // A power of 2
+    hashMapKeyElements  hash_key_func;
+    copyMapDataElements copy_data_func;
+};
+
+
+// helper struct - passes a concurrentMapForEach call through mapForEachReadOnly of every shard
+typedef struct concurrent_map_visit_t {
+
+    visitMapElement visit_element;
+    void* context;
+    bool stopped;
+
+} ConcurrentMapVisit;
+
+
+
+//==============================================================//
+//================== INTERNAL FUNCTIONS START ==================//
+//==============================================================//
+
+// 32 bit finalizer of MurmurHash3 - spreads nearby int keys over the shards
+static unsigned int concurrentMapIntKeyHash(MapKeyElement key)
+{
+    unsigned int hash = (unsigned int)*(int*)key;
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+
+// Returns the shard a key belongs to
+static ConcurrentMapShard* concurrentMapGetShard(ConcurrentMap map, MapKeyElement key)
+{
+    unsigned int hash = map->hash_key_func(key);
+    return &(map->shards[hash & (unsigned int)(map->shard_count - 1)]);
+}
+
+
+// mapForEachReadOnly visitor - calls the concurrentMapForEach visitor, remembering if it stopped
+static bool concurrentMapVisitElement(MapKeyElement key, MapDataElement data, void *visit)
+{
+    ConcurrentMapVisit* map_visit = visit;
+    if (!map_visit->visit_element(key, data, map_visit->context))
+    {
+        map_visit->stopped = true;
+        return false;
+    }
+    return true;
+}
+
+
+// Locks a shard for a lookup or a walk. Maps compiled with MAP_STATS count their reads
+// in plain counters, so then the lookups of a shard take turns instead of running in parallel
+static void concurrentMapLockForRead(ConcurrentMapShard* shard)
+{
+#ifdef MAP_STATS
+    pthread_rwlock_wrlock(&(shard->lock));
+#else
+    pthread_rwlock_rdlock(&(shard->lock));
+#endif
+}
+
+
+// Destroys the first shard_count shards of a map (and their locks)
+static void concurrentMapDestroyShards(ConcurrentMapShard* shards, int shard_count)
+{
+    for (int i = 0 ; i < shard_count ; i++)
+    {
+        pthread_rwlock_destroy(&(shards[i].lock));
+        mapDestroy(shards[i].map);
+    }
+    free(shards);
+}
+
+
+// helper struct - the functions given to concurrentMapCreate, for creating its shards
+typedef struct concurrent_map_functions_t {
+
+    copyMapDataElements   copy_data_func;
+    copyMapKeyElements    copy_key_func;
+    freeMapDataElements   free_data_func;
+    freeMapKeyElements    free_key_func;
+    compareMapKeyElements compare_key_func;
+
+} ConcurrentMapFunctions;
+
+
+// Creates a shard of a concurrentMapCreate map
+static Map concurrentMapCreateShard(void *functions)
+{
+    ConcurrentMapFunctions* map_functions = functions;
+    return mapCreate(map_functions->copy_data_func, map_functions->copy_key_func,
+                     map_functions->free_data_func, map_functions->free_key_func,
+                     map_functions->compare_key_func);
+}
+
+
+// Creates a shard of a concurrentMapCreateIntKeyed map
+static Map concurrentMapCreateIntKeyedShard(void *functions)
+{
+    ConcurrentMapFunctions* map_functions = functions;
+    return mapCreateIntKeyed(map_functions->copy_data_func, map_functions->free_data_func);
+}
+
+// Allocates a concurrent map whose shards are made by the given create function.
+// The shards are tree maps - reading a tree map doesn't change it, so readers of a
+// shard can share its lock
+static ConcurrentMap concurrentMapCreateSharded(Map (*create_shard)(void*),
+                                                ConcurrentMapFunctions *functions,
+                                                hashMapKeyElements hashKeyElement, int shard_count)
+{
+    if (shard_count <= 0 || functions->copy_data_func == NULL)
+    {
+        return NULL;
+    }
+
+    ConcurrentMap map = malloc(sizeof(*map));
+    if (map == NULL)
+    {
+        return NULL;
+    }
+
+    map->shard_count = 1;
+    while (map->shard_count < shard_count)
+    {
+        map->shard_count *= 2;
+    }
+    map->hash_key_func  = hashKeyElement;
+    map->copy_data_func = functions->copy_data_func;
+
+    map->shards = malloc(map->shard_count * sizeof(*(map->shards)));
+    if (map->shards == NULL)
+    {
+        free(map);
+        return NULL;
+    }
+
+    for (int i = 0 ; i < map->shard_count ; i++)
+    {
+        map->shards[i].map = create_shard(functions);
+        if (map->shards[i].map == NULL)
+        {
+            concurrentMapDestroyShards(map->shards, i);
+            free(map);
+            return NULL;
+        }
+        if (pthread_rwlock_init(&(map->shards[i].lock), NULL) != 0)
+        {
+            mapDestroy(map->shards[i].map);
+            concurrentMapDestroyShards(map->shards, i);
+            free(map);
+            return NULL;
+        }
+    }
+
+    return map;
+}
+
+
+//============================================================//
+//================== INTERNAL FUNCTIONS END ==================//
+//============================================================//
+
+
+ConcurrentMap concurrentMapCreate(copyMapDataElements copyDataElement,
+                                  copyMapKeyElements copyKeyElement,
+                                  freeMapDataElements freeDataElement,
+                                  freeMapKeyElements freeKeyElement,
+                                  compareMapKeyElements compareKeyElements,
+                                  hashMapKeyElements hashKeyElement,
+                                  int shard_count)
+{
+    if (hashKeyElement == NULL)
+    {
+        return NULL;
+    }
+
+    ConcurrentMapFunctions functions = { copyDataElement, copyKeyElement, freeDataElement,
+                                         freeKeyElement, compareKeyElements };
+    return concurrentMapCreateSharded(concurrentMapCreateShard, &functions,
+                                      hashKeyElement, shard_count);
+}
+
+
+ConcurrentMap concurrentMapCreateIntKeyed(copyMapDataElements copyDataElement,
+                                          freeMapDataElements freeDataElement,
+                                          int shard_count)
+{
+    ConcurrentMapFunctions functions = { copyDataElement, NULL, freeDataElement, NULL, NULL };
+    return concurrentMapCreateSharded(concurrentMapCreateIntKeyedShard, &functions,
+                                      concurrentMapIntKeyHash, shard_count);
+}
+
+
+void concurrentMapDestroy(ConcurrentMap map)
+{
+    if (map == NULL)
+    {
+        return;
+    }
+    concurrentMapDestroyShards(map->shards, map->shard_count);
+    free(map);
+}
+
+
+int concurrentMapGetSize(ConcurrentMap map)
+{
+    if (map == NULL)
+    {
+        return -1;
+    }
+
+    int size = 0;
+    for (int i = 0 ; i < map->shard_count ; i++)
+    {
+        pthread_rwlock_rdlock(&(map->shards[i].lock));
+        size += mapGetSize(map->shards[i].map);
+        pthread_rwlock_unlock(&(map->shards[i].lock));
+    }
+    return size;
+}
+
+
+bool concurrentMapContains(ConcurrentMap map, MapKeyElement element)
+{
+    if (map == NULL || element == NULL)
+    {
+        return false;
+    }
+
+    ConcurrentMapShard* shard = concurrentMapGetShard(map, element);
+    concurrentMapLockForRead(shard);
+    bool contains = mapContains(shard->map, element);
+    pthread_rwlock_unlock(&(shard->lock));
+    return contains;
+}
+
+
+MapResult concurrentMapPut(ConcurrentMap map, MapKeyElement keyElement,
+                           MapDataElement dataElement)
+{
+    if (map == NULL || keyElement == NULL || dataElement == NULL)
+    {
+        return MAP_NULL_ARGUMENT;
+    }
+
+    ConcurrentMapShard* shard = concurrentMapGetShard(map, keyElement);
+    pthread_rwlock_wrlock(&(shard->lock));
+    MapResult result = mapPut(shard->map, keyElement, dataElement);
+    pthread_rwlock_unlock(&(shard->lock));
+    return result;
+}
+
+
+MapResult concurrentMapPutMove(ConcurrentMap map, MapKeyElement keyElement,
+                               MapDataElement dataElement)
+{
+    if (map == NULL || keyElement == NULL || dataElement == NULL)
+    {
+        return MAP_NULL_ARGUMENT;
+    }
+
+    ConcurrentMapShard* shard = concurrentMapGetShard(map, keyElement);
+    pthread_rwlock_wrlock(&(shard->lock));
+    MapResult result = mapPutMove(shard->map, keyElement, dataElement);
+    pthread_rwlock_unlock(&(shard->lock));
+    return result;
+}
+
+
+MapDataElement concurrentMapGetCopy(ConcurrentMap map, MapKeyElement keyElement)
+{
+    if (map == NULL || keyElement == NULL)
+    {
+        return NULL;
+    }
+
+    ConcurrentMapShard* shard = concurrentMapGetShard(map, keyElement);
+    MapDataElement copy = NULL;
+    concurrentMapLockForRead(shard);
+    MapDataElement data = (MapDataElement)mapGetReadOnly(shard->map, keyElement);
+    if (data != NULL)
+    {
+        copy = map->copy_data_func(data);
+    }
+    pthread_rwlock_unlock(&(shard->lock));
+    return copy;
+}
+
+
+MapResult concurrentMapUpdate(ConcurrentMap map, MapKeyElement keyElement,
+                              visitMapElement updateElement, void *context)
+{
+    if (map == NULL || keyElement == NULL || updateElement == NULL)
+    {
+        return MAP_NULL_ARGUMENT;
+    }
+
+    ConcurrentMapShard* shard = concurrentMapGetShard(map, keyElement);
+    MapResult result = MAP_ITEM_DOES_NOT_EXIST;
+    pthread_rwlock_wrlock(&(shard->lock));
+    MapDataElement data = mapGet(shard->map, keyElement);
+    if (data != NULL)
+    {
+        updateElement(keyElement, data, context);
+        result = MAP_SUCCESS;
+    }
+    pthread_rwlock_unlock(&(shard->lock));
+    return result;
+}
+
+
+MapResult concurrentMapRemove(ConcurrentMap map, MapKeyElement keyElement)
+{
+    if (map == NULL || keyElement == NULL)
+    {
+        return MAP_NULL_ARGUMENT;
+    }
+
+    ConcurrentMapShard* shard = concurrentMapGetShard(map, keyElement);
+    pthread_rwlock_wrlock(&(shard->lock));
+    MapResult result = mapRemove(shard->map, keyElement);
+    pthread_rwlock_unlock(&(shard->lock));
+    return result;
+}
+
+
+MapResult concurrentMapClear(ConcurrentMap map)
+{
+    if (map == NULL)
+    {
+        return MAP_NULL_ARGUMENT;
+    }
+
+    for (int i = 0 ; i < map->shard_count ; i++)
+    {
+        pthread_rwlock_wrlock(&(map->shards[i].lock));
+        mapClear(map->shards[i].map);
+        pthread_rwlock_unlock(&(map->shards[i].lock));
+    }
+    return MAP_SUCCESS;
+}
+
+
+MapResult concurrentMapForEach(ConcurrentMap map, visitMapElement visitElement, void *context)
+{
+    if (map == NULL || visitElement == NULL)
+    {
+        return MAP_NULL_ARGUMENT;
+    }
+
+    // The cursor of every shard lives on this thread's stack (inside mapForEachReadOnly)
+    ConcurrentMapVisit visit = { visitElement, context, false };
+    for (int i = 0 ; i < map->shard_count && !visit.stopped ; i++)
+    {
+        concurrentMapLockForRead(&(map->shards[i]));
+        mapForEachReadOnly(map->shards[i].map, concurrentMapVisitElement, &visit);
+        pthread_rwlock_unlock(&(map->shards[i].lock));
+    }
+    return MAP_SUCCESS;
+}
@@ -0,0 +1,205 @@
+#ifndef CONCURRENT_MAP_H_
+#define CONCURRENT_MAP_H_
+
+#include <stdbool.h>
+#include "map.h"
+
+/**
+* Concurrent Map Container
+*
+* A map which may be used by several threads at the same time. The keys are split
+* by their hash between a fixed amount of shards, each of them an ordinary (tree) Map
+* guarded by its own reader-writer lock. Threads working on keys of different shards
+* never wait for each other, and lookups of the same shard run in parallel.
+*
+* The map has no internal iterator - iteration is done by concurrentMapForEach, which
+* keeps its position on the calling thread's stack. The map never hands out its data
+* elements outside of a lock: concurrentMapGetCopy returns a copy, and changes to an
+* existing element are done by concurrentMapUpdate while the element's shard is locked.
+*
+* Maps compiled with MAP_STATS count the reads of a shard too, so its readers lock it
+* exclusively - their counters stay exact, but lookups of the same shard don't run in parallel.
+*
+* The following functions are available:
+*   concurrentMapCreate		- Creates a new empty concurrent map
+*   concurrentMapCreateIntKeyed	- Creates a new empty concurrent map with int keys
+*   concurrentMapDestroy	- Deletes a concurrent map and frees all resources
+*   concurrentMapGetSize	- Returns the amount of elements in the map
+*   concurrentMapContains	- Returns whether a key exists in the map
+*   concurrentMapPut		- Pairs a copy of a data element to a key
+*   concurrentMapPutMove	- Pairs a data element itself to a key (see mapPutMove)
+*   concurrentMapGetCopy	- Returns a copy of the data paired to a key
+*   concurrentMapUpdate		- Calls a function on the data paired to a key, with its shard locked
+*   concurrentMapRemove		- Removes a key and frees its data
+*   concurrentMapClear		- Removes all the elements of the map
+*   concurrentMapForEach	- Calls a function for every (key, data) pair, shard by shard
+*/
+
+/** Type for defining the concurrent map */
+typedef struct ConcurrentMap_t *ConcurrentMap;
+
+/**
+* concurrentMapCreate: Allocates a new empty concurrent map.
+*
+* @param copyDataElement - Function pointer to be used for copying data elements.
+* @param copyKeyElement - Function pointer to be used for copying key elements.
+* @param freeDataElement - Function pointer to be used for freeing data elements.
+* @param freeKeyElement - Function pointer to be used for freeing key elements.
+* @param compareKeyElements - Function pointer to be used for comparing key elements.
+* @param hashKeyElement - Function pointer to be used for choosing the shard of a key.
+* @param shard_count - The amount of shards. Rounded up to a power of 2.
+* @return
+* 	NULL - if one of the parameters is NULL, shard_count isn't positive or
+* 	allocations failed.
+* 	A new ConcurrentMap in case of success.
+*/
+ConcurrentMap concurrentMapCreate(copyMapDataElements copyDataElement,
+                                  copyMapKeyElements copyKeyElement,
+                                  freeMapDataElements freeDataElement,
+                                  freeMapKeyElements freeKeyElement,
+                                  compareMapKeyElements compareKeyElements,
+                                  hashMapKeyElements hashKeyElement,
+                                  int shard_count);
+
+/**
+* concurrentMapCreateIntKeyed: Allocates a new empty concurrent map whose keys are
+* ints (passed as int*), stored inline in the shards (see mapCreateIntKeyed).
+*
+* @param copyDataElement - Function pointer to be used for copying data elements.
+* @param freeDataElement - Function pointer to be used for freeing data elements.
+* @param shard_count - The amount of shards. Rounded up to a power of 2.
+* @return
+* 	NULL - if one of the parameters is NULL, shard_count isn't positive or
+* 	allocations failed.
+* 	A new ConcurrentMap in case of success.
+*/
+ConcurrentMap concurrentMapCreateIntKeyed(copyMapDataElements copyDataElement,
+                                          freeMapDataElements freeDataElement,
+                                          int shard_count);
+
+/**
+* concurrentMapDestroy: Deallocates a concurrent map and all its elements.
+* No other thread may use the map during or after this call.
+*
+* @param map - Target map to be deallocated. If map is NULL nothing will be done
+*/
+void concurrentMapDestroy(ConcurrentMap map);
+
+/**
+* concurrentMapGetSize: Returns the number of elements in a concurrent map.
+* While other threads change the map, the result may already be outdated.
+*
+* @param map - The map which size is requested
+* @return
+* 	-1 if a NULL pointer was sent.
+* 	Otherwise the number of elements in the map.
+*/
+int concurrentMapGetSize(ConcurrentMap map);
+
+/**
+* concurrentMapContains: Checks if a key element exists in the map.
+*
+* @param map - The map to search in
+* @param element - The element to look for
+* @return
+* 	false - if one or more of the inputs is null, or if the key element was not found.
+* 	true - if the key element was found in the map.
+*/
+bool concurrentMapContains(ConcurrentMap map, MapKeyElement element);
+
+/**
+* concurrentMapPut: Gives a specified key a specific value (a copy of dataElement).
+*
+* @param map - The map for which to reassign the data element
+* @param keyElement - The key element which need to be reassigned
+* @param dataElement - The new data element to associate with the given key.
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as map or keyElement or dataElement
+* 	MAP_OUT_OF_MEMORY if an allocation failed
+* 	MAP_SUCCESS the paired elements had been inserted successfully
+*/
+MapResult concurrentMapPut(ConcurrentMap map, MapKeyElement keyElement,
+                           MapDataElement dataElement);
+
+/**
+* concurrentMapPutMove: Like concurrentMapPut, but the map takes the data element
+* itself instead of a copy of it. On failure it still belongs to the caller.
+*
+* @param map - The map for which to reassign the data element
+* @param keyElement - The key element which need to be reassigned
+* @param dataElement - The data element to move into the map.
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as map or keyElement or dataElement
+* 	MAP_OUT_OF_MEMORY if an allocation failed
+* 	MAP_SUCCESS the paired elements had been inserted successfully
+*/
+MapResult concurrentMapPutMove(ConcurrentMap map, MapKeyElement keyElement,
+                               MapDataElement dataElement);
+
+/**
+* concurrentMapGetCopy: Returns a copy of the data associated with a key, made while
+* the key's shard is locked. The copy belongs to the caller.
+*
+* @param map - The map for which to get the data element from.
+* @param keyElement - The key element whose data is requested.
+* @return
+*  NULL if a NULL pointer was sent, the map does not contain the key, or the copy failed.
+* 	A copy of the data element associated with the key otherwise.
+*/
+MapDataElement concurrentMapGetCopy(ConcurrentMap map, MapKeyElement keyElement);
+
+/**
+* concurrentMapUpdate: Calls a function on the data associated with a key, while the
+* key's shard is locked for writing. The function may change the data element, but
+* must not use the map.
+*
+* @param map - The map holding the key.
+* @param keyElement - The key element whose data should be updated.
+* @param updateElement - The function to call. Its return value is ignored.
+* @param context - Passed as is to updateElement.
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as map, keyElement or updateElement
+* 	MAP_ITEM_DOES_NOT_EXIST if the key is not in the map
+* 	MAP_SUCCESS otherwise
+*/
+MapResult concurrentMapUpdate(ConcurrentMap map, MapKeyElement keyElement,
+                              visitMapElement updateElement, void *context);
+
+/**
+* concurrentMapRemove: Removes a pair of key and data elements from the map.
+*
+* @param map - The map to remove the elements from.
+* @param keyElement - The key element to find and remove from the map.
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent to the function
+* 	MAP_ITEM_DOES_NOT_EXIST if an equal key item does not already exists in the map
+* 	MAP_SUCCESS the paired elements had been removed successfully
+*/
+MapResult concurrentMapRemove(ConcurrentMap map, MapKeyElement keyElement);
+
+/**
+* concurrentMapClear: Removes all key and data elements from the map, shard by shard.
+*
+* @param map - Target map to remove all element from.
+* @return
+* 	MAP_NULL_ARGUMENT - if a NULL pointer was sent.
+* 	MAP_SUCCESS - Otherwise.
+*/
+MapResult concurrentMapClear(ConcurrentMap map);
+
+/**
+* concurrentMapForEach: Calls a function for every (key, data) pair of the map until
+* it returns false. Shards are visited one after the other, each one locked for reading
+* while it is visited, so the keys are in ascending order only within a shard.
+* The function must not change the elements, nor use the map.
+*
+* @param map - The map to iterate over.
+* @param visitElement - The function to call.
+* @param context - Passed as is to every call of visitElement.
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as map or visitElement
+* 	MAP_SUCCESS otherwise
+*/
+MapResult concurrentMapForEach(ConcurrentMap map, visitMapElement visitElement, void *context);
+
+#endif /* CONCURRENT_MAP_H_ */
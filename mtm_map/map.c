@@ -1,444 +1,2685 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "map.h"
 #include <assert.h>
 
-// helper struct - List of keys & values
+#define MAP_HASH_INITIAL_CAPACITY 8
+#define MAP_POOL_FIRST_SLAB_SIZE  8
+#define MAP_POOL_MAX_SLAB_SIZE    1024
+#define MAP_GET_MANY_BATCH        16
+#define MAP_PREFETCH_DISTANCE     4
+
+// Prefetching is a GCC / Clang builtin, other compilers just skip it
+#if defined(__GNUC__)
+#define MAP_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define MAP_PREFETCH(address) ((void)(address))
+#endif
+
+// Counting the map's work is compiled in only when MAP_STATS is defined
+#ifdef MAP_STATS
+#define MAP_STATS_ADD(map, counter, amount) ((map)->stats.counter += (amount))
+#define MAP_STATS_UPDATE_PEAK(map) \
+    ((map)->stats.peak_size = (map)->size > (map)->stats.peak_size ? (map)->size \
+                                                                   : (map)->stats.peak_size)
+#else
+#define MAP_STATS_ADD(map, counter, amount) ((void)0)
+#define MAP_STATS_UPDATE_PEAK(map) ((void)0)
+#endif
+
+// helper struct - AVL tree node holding a key & value
+// Hashed maps keep the same nodes in a slot array and don't use the tree links
 typedef struct map_node_t {
 
     MapKeyElement key;
     MapDataElement data;
-    struct map_node_t* next;
+    struct map_node_t* left;
+    struct map_node_t* right;
+    struct map_node_t* owner;   // The holder of the key & data the node borrows, NULL if they're its own
+    int share_count;            // Tree nodes - the links to the node (from maps and from parent
+                                // nodes). Holders - the nodes borrowing their key & data
+    int height;
+    unsigned int hash;
+    int int_key;                // The key itself in int keyed maps, key then points here
 
 } *Map_Node;
 
 
+// helper struct - a block of nodes. The nodes of a map are carved out of its slabs,
+// so inserting doesn't call malloc and the whole map is freed slab by slab
+typedef struct map_slab_t {
+
+    struct map_slab_t* next;
+    int capacity;
+    int used;
+    struct map_node_t nodes[];
+
+} *Map_Slab;
+
+
+// helper struct - the slabs (newest first) and the released nodes to reuse. Maps sharing
+// nodes share their pool too, it is freed by the last of them
+typedef struct map_pool_t {
+
+    Map_Slab slabs;
+    Map_Node free_nodes;
+    int free_count;
+    int map_count;              // The maps using the pool, more than 1 if they share nodes
+
+} *Map_Pool;
+
+
+// helper struct - the slot array of a hashed map. A copied map shares it with the
+// original, until one of them changes
+typedef struct map_slots_t {
+
+    int map_count;              // The maps using the array, more than 1 if they share it
+    struct map_node_t* nodes[];
+
+} *Map_Slots;
 
 
 struct Map_t {
-    
+
+    // Tree backend
+    Map_Node root;
     Map_Node first_node;
-    Map_Node iterator;
+    Map_Node last_node;
+
+    // Hash backend - open addressing with linear probing, capacity is a power of 2.
+    // sorted_nodes is an ordered snapshot of the nodes, built when an iteration starts
+    Map_Slots slots;
+    int capacity;
+    Map_Node* sorted_nodes;
+
+    // Copy on write - a copied map shares its pool with the original. Tree maps share
+    // their nodes and copy only the path to a node they change, hashed maps share their
+    // slots and copy just the slot array before the first change (then the node changed)
+    Map_Pool pool;
+    bool owns_all_nodes;        // No node is shared, as known since the last copy
+
+    // Int keyed maps keep their keys inside the nodes and compare them directly
+    bool int_keys;
+
+    MapCursor iterator;
     int size;
+#ifdef MAP_STATS
+    MapStats stats;
+#endif
     copyMapDataElements   copy_data_func;
     copyMapKeyElements    copy_key_func;
     freeMapDataElements   free_data_func;
     freeMapKeyElements    free_key_func;
     compareMapKeyElements compare_key_func;
+    hashMapKeyElements    hash_key_func;
 };
 
 
 
-// Creates a map node
-static Map_Node mapNodeCreate(MapKeyElement in_key, MapDataElement in_data,
-                              copyMapDataElements copy_data_function, copyMapKeyElements copy_key_function)
+//==============================================================//
+//========================= NODE POOL ==========================//
+//==============================================================//
+
+static Map_Pool mapPoolCreate(void)
 {
-    Map_Node out_node = malloc(sizeof(*out_node));
-    
-    if (out_node == NULL)
+    Map_Pool pool = malloc(sizeof(*pool));
+    if (pool == NULL)
     {
         return NULL;
     }
 
-    MapKeyElement  new_key  = copy_key_function(in_key);
-    MapDataElement new_data = copy_data_function(in_data);
-    out_node->key  = new_key;
-    out_node->data = new_data;
-    out_node->next = NULL;
-
-    return out_node;
+    pool->slabs      = NULL;
+    pool->free_nodes = NULL;
+    pool->free_count = 0;
+    pool->map_count  = 1;
+    return pool;
 }
 
-// Destroys a map node
-static void mapNodeDestroy(Map_Node current_node, freeMapDataElements free_data_func, 
-                           freeMapKeyElements free_key_func)
+
+// Returns a node to the pool. Pooled nodes are marked by a NULL key
+static void mapPoolReleaseNode(Map_Pool pool, Map_Node node)
 {
-    free_key_func(current_node->key);
-    free_data_func(current_node->data);
-    free(current_node);
+    node->key   = NULL;
+    node->data  = NULL;
+    node->owner = NULL;
+    node->right = pool->free_nodes;
+    pool->free_nodes = node;
+    (pool->free_count)++;
 }
 
 
-// Destroys an entire map list (Node and all next nodes in the list)
-static void mapNodeListDestroy(Map_Node current_node, freeMapDataElements free_data_func, 
-                           freeMapKeyElements free_key_func)
+// Adds a slab of at least min_capacity nodes to the pool. The nodes left in the
+// previous slab move to the free list, so none of them is skipped
+static bool mapPoolAddSlab(Map_Pool pool, int min_capacity)
 {
-    if (current_node == NULL)
+    Map_Slab slab = pool->slabs;
+    int capacity  = MAP_POOL_FIRST_SLAB_SIZE;
+    if (slab != NULL)
     {
-        return;
+        capacity = slab->capacity * 2 > MAP_POOL_MAX_SLAB_SIZE ? MAP_POOL_MAX_SLAB_SIZE
+                                                               : slab->capacity * 2;
+    }
+    capacity = capacity < min_capacity ? min_capacity : capacity;
+
+    Map_Slab new_slab = malloc(sizeof(*new_slab) + capacity * sizeof(struct map_node_t));
+    if (new_slab == NULL)
+    {
+        return false;
     }
-    Map_Node next_node = current_node->next;
-    mapNodeDestroy(current_node, free_data_func, free_key_func);
-    
-    if (next_node != NULL)
+
+    while (slab != NULL && slab->used < slab->capacity)
     {
-        mapNodeListDestroy(next_node, free_data_func, free_key_func);
+        mapPoolReleaseNode(pool, &(slab->nodes[(slab->used)++]));
     }
+    new_slab->next     = slab;
+    new_slab->capacity = capacity;
+    new_slab->used     = 0;
+    pool->slabs = new_slab;
+    return true;
 }
 
 
-// Copies a list of Map_Nodes
-static Map_Node mapNodeListCopy (Map_Node first_node, copyMapDataElements copy_data_function,
-                             copyMapKeyElements copy_key_function, freeMapDataElements free_data_func, 
-                             freeMapKeyElements free_key_func)
+// Takes a node from the map's pool, adding a bigger slab when the pool is used up
+static Map_Node mapPoolTakeNode(Map map)
 {
-    // Got empty list
-    if (first_node == NULL)
+    Map_Pool pool = map->pool;
+
+    // Reuse a released node if there is one
+    if (pool->free_nodes != NULL)
     {
-        return NULL;
+        Map_Node node    = pool->free_nodes;
+        pool->free_nodes = node->right;
+        (pool->free_count)--;
+        return node;
     }
 
-    // Allocate first node
-    Map_Node duplicated_node = malloc(sizeof(*duplicated_node));
-    if (duplicated_node == NULL)
+    if ((pool->slabs == NULL || pool->slabs->used == pool->slabs->capacity) &&
+        !mapPoolAddSlab(pool, 1))
     {
         return NULL;
     }
+    return &(pool->slabs->nodes[(pool->slabs->used)++]);
+}
 
-    // Copy keys & data, allocate new nodes
-    Map_Node iterator = duplicated_node;
-    do
+
+// Makes sure the next count nodes are taken from the pool without allocating
+static bool mapPoolReserve(Map map, int count)
+{
+    Map_Pool pool = map->pool;
+    int available = pool->free_count;
+    if (pool->slabs != NULL)
     {
-        // Copy key & data
-        iterator->data = copy_data_function(first_node->data);
-        iterator->key  = copy_key_function(first_node->key);
-        iterator->next = NULL;
+        available += pool->slabs->capacity - pool->slabs->used;
+    }
+    return available >= count || mapPoolAddSlab(pool, count - pool->free_count);
+}
 
-        first_node = first_node->next;
-        if (first_node == NULL)
-        {
-            break;
-        }
 
-        // Allocate next node
-        Map_Node new_node = malloc(sizeof(*new_node));
-        if (new_node == NULL)
+// Frees the key & data a node owns. Int keys are part of the node itself
+static void mapNodeFreeElements(Map map, Map_Node node)
+{
+    if (!map->int_keys)
+    {
+        MAP_STATS_ADD(map, free_calls, 1);
+        map->free_key_func(node->key);
+    }
+    MAP_STATS_ADD(map, free_calls, 1);
+    map->free_data_func(node->data);
+}
+
+
+// Frees the elements of every node taken from the pool that owns them, then all the
+// slabs, leaving the pool empty. Walks the slabs instead of the tree, so no recursion
+// is involved
+static void mapPoolSweep(Map map)
+{
+    Map_Pool pool = map->pool;
+    Map_Slab slab = pool->slabs;
+    while (slab != NULL)
+    {
+        for (int i = 0 ; i < slab->used ; i++)
         {
-            mapNodeListDestroy(new_node, free_data_func, free_key_func);
-            return NULL;
+            if (slab->nodes[i].key != NULL && slab->nodes[i].owner == NULL)
+            {
+                mapNodeFreeElements(map, &(slab->nodes[i]));
+            }
         }
 
-        iterator->next = new_node;
-        iterator = new_node;
+        Map_Slab next_slab = slab->next;
+        free(slab);
+        slab = next_slab;
+    }
 
-    } while (first_node != NULL);
-    
-    return duplicated_node;
+    pool->slabs      = NULL;
+    pool->free_nodes = NULL;
+    pool->free_count = 0;
 }
 
 
-// Finds a placement for a new node with a specified key
-// If a node with that key exists, it returns it.
-// Otherwise, returns the node that should be placed BEFORE the new node after new nnde insertion
-// If the node should be placed before the first node / first node is NULL, returns NULL
-static Map_Node mapNodeFindPlacement(Map_Node node, MapKeyElement key, compareMapKeyElements compare_func)
+// Takes a map node from the pool, holding a copy of the given key and the given data
+// itself. Int keys are stored inline in the node instead of being copied
+static Map_Node mapNodeAllocate(Map map, MapKeyElement in_key, MapDataElement data)
 {
-    if (node == NULL || compare_func(key, node->key) < 0)
+    Map_Node out_node = mapPoolTakeNode(map);
+
+    if (out_node == NULL)
     {
         return NULL;
     }
 
-    // Scan node list to find correct node
-    while (node->next != NULL)
+    if (map->int_keys)
     {
-        // Comparing, if the next node's key is the same as the wanted key - return the next node
-        int comparison =  compare_func(key, node->next->key);
-        if (comparison == 0)
-        {
-            return node->next;
-        }
-
-        // If the next node's key is LOWER than the key, return current node
-        if (compare_func(key, node->next->key) < 0)
+        out_node->int_key = *(int*)in_key;
+        out_node->key     = &(out_node->int_key);
+    }
+    else
+    {
+        MAP_STATS_ADD(map, copy_calls, 1);
+        out_node->key = map->copy_key_func(in_key);
+        if (out_node->key == NULL)
         {
-            return node;
+            mapPoolReleaseNode(map->pool, out_node);
+            return NULL;
         }
-
-        node = node->next;
     }
 
-    // Should be inserted after the last node
-    return node;
-}
+    out_node->data        = data;
+    out_node->left        = NULL;
+    out_node->right       = NULL;
+    out_node->owner       = NULL;
+    out_node->share_count = 1;
+    out_node->height      = 1;
+    out_node->hash        = 0;
 
+    return out_node;
+}
 
-// ASSUMING NODE IS IN FIRST_NODE'S LIST
-static Map_Node mapNodeFindPrev(Map_Node first_node, Map_Node node, compareMapKeyElements compare_func)
+// Creates a map node holding copies of the given key & data
+static Map_Node mapNodeCreate(Map map, MapKeyElement in_key, MapDataElement in_data)
 {
-    if (first_node == NULL || node == NULL || first_node->key == node->key)
+    MAP_STATS_ADD(map, copy_calls, 1);
+    MapDataElement new_data = map->copy_data_func(in_data);
+    if (new_data == NULL)
     {
         return NULL;
     }
 
-    while (compare_func(first_node->next->key, node->key) != 0)
+    Map_Node out_node = mapNodeAllocate(map, in_key, new_data);
+    if (out_node == NULL)
     {
-        first_node = first_node->next;
+        MAP_STATS_ADD(map, free_calls, 1);
+        map->free_data_func(new_data);
+        return NULL;
     }
 
-    return first_node;
+    return out_node;
 }
 
 
-Map mapCreate(copyMapDataElements copyDataElement,
-              copyMapKeyElements copyKeyElement,
-              freeMapDataElements freeDataElement,
-              freeMapKeyElements freeKeyElement,
-              compareMapKeyElements compareKeyElements)
+// Returns a node no longer linked anywhere to the pool. Its key & data are freed,
+// unless other nodes still borrow them
+static void mapNodeRelease(Map map, Map_Node node)
+{
+    Map_Node holder = node->owner;
+    if (holder == NULL)
+    {
+        mapNodeFreeElements(map, node);
+    }
+    else if (--(holder->share_count) == 0)
+    {
+        mapNodeFreeElements(map, holder);
+        mapPoolReleaseNode(map->pool, holder);
+    }
+    mapPoolReleaseNode(map->pool, node);
+}
+
 
+// Gives a node a key & data of its own if it borrows them, before its data is handed
+// out for changing. The last borrower takes the holder's elements over without copying
+static bool mapNodeOwnElements(Map map, Map_Node node)
 {
-    // allocate map
-    Map new_map = malloc(sizeof(*new_map));
-    if (new_map == NULL)
+    Map_Node holder = node->owner;
+    if (holder == NULL)
     {
-        return NULL;
+        return true;
     }
-    
 
-    new_map -> size = 0;
-    new_map -> first_node = NULL;
-    new_map -> iterator   = NULL;
+    if (holder->share_count > 1)
+    {
+        MAP_STATS_ADD(map, copy_calls, 1);
+        MapDataElement data = map->copy_data_func(node->data);
+        if (data == NULL)
+        {
+            return false;
+        }
+        if (!map->int_keys)
+        {
+            MAP_STATS_ADD(map, copy_calls, 1);
+            MapKeyElement key = map->copy_key_func(node->key);
+            if (key == NULL)
+            {
+                MAP_STATS_ADD(map, free_calls, 1);
+                map->free_data_func(data);
+                return false;
+            }
+            node->key = key;
+        }
+        node->data = data;
+        (holder->share_count)--;
+    }
+    else
+    {
+        mapPoolReleaseNode(map->pool, holder);
+    }
 
-    new_map -> compare_key_func = compareKeyElements;
-    new_map -> copy_data_func   = copyDataElement;
-    new_map -> copy_key_func    = copyKeyElement;
-    new_map -> free_data_func   = freeDataElement;
-    new_map -> free_key_func    = freeKeyElement;
-    
-    return new_map;
+    node->owner = NULL;
+    return true;
 }
 
 
+// Replaces the data of a node with a data element the map owns. A node borrowing its
+// elements stops borrowing them, which takes a copy of its key if they're still shared
+static bool mapNodeReplaceData(Map map, Map_Node node, MapDataElement data)
+{
+    Map_Node holder = node->owner;
+    if (holder != NULL && holder->share_count > 1)
+    {
+        if (!map->int_keys)
+        {
+            MAP_STATS_ADD(map, copy_calls, 1);
+            MapKeyElement key = map->copy_key_func(node->key);
+            if (key == NULL)
+            {
+                return false;
+            }
+            node->key = key;
+        }
+        (holder->share_count)--;
+        node->owner = NULL;
+        node->data  = data;
+        return true;
+    }
+
+    if (holder != NULL)
+    {
+        mapPoolReleaseNode(map->pool, holder);
+        node->owner = NULL;
+    }
+    MAP_STATS_ADD(map, free_calls, 1);
+    map->free_data_func(node->data);
+    node->data = data;
+    return true;
+}
 
 
-void mapDestroy(Map map)
+// Compares a key to the key of a node. Int keys are compared directly
+static int mapNodeCompare(Map map, MapKeyElement key, Map_Node node)
 {
-    if (map == NULL)
+    MAP_STATS_ADD(map, comparisons, 1);
+    if (map->int_keys)
     {
-        return;
+        int int_key = *(int*)key;
+        return (int_key > node->int_key) - (int_key < node->int_key);
     }
-    mapNodeListDestroy(map->first_node, map->free_data_func, map->free_key_func); /////////
-    free(map);
+    return map->compare_key_func(key, node->key);
 }
 
 
-Map mapCopy(Map map)
+// Compares two keys. Int keys are compared directly
+static int mapKeyCompare(Map map, MapKeyElement key1, MapKeyElement key2)
 {
-    if (map == NULL)
+    MAP_STATS_ADD(map, comparisons, 1);
+    if (map->int_keys)
     {
-        return NULL;
+        int int_key1 = *(int*)key1;
+        int int_key2 = *(int*)key2;
+        return (int_key1 > int_key2) - (int_key1 < int_key2);
     }
-
-    // Create new map
-    Map new_map = mapCreate(map->copy_data_func, map->copy_key_func,
-                            map->free_data_func, map->free_key_func,
-                            map->compare_key_func);
+    return map->compare_key_func(key1, key2);
+}
 
 
-    if (new_map == NULL)
+// Returns the node with the smallest key in the subtree
+static Map_Node mapNodeMinimum(Map_Node node)
+{
+    if (node == NULL)
     {
         return NULL;
     }
 
-    // If source map is empty (no Map_Nodes)
-    if (map->first_node == NULL)
+    while (node->left != NULL)
     {
-        new_map->first_node = NULL;
-        new_map->size       = 0;
-        return new_map;
+        node = node->left;
     }
+    return node;
+}
 
-    Map_Node new_node = mapNodeListCopy(map->first_node, map->copy_data_func, map->copy_key_func,
-                                    map->free_data_func, map->free_key_func);
-    if (new_node == NULL)
+
+// Returns the node with the greatest key in the subtree
+static Map_Node mapNodeMaximum(Map_Node node)
+{
+    if (node == NULL)
     {
-        free(new_map);
         return NULL;
     }
 
-    // Reset source map iterator, update new map size
-    map->iterator     = NULL;
-    new_map->iterator = NULL;
-    new_map->size = map->size;
-    new_map->first_node = new_node;
-    return new_map;
-
+    while (node->right != NULL)
+    {
+        node = node->right;
+    }
+    return node;
 }
 
 
-int mapGetSize(Map map)
+//==============================================================//
+//===================== PERSISTENT AVL TREE ====================//
+//==============================================================//
+
+// A copied tree map shares its nodes with the original - a node may be linked from
+// several maps and parent nodes, as counted by its share_count. Before a node is
+// changed, the link to it is "owned": a shared node is replaced by a copy of it that
+// only this map links to (the children are then shared by both). Changing a key
+// therefore copies just the nodes on its path from the root. A copy borrows the key &
+// data of the node it was made of through a holder node, so no element is copied
+// until its data is handed out for changing (see mapNodeOwnElements).
+
+// Links from the root down to a key, as recorded by mapTreeDescend
+typedef struct map_tree_path_t {
+    Map_Node* links[MAP_MAX_TREE_HEIGHT + 2];
+    int length;             // links[length] is the link of the key, the rest lead to it
+} MapTreePath;
+
+
+static int mapNodeHeight(Map_Node node)
 {
-    if (map == NULL)
-    {
-        return -1;
-    }
+    return node == NULL ? 0 : node->height;
+}
 
-    // Size will be updated when adding/removing items from the map
-    return map->size;
+static void mapNodeUpdateHeight(Map_Node node)
+{
+    int left_height  = mapNodeHeight(node->left);
+    int right_height = mapNodeHeight(node->right);
+    node->height = 1 + (left_height > right_height ? left_height : right_height);
+}
+
+static int mapNodeBalance(Map_Node node)
+{
+    return mapNodeHeight(node->left) - mapNodeHeight(node->right);
 }
 
 
-bool mapContains(Map map, MapKeyElement element)
+// Makes the node a link (of a tree, or a hashed map's slot) points to this map's own,
+// replacing it by a copy if it is shared. The copy and the node borrow the key & data from a common holder.
+// Returns false if a node couldn't be taken from the pool (the map is unchanged)
+static bool mapNodeOwnLink(Map map, Map_Node* link)
 {
-    // Invalid input, return false
-    if (map == NULL || element == NULL)
+    Map_Node node = *link;
+    if (node == NULL || node->share_count == 1)
     {
-        return false;
+        return true;
     }
 
-    // Initialize iterator node and scan for the key
-    Map_Node node = map->first_node;
-    while (node != NULL)
+    Map_Node holder = node->owner;
+    if (holder == NULL)
     {
-        if (map->compare_key_func(element, node->key) == 0)   // <<<<<<<<<<<<<<<<<<< ADD 
+        holder = mapPoolTakeNode(map);
+        if (holder == NULL)
         {
-            return true;
+            return false;
         }
-        
-        node = node->next;
+        holder->int_key     = node->int_key;
+        holder->key         = map->int_keys ? &(holder->int_key) : node->key;
+        holder->data        = node->data;
+        holder->left        = NULL;
+        holder->right       = NULL;
+        holder->owner       = NULL;
+        holder->share_count = 1;
+        node->owner = holder;
+    }
+
+    Map_Node copy = mapPoolTakeNode(map);
+    if (copy == NULL)
+    {
+        return false;
+    }
+    *copy = *node;
+    if (map->int_keys)
+    {
+        copy->key = &(copy->int_key);
+    }
+    copy->share_count = 1;
+    (holder->share_count)++;
+    if (copy->left != NULL)
+    {
+        (copy->left->share_count)++;
+    }
+    if (copy->right != NULL)
+    {
+        (copy->right->share_count)++;
     }
-    map->iterator = NULL;
-    return false;
+
+    (node->share_count)--;
+    *link = copy;
+    return true;
 }
 
 
+// The most nodes a change of a shared tree may take from the pool - every node on the
+// path, and two more per level for rotations, each copied together with a holder
+static int mapTreeChangeCost(Map map)
+{
+    return 6 * mapNodeHeight(map->root) + 2;
+}
+
 
-MapResult mapPut(Map map, MapKeyElement keyElement, MapDataElement dataElement)
+// Drops a link to a subtree, returning the nodes no longer linked from anywhere to the
+// pool. Walks the subtree with an explicit stack, so no recursion is involved
+static void mapTreeDrop(Map map, Map_Node node)
 {
-    // Verify the input items aren't NULL
-    if (map == NULL || keyElement == NULL || dataElement == NULL)
+    Map_Node pending[2 * MAP_MAX_TREE_HEIGHT];
+    int count = 0;
+    if (node != NULL)
     {
-        return MAP_NULL_ARGUMENT;
+        pending[count++] = node;
     }
 
-    // Get the node with specified key / the one that should come before it
-    Map_Node prev_node = mapNodeFindPlacement(map->first_node, keyElement, map->compare_key_func);
-
-    // If the key exists, update the data
-    if (prev_node != NULL && (map->compare_key_func(prev_node->key, keyElement) == 0))
+    while (count > 0)
     {
-        map->free_data_func(prev_node->data);
-        prev_node->data = map->copy_data_func(dataElement);
-        return MAP_SUCCESS;
+        Map_Node current = pending[--count];
+        if (--(current->share_count) > 0)
+        {
+            continue;
+        }
+        if (current->left != NULL)
+        {
+            pending[count++] = current->left;
+        }
+        if (current->right != NULL)
+        {
+            pending[count++] = current->right;
+        }
+        mapNodeRelease(map, current);
     }
+}
+
 
-    // Otherwise, create a new node that should be placed after prev_node
-    Map_Node new_node = mapNodeCreate(keyElement, dataElement, map->copy_data_func, map->copy_key_func);
+// Rotations change the node a link points to and its child, so both are owned first.
+// Changes of shared trees reserve pool nodes in advance, so owning them can't fail
+static void mapTreeRotateLeft(Map map, Map_Node* link)
+{
+    bool is_owned = mapNodeOwnLink(map, link) && mapNodeOwnLink(map, &((*link)->right));
+    assert(is_owned);
+    (void)is_owned;
+
+    Map_Node node  = *link;
+    Map_Node pivot = node->right;
+    node->right = pivot->left;
+    pivot->left = node;
+    *link       = pivot;
+
+    mapNodeUpdateHeight(node);
+    mapNodeUpdateHeight(pivot);
+}
+
+
+static void mapTreeRotateRight(Map map, Map_Node* link)
+{
+    bool is_owned = mapNodeOwnLink(map, link) && mapNodeOwnLink(map, &((*link)->left));
+    assert(is_owned);
+    (void)is_owned;
+
+    Map_Node node  = *link;
+    Map_Node pivot = node->left;
+    node->left   = pivot->right;
+    pivot->right = node;
+    *link        = pivot;
+
+    mapNodeUpdateHeight(node);
+    mapNodeUpdateHeight(pivot);
+}
 
-    // If new_node should be first
-    if (prev_node == NULL)
+
+// Restores the AVL property on a path, from path->links[index] up to the root.
+// Stops once a subtree keeps its height, as nothing above it changes then
+static void mapTreeRebalance(Map map, MapTreePath* path, int index)
+{
+    for ( ; index >= 0 ; index--)
     {
-        new_node->next = map->first_node;
-        map->first_node = new_node;
-        (map->size)++;
-        return MAP_SUCCESS;
+        Map_Node* link = path->links[index];
+        Map_Node node  = *link;
+        int old_height = node->height;
+        mapNodeUpdateHeight(node);
+        int balance = mapNodeBalance(node);
+
+        // Left heavy
+        if (balance > 1)
+        {
+            if (mapNodeBalance(node->left) < 0)
+            {
+                mapTreeRotateLeft(map, &(node->left));
+            }
+            mapTreeRotateRight(map, link);
+        }
+
+        // Right heavy
+        if (balance < -1)
+        {
+            if (mapNodeBalance(node->right) > 0)
+            {
+                mapTreeRotateRight(map, &(node->right));
+            }
+            mapTreeRotateLeft(map, link);
+        }
+
+        if ((*link)->height == old_height)
+        {
+            return;
+        }
     }
+}
 
-    // If it shouldn't be first
-    Map_Node next_node = prev_node->next;
-    prev_node->next = new_node;
-    new_node ->next = next_node;
-    (map->size)++;
-    return MAP_SUCCESS;
-    
+
+// Sets the first & last nodes after the tree changed shape or its nodes were copied
+static void mapTreeUpdateEnds(Map map)
+{
+    map->first_node = mapNodeMinimum(map->root);
+    map->last_node  = mapNodeMaximum(map->root);
 }
 
 
-MapDataElement mapGet(Map map, MapKeyElement keyElement)
+// Pops the next node of a tree cursor off its stack
+static void mapTreeCursorPop(MapCursor *cursor)
 {
-    // Verify input
-    if (map == NULL || keyElement == NULL)
+    cursor->position = cursor->depth > 0 ? cursor->path[--(cursor->depth)] : NULL;
+}
+
+
+// Pushes a node and its left descendants to a tree cursor's stack - the nodes to visit
+// before returning to the ones already there
+static void mapTreeCursorPushLeftEdge(MapCursor *cursor, Map_Node node)
+{
+    while (node != NULL)
     {
-        return NULL;
+        cursor->path[(cursor->depth)++] = node;
+        node = node->left;
     }
+}
 
 
-    // Return data if key exists
-    if (mapContains(map, keyElement))
+// Returns the node a tree cursor moves to next, without moving it
+static Map_Node mapTreeCursorPeek(MapCursor *cursor)
+{
+    Map_Node position = cursor->position;
+    if (position->right != NULL)
     {
-        Map_Node node = mapNodeFindPlacement(map->first_node, keyElement, map->compare_key_func);
-        assert(map->compare_key_func(node->key, keyElement) == 0);
-        return node->data;
+        return mapNodeMinimum(position->right);
     }
-
-    // Key doesn't exist
-    return NULL;
+    return cursor->depth > 0 ? cursor->path[cursor->depth - 1] : NULL;
 }
 
 
-MapResult mapRemove(Map map, MapKeyElement keyElement)
+// Sets a tree cursor to the first node whose key isn't smaller than the given key (or
+// is greater than it, if strict). The cursor's stack holds the nodes passed on the way
+// down whose left subtree the position is in - the nodes to visit after it
+static void mapTreeSeek(Map map, MapKeyElement key, bool strict, MapCursor *cursor)
 {
-    // Verify input
-    if (map == NULL || keyElement == NULL)
+    MAP_STATS_ADD(map, lookups, 1);
+    cursor->depth = 0;
+    Map_Node node = map->root;
+    while (node != NULL)
     {
-        return MAP_NULL_ARGUMENT;
+        MAP_STATS_ADD(map, nodes_traversed, 1);
+        int comparison = mapNodeCompare(map, key, node);
+        if (comparison < 0 || (comparison == 0 && !strict))
+        {
+            cursor->path[(cursor->depth)++] = node;
+            if (comparison == 0)
+            {
+                break;
+            }
+            node = node->left;
+        }
+        else
+        {
+            node = node->right;
+        }
     }
+    mapTreeCursorPop(cursor);
+}
 
-    map->iterator = NULL; // Now or later?
 
-    // Item not found
-    if (!mapContains(map, keyElement))
+// Moves the internal iterator to its key in the map's own nodes, after copying nodes
+// replaced the ones its stack holds
+static void mapTreeReseekIterator(Map map)
+{
+    Map_Node position = map->iterator.position;
+    if (position == NULL)
     {
-        return MAP_ITEM_DOES_NOT_EXIST;
+        return;
     }
 
-    // Find node to remove and it's previous node
-    Map_Node node_to_remove = mapNodeFindPlacement(map->first_node, keyElement, map->compare_key_func);
-    Map_Node prev_node      = mapNodeFindPrev(map->first_node, node_to_remove, map->compare_key_func);
+    int int_key = position->int_key;
+    mapTreeSeek(map, map->int_keys ? &int_key : position->key, false, &(map->iterator));
+}
+
 
-    // First to be removed
-    if (prev_node == NULL)
+// Makes all the nodes of a tree map and their elements the map's own, before data that
+// may be changed is handed out by a cursor. On failure the map is unchanged, but may
+// still share some of its nodes
+static bool mapTreeOwnAll(Map map)
+{
+    Map_Node* pending[2 * MAP_MAX_TREE_HEIGHT];
+    int count = 0;
+    bool is_owned = true;
+    pending[count++] = &(map->root);
+    while (count > 0 && is_owned)
     {
-        map->first_node = map->first_node->next;
-        mapNodeDestroy(node_to_remove, map->free_data_func, map->free_key_func);
-        (map->size)--;
-        return MAP_SUCCESS;
+        Map_Node* link = pending[--count];
+        if (*link == NULL)
+        {
+            continue;
+        }
+        MAP_STATS_ADD(map, nodes_traversed, 1);
+        is_owned = mapNodeOwnLink(map, link) && mapNodeOwnElements(map, *link);
+        if (is_owned)
+        {
+            pending[count++] = &((*link)->right);
+            pending[count++] = &((*link)->left);
+        }
     }
 
-    // Case - node to remove is not the first node
-    prev_node->next = node_to_remove->next;
-    mapNodeDestroy(node_to_remove, map->free_data_func, map->free_key_func);
-    (map->size)--;
-    return MAP_SUCCESS;
+    mapTreeUpdateEnds(map);
+    mapTreeReseekIterator(map);
+    return is_owned;
 }
 
 
-MapKeyElement mapGetFirst(Map map)
+// Builds a balanced subtree holding the sorted keys[low..high) & their data (copies of
+// it, or the data itself if adopt is set), by making the middle key the root.
+// On failure, the nodes made are left in the pool
+static Map_Node mapNodeSubtreeBuild(Map map, MapKeyElement* keys, MapDataElement* data,
+                                    int low, int high, bool adopt)
 {
-    // Verify input
-    if (map == NULL || map->first_node == NULL)
+    if (low >= high)
     {
         return NULL;
     }
 
-    map->iterator = map->first_node;
-    return map->copy_key_func(map->iterator->key);
-}
+    int middle    = low + (high - low) / 2;
+    Map_Node node = adopt ? mapNodeAllocate(map, keys[middle], data[middle])
+                          : mapNodeCreate(map, keys[middle], data[middle]);
+    if (node == NULL)
+    {
+        return NULL;
+    }
 
+    node->left = mapNodeSubtreeBuild(map, keys, data, low, middle, adopt);
+    if (middle > low && node->left == NULL)
+    {
+        return NULL;
+    }
 
-MapKeyElement mapGetNext(Map map)
-{
-    // Verify input
-    if (map == NULL || map->iterator == NULL || map->iterator->next == NULL)
+    node->right = mapNodeSubtreeBuild(map, keys, data, middle + 1, high, adopt);
+    if (high > middle + 1 && node->right == NULL)
     {
         return NULL;
     }
 
-    map->iterator = map->iterator->next;
-    return map->copy_key_func(map->iterator->key);
+    mapNodeUpdateHeight(node);
+    return node;
 }
 
 
-MapResult mapClear(Map map)
+// Key functions of int keyed maps. Keys are copied only when handed out by the iterator
+static MapKeyElement mapIntKeyCopy(MapKeyElement key)
 {
-    if (map == NULL)
+    int* new_key = malloc(sizeof(*new_key));
+    if (new_key == NULL)
     {
-        return MAP_NULL_ARGUMENT;
+        return NULL;
     }
+    *new_key = *(int*)key;
+    return new_key;
+}
 
-    map->size = 0;
-    map->iterator = NULL;
-    mapNodeListDestroy(map->first_node, map->free_data_func, map->free_key_func);
-    map->first_node = NULL;
-    return MAP_SUCCESS;
+static void mapIntKeyFree(MapKeyElement key)
+{
+    free(key);
 }
 
+static int mapIntKeyCompare(MapKeyElement key1, MapKeyElement key2)
+{
+    int int_key1 = *(int*)key1;
+    int int_key2 = *(int*)key2;
+    return (int_key1 > int_key2) - (int_key1 < int_key2);
+}
+
+// 32 bit finalizer of MurmurHash3 - spreads nearby ids over the whole table
+static unsigned int mapIntKeyHash(MapKeyElement key)
+{
+    unsigned int hash = (unsigned int)*(int*)key;
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+
+//==============================================================//
+//======================= HASH BACKEND =========================//
+//==============================================================//
+
+static bool mapIsHashed(Map map)
+{
+    return map->hash_key_func != NULL;
+}
+
+
+// Allocates an empty slot array
+static Map_Slots mapSlotsCreate(int capacity)
+{
+    Map_Slots slots = calloc(1, sizeof(*slots) + capacity * sizeof(Map_Node));
+    if (slots == NULL)
+    {
+        return NULL;
+    }
+
+    slots->map_count = 1;
+    return slots;
+}
+
+
+// Returns the slot index a key with the given hash would start probing from
+static int mapHashHomeSlot(Map map, unsigned int hash)
+{
+    return (int)(hash & (unsigned int)(map->capacity - 1));
+}
+
+
+// Finds the slot holding a specified key. If the key is not in the map,
+// returns the empty slot it should be inserted to
+static int mapHashFindSlot(Map map, MapKeyElement key, unsigned int hash)
+{
+    int mask  = map->capacity - 1;
+    int index = mapHashHomeSlot(map, hash);
+    while (map->slots->nodes[index] != NULL)
+    {
+        MAP_STATS_ADD(map, nodes_traversed, 1);
+        Map_Node node = map->slots->nodes[index];
+        if (node->hash == hash && mapNodeCompare(map, key, node) == 0)
+        {
+            return index;
+        }
+        index = (index + 1) & mask;
+    }
+    return index;
+}
+
+
+// Drops the ordered snapshot, it is rebuilt by the next iteration
+static void mapHashInvalidateSnapshot(Map map)
+{
+    free(map->sorted_nodes);
+    map->sorted_nodes      = NULL;
+    map->iterator.position = NULL;
+}
+
+
+// Moves all nodes to a slot array with twice the capacity
+static bool mapHashGrow(Map map)
+{
+    int new_capacity = map->capacity * 2;
+    Map_Slots new_slots = mapSlotsCreate(new_capacity);
+    if (new_slots == NULL)
+    {
+        return false;
+    }
+
+    Map_Slots old_slots = map->slots;
+    int old_capacity    = map->capacity;
+    map->slots    = new_slots;
+    map->capacity = new_capacity;
+    for (int i = 0 ; i < old_capacity ; i++)
+    {
+        if (old_slots->nodes[i] != NULL)
+        {
+            int index = mapHashHomeSlot(map, old_slots->nodes[i]->hash);
+            while (new_slots->nodes[index] != NULL)
+            {
+                index = (index + 1) & (new_capacity - 1);
+            }
+            new_slots->nodes[index] = old_slots->nodes[i];
+        }
+    }
+
+    free(old_slots);
+    return true;
+}
+
+
+// Empties a slot, shifting back later nodes of the probe run so lookups never
+// stop early at the hole
+static void mapHashEmptySlot(Map map, int index)
+{
+    int mask = map->capacity - 1;
+    int next = (index + 1) & mask;
+    map->slots->nodes[index] = NULL;
+
+    while (map->slots->nodes[next] != NULL)
+    {
+        int home = mapHashHomeSlot(map, map->slots->nodes[next]->hash);
+
+        // The node may move to the hole only if its home isn't cyclically in (index, next]
+        bool home_after_hole = (index <= next) ? (index < home && home <= next)
+                                               : (index < home || home <= next);
+        if (!home_after_hole)
+        {
+            map->slots->nodes[index] = map->slots->nodes[next];
+            map->slots->nodes[next]  = NULL;
+            index = next;
+        }
+        next = (next + 1) & mask;
+    }
+}
+
+
+// Merge sorts an array of nodes by key, using buffer as scratch space
+static void mapNodeArraySort(Map map, Map_Node* nodes, Map_Node* buffer, int length)
+{
+    if (length < 2)
+    {
+        return;
+    }
+
+    int middle = length / 2;
+    mapNodeArraySort(map, nodes, buffer, middle);
+    mapNodeArraySort(map, nodes + middle, buffer, length - middle);
+
+    int left = 0, right = middle, merged = 0;
+    while (left < middle && right < length)
+    {
+        if (mapNodeCompare(map, nodes[right]->key, nodes[left]) < 0)
+        {
+            buffer[merged++] = nodes[right++];
+        }
+        else
+        {
+            buffer[merged++] = nodes[left++];
+        }
+    }
+    while (left < middle)
+    {
+        buffer[merged++] = nodes[left++];
+    }
+    while (right < length)
+    {
+        buffer[merged++] = nodes[right++];
+    }
+
+    for (int i = 0 ; i < length ; i++)
+    {
+        nodes[i] = buffer[i];
+    }
+}
+
+
+// Builds the ordered snapshot used for iterating a hashed map (if not built already)
+static bool mapHashBuildSnapshot(Map map)
+{
+    if (map->sorted_nodes != NULL)
+    {
+        return true;
+    }
+
+    Map_Node* nodes  = malloc(map->size * sizeof(*nodes));
+    Map_Node* buffer = malloc(map->size * sizeof(*buffer));
+    if (nodes == NULL || buffer == NULL)
+    {
+        free(nodes);
+        free(buffer);
+        return false;
+    }
+
+    int count = 0;
+    for (int i = 0 ; i < map->capacity ; i++)
+    {
+        if (map->slots->nodes[i] != NULL)
+        {
+            nodes[count++] = map->slots->nodes[i];
+        }
+    }
+    assert(count == map->size);
+
+    mapNodeArraySort(map, nodes, buffer, count);
+    free(buffer);
+    map->sorted_nodes = nodes;
+    return true;
+}
+
+
+// Returns the index of the first node in the sorted snapshot of a hashed map whose key
+// isn't smaller than the given key (or is greater than it, if strict), map->size if
+// there is none
+static int mapSnapshotBound(Map map, MapKeyElement key, bool strict)
+{
+    MAP_STATS_ADD(map, lookups, 1);
+    int low  = 0;
+    int high = map->size;
+    while (low < high)
+    {
+        MAP_STATS_ADD(map, nodes_traversed, 1);
+        int middle     = low + (high - low) / 2;
+        int comparison = mapNodeCompare(map, key, map->sorted_nodes[middle]);
+        if (comparison < 0 || (comparison == 0 && !strict))
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle + 1;
+        }
+    }
+    return low;
+}
+
+
+// Frees every node of a map that doesn't share its pool (of either backend), leaving it empty
+static void mapDestroyAllNodes(Map map)
+{
+    mapPoolSweep(map);
+    if (mapIsHashed(map))
+    {
+        for (int i = 0 ; i < map->capacity ; i++)
+        {
+            map->slots->nodes[i] = NULL;
+        }
+    }
+    mapHashInvalidateSnapshot(map);
+    map->root       = NULL;
+    map->first_node = NULL;
+    map->last_node  = NULL;
+    map->size       = 0;
+}
+
+
+// Empties the pool of a map whose nodes hold data elements it doesn't own - their keys
+// are freed, and their data is left to its owner
+static void mapDestroyAllNodesKeepData(Map map)
+{
+    for (Map_Slab slab = map->pool->slabs ; slab != NULL ; slab = slab->next)
+    {
+        for (int i = 0 ; i < slab->used ; i++)
+        {
+            if (slab->nodes[i].key != NULL && slab->nodes[i].owner == NULL)
+            {
+                if (!map->int_keys)
+                {
+                    MAP_STATS_ADD(map, free_calls, 1);
+                    map->free_key_func(slab->nodes[i].key);
+                }
+                slab->nodes[i].key = NULL;
+            }
+        }
+    }
+    mapDestroyAllNodes(map);
+}
+
+
+// Drops the map's link to its slot array. An array no other map uses is freed, and
+// the nodes no other array links to are returned to the pool
+static void mapHashDrop(Map map)
+{
+    Map_Slots slots = map->slots;
+    if (--(slots->map_count) > 0)
+    {
+        return;
+    }
+
+    for (int i = 0 ; i < map->capacity ; i++)
+    {
+        Map_Node node = slots->nodes[i];
+        if (node != NULL && --(node->share_count) == 0)
+        {
+            mapNodeRelease(map, node);
+        }
+    }
+    free(slots);
+}
+
+
+// Gives a hashed map a slot array of its own if it shares it with copies of it. The
+// nodes are then linked from both arrays, so neither a node nor an element is copied
+static bool mapHashUnshare(Map map)
+{
+    if (map->slots->map_count == 1)
+    {
+        return true;
+    }
+
+    Map_Slots slots = mapSlotsCreate(map->capacity);
+    if (slots == NULL)
+    {
+        return false;
+    }
+    for (int i = 0 ; i < map->capacity ; i++)
+    {
+        Map_Node node = map->slots->nodes[i];
+        if (node != NULL)
+        {
+            (node->share_count)++;
+            slots->nodes[i] = node;
+        }
+    }
+
+    (map->slots->map_count)--;
+    map->slots = slots;
+    return true;
+}
+
+
+// Makes the node in a slot the map's own (see mapNodeOwnLink), once the map has a slot
+// array of its own. A copy of the node replaces it in the ordered snapshot too, so the
+// internal iterator stays where it is
+static bool mapHashOwnSlot(Map map, int slot)
+{
+    Map_Node node = map->slots->nodes[slot];
+    if (!mapNodeOwnLink(map, &(map->slots->nodes[slot])))
+    {
+        return false;
+    }
+
+    Map_Node own_node = map->slots->nodes[slot];
+    if (own_node != node && map->sorted_nodes != NULL)
+    {
+        int index = mapSnapshotBound(map, own_node->key, false);
+        map->sorted_nodes[index] = own_node;
+        if (map->iterator.position == node)
+        {
+            map->iterator.position = own_node;
+        }
+    }
+    return true;
+}
+
+
+// Makes all the nodes of a hashed map and their elements its own, before data that may
+// be changed is handed out by a cursor. On failure the map is unchanged, but may still
+// share some of its nodes
+static bool mapHashOwnAll(Map map)
+{
+    if (!mapHashUnshare(map))
+    {
+        return false;
+    }
+
+    for (int i = 0 ; i < map->capacity ; i++)
+    {
+        if (map->slots->nodes[i] != NULL &&
+            (!mapHashOwnSlot(map, i) || !mapNodeOwnElements(map, map->slots->nodes[i])))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+//==============================================================//
+//====================== SINGLE PASS LOOKUP ====================//
+//==============================================================//
+
+// Result of a single descent (tree) / probe (hash) for a key - the node holding
+// the key, or everything needed to link a new node for it without searching again
+typedef struct map_location_t {
+    Map_Node node;          // The node holding the key, NULL if the key is not in the map
+    MapTreePath path;       // Tree - the links from the root to the key (mapLocateForChange)
+    bool is_new_first;      // Tree - whether a new node for the key will hold the smallest key
+    bool is_new_last;       // Tree - whether a new node for the key will hold the greatest key
+    int slot;               // Hash - the slot holding the key / the empty slot for it
+    unsigned int hash;      // Hash - the hash of the key
+} MapLocation;
+
+
+// Looks a key up with a single traversal of the map, without changing it
+static void mapLocate(Map map, MapKeyElement key, MapLocation* location)
+{
+    MAP_STATS_ADD(map, lookups, 1);
+    location->node = NULL;
+
+    if (mapIsHashed(map))
+    {
+        location->hash = map->int_keys ? mapIntKeyHash(key) : map->hash_key_func(key);
+        location->slot = mapHashFindSlot(map, key, location->hash);
+        location->node = map->slots->nodes[location->slot];
+        return;
+    }
+
+    // Fast path for keys appended in ascending order (e.g. sequential ids) -
+    // a key greater than the greatest one is not in the map
+    if (map->last_node != NULL)
+    {
+        MAP_STATS_ADD(map, nodes_traversed, 1);
+        int comparison = mapNodeCompare(map, key, map->last_node);
+        if (comparison >= 0)
+        {
+            location->node = comparison == 0 ? map->last_node : NULL;
+            return;
+        }
+    }
+
+    Map_Node node = map->root;
+    while (node != NULL)
+    {
+        MAP_STATS_ADD(map, nodes_traversed, 1);
+        int comparison = mapNodeCompare(map, key, node);
+        if (comparison == 0)
+        {
+            location->node = node;
+            return;
+        }
+        node = comparison < 0 ? node->left : node->right;
+    }
+}
+
+
+// Descends from the root to the link of a key - holding its node, or the empty link a
+// new node for it hangs from - owning the nodes passed so they may be changed.
+// Returns false if owning a node failed
+static bool mapTreeDescend(Map map, MapKeyElement key, MapLocation* location)
+{
+    MapTreePath* path = &(location->path);
+    Map_Node* link    = &(map->root);
+    path->length           = 0;
+    location->node         = NULL;
+    location->is_new_first = true;
+    location->is_new_last  = true;
+
+    // Keys not smaller than the greatest key (e.g. sequential ids) are on the right
+    // edge of the tree, which is walked down without comparing
+    int last_comparison = -1;
+    if (map->last_node != NULL)
+    {
+        MAP_STATS_ADD(map, nodes_traversed, 1);
+        last_comparison = mapNodeCompare(map, key, map->last_node);
+    }
+
+    bool is_owned = mapNodeOwnLink(map, link);
+    while (is_owned && *link != NULL)
+    {
+        Map_Node node  = *link;
+        int comparison = 1;
+        if (last_comparison < 0)
+        {
+            MAP_STATS_ADD(map, nodes_traversed, 1);
+            comparison = mapNodeCompare(map, key, node);
+        }
+        else if (node->right == NULL)
+        {
+            comparison = last_comparison;
+        }
+
+        if (comparison == 0)
+        {
+            location->node = node;
+            break;
+        }
+        if (comparison > 0)
+        {
+            location->is_new_first = false;
+        }
+        else
+        {
+            location->is_new_last = false;
+        }
+        path->links[(path->length)++] = link;
+        link     = comparison < 0 ? &(node->left) : &(node->right);
+        is_owned = mapNodeOwnLink(map, link);
+    }
+
+    path->links[path->length] = link;
+    return is_owned;
+}
+
+
+// Allocates a map of either backend
+static Map mapCreateBackend(copyMapDataElements copyDataElement,
+                            copyMapKeyElements copyKeyElement,
+                            freeMapDataElements freeDataElement,
+                            freeMapKeyElements freeKeyElement,
+                            compareMapKeyElements compareKeyElements,
+                            hashMapKeyElements hashKeyElement,
+                            int capacity)
+{
+    if (copyDataElement == NULL || copyKeyElement == NULL || freeDataElement == NULL ||
+        freeKeyElement == NULL || compareKeyElements == NULL)
+    {
+        return NULL;
+    }
+
+    // allocate map
+    Map new_map = malloc(sizeof(*new_map));
+    if (new_map == NULL)
+    {
+        return NULL;
+    }
+
+    new_map -> pool = mapPoolCreate();
+    if (new_map -> pool == NULL)
+    {
+        free(new_map);
+        return NULL;
+    }
+    new_map -> owns_all_nodes = true;
+
+    new_map -> slots    = NULL;
+    new_map -> capacity = 0;
+    if (hashKeyElement != NULL)
+    {
+        new_map -> slots = mapSlotsCreate(capacity);
+        if (new_map -> slots == NULL)
+        {
+            free(new_map -> pool);
+            free(new_map);
+            return NULL;
+        }
+        new_map -> capacity = capacity;
+    }
+
+    new_map -> size = 0;
+    new_map -> root              = NULL;
+    new_map -> first_node        = NULL;
+    new_map -> last_node         = NULL;
+    new_map -> sorted_nodes      = NULL;
+    new_map -> int_keys          = false;
+    new_map -> iterator.map      = new_map;
+    new_map -> iterator.position = NULL;
+#ifdef MAP_STATS
+    memset(&(new_map->stats), 0, sizeof(new_map->stats));
+#endif
+
+    new_map -> compare_key_func = compareKeyElements;
+    new_map -> copy_data_func   = copyDataElement;
+    new_map -> copy_key_func    = copyKeyElement;
+    new_map -> free_data_func   = freeDataElement;
+    new_map -> free_key_func    = freeKeyElement;
+    new_map -> hash_key_func    = hashKeyElement;
+
+    return new_map;
+}
+
+
+// Locates a key for changing the map - its node (or the place for a new one) and for
+// trees the path to it become this map's own. Shared trees reserve the pool nodes the
+// whole change may take first, so linking / unlinking a node afterwards can't fail
+static bool mapLocateForChange(Map map, MapKeyElement key, MapLocation* location)
+{
+    if (mapIsHashed(map))
+    {
+        if (!mapHashUnshare(map))
+        {
+            return false;
+        }
+        mapLocate(map, key, location);
+        if (location->node != NULL)
+        {
+            if (!mapHashOwnSlot(map, location->slot))
+            {
+                return false;
+            }
+            location->node = map->slots->nodes[location->slot];
+        }
+        return true;
+    }
+
+    MAP_STATS_ADD(map, lookups, 1);
+    bool is_shared = map->pool->map_count > 1;
+    if (is_shared && !mapPoolReserve(map, mapTreeChangeCost(map)))
+    {
+        return false;
+    }
+
+    bool is_located = mapTreeDescend(map, key, location);
+    if (is_shared)
+    {
+        mapTreeUpdateEnds(map);
+        mapTreeReseekIterator(map);
+    }
+    return is_located;
+}
+
+
+// Finds the node of a key whose data is handed out for changing, making it (and for
+// trees, the path to it) the map's own. A missing key is found without copying anything.
+// Returns false if an allocation failed
+static bool mapFindForChange(Map map, MapKeyElement key, Map_Node* node)
+{
+    MapLocation location;
+    mapLocate(map, key, &location);
+    *node = NULL;
+    if (location.node == NULL)
+    {
+        return true;
+    }
+
+    if ((map->pool->map_count > 1 && !mapLocateForChange(map, key, &location)) ||
+        !mapNodeOwnElements(map, location.node))
+    {
+        return false;
+    }
+    *node = location.node;
+    return true;
+}
+
+
+// Makes all the nodes of a map and their elements its own, before data that may be
+// changed is handed out by a cursor. This is recorded, so it's done once per copy
+static bool mapOwnAll(Map map)
+{
+    if (map->pool->map_count == 1 || map->owns_all_nodes)
+    {
+        return true;
+    }
+
+    map->owns_all_nodes = mapIsHashed(map) ? mapHashOwnAll(map) : mapTreeOwnAll(map);
+    return map->owns_all_nodes;
+}
+
+
+// Gives a map that shares its pool an empty pool of its own, leaving its nodes to the
+// maps it shared them with
+static bool mapLeavePool(Map map)
+{
+    Map_Pool pool = mapPoolCreate();
+    if (pool == NULL)
+    {
+        return false;
+    }
+
+    if (mapIsHashed(map))
+    {
+        Map_Slots slots = mapSlotsCreate(map->capacity);
+        if (slots == NULL)
+        {
+            free(pool);
+            return false;
+        }
+        mapHashDrop(map);
+        map->slots = slots;
+    }
+    else
+    {
+        mapTreeDrop(map, map->root);
+    }
+
+    (map->pool->map_count)--;
+    map->pool           = pool;
+    map->owns_all_nodes = true;
+    mapHashInvalidateSnapshot(map);
+    map->root       = NULL;
+    map->first_node = NULL;
+    map->last_node  = NULL;
+    map->size       = 0;
+    return true;
+}
+
+
+// Makes room for linking a new node at a location. Growing a hash table moves
+// the empty slot, so the location is updated
+static bool mapPrepareInsert(Map map, MapKeyElement key, MapLocation* location)
+{
+    if (!mapIsHashed(map) || (map->size + 1) * 4 <= map->capacity * 3)
+    {
+        return true;
+    }
+
+    // Keep the load factor under 3/4
+    if (!mapHashGrow(map))
+    {
+        return false;
+    }
+    location->slot = mapHashFindSlot(map, key, location->hash);
+    return true;
+}
+
+
+// Links a new node at the location found by mapLocateForChange (and prepared by
+// mapPrepareInsert)
+static void mapLinkNode(Map map, MapLocation* location, Map_Node new_node)
+{
+    (map->size)++;
+    MAP_STATS_UPDATE_PEAK(map);
+
+    if (mapIsHashed(map))
+    {
+        new_node->hash = location->hash;
+        map->slots->nodes[location->slot] = new_node;
+        mapHashInvalidateSnapshot(map);
+        return;
+    }
+
+    MapTreePath* path = &(location->path);
+    *(path->links[path->length]) = new_node;
+    mapTreeRebalance(map, path, path->length - 1);
+
+    // Rotations of a shared tree may copy the first / last nodes
+    if (map->pool->map_count > 1)
+    {
+        mapTreeUpdateEnds(map);
+        return;
+    }
+    if (location->is_new_first)
+    {
+        map->first_node = new_node;
+    }
+    if (location->is_new_last)
+    {
+        map->last_node = new_node;
+    }
+}
+
+
+// Unlinks the node found by mapLocateForChange from the tree, keeping it balanced.
+// The node itself is not freed
+static void mapTreeUnlinkNode(Map map, MapLocation* location)
+{
+    MapTreePath* path = &(location->path);
+    Map_Node* link    = path->links[path->length];
+    Map_Node node     = location->node;
+    int last          = path->length - 1;
+
+    if (node->left == NULL)
+    {
+        *link = node->right;
+    }
+    else if (node->right == NULL)
+    {
+        *link = node->left;
+    }
+    else
+    {
+        // Two children - the successor takes the node's place. The path continues
+        // down to the successor's parent, whose subtree loses a node
+        last = path->length;
+        Map_Node* successor_link = &(node->right);
+        bool is_owned = mapNodeOwnLink(map, successor_link);
+        while (is_owned && (*successor_link)->left != NULL)
+        {
+            path->links[++last] = successor_link;
+            successor_link = &((*successor_link)->left);
+            is_owned = mapNodeOwnLink(map, successor_link);
+        }
+        assert(is_owned);
+
+        Map_Node successor = *successor_link;
+        *successor_link   = successor->right;
+        successor->left   = node->left;
+        successor->right  = node->right;
+        successor->height = node->height;
+        *link = successor;
+        if (last > path->length)
+        {
+            path->links[path->length + 1] = &(successor->right);
+        }
+    }
+
+    mapTreeRebalance(map, path, last);
+    mapTreeUpdateEnds(map);
+}
+
+
+// Unlinks the node found by mapLocateForChange from the map. The node itself is not freed.
+static void mapUnlinkNode(Map map, MapLocation* location)
+{
+    (map->size)--;
+
+    if (mapIsHashed(map))
+    {
+        mapHashEmptySlot(map, location->slot);
+        mapHashInvalidateSnapshot(map);
+        return;
+    }
+
+    mapTreeUnlinkNode(map, location);
+}
+
+
+// Inserts a node holding a copy of a missing key and the given data itself (without
+// copying it) at a location. Returns the new node, NULL if an allocation failed -
+// the data is then still owned by the caller
+static Map_Node mapAdoptAtLocation(Map map, MapKeyElement keyElement, MapDataElement dataElement,
+                                   MapLocation* location)
+{
+    if (!mapPrepareInsert(map, keyElement, location))
+    {
+        return NULL;
+    }
+
+    Map_Node new_node = mapNodeAllocate(map, keyElement, dataElement);
+    if (new_node == NULL)
+    {
+        return NULL;
+    }
+
+    mapLinkNode(map, location, new_node);
+    return new_node;
+}
+
+
+// Inserts a node created for a missing key at a location
+// Returns the new node, NULL if an allocation failed
+static Map_Node mapInsertAtLocation(Map map, MapKeyElement keyElement, MapDataElement dataElement,
+                                    MapLocation* location)
+{
+    if (!mapPrepareInsert(map, keyElement, location))
+    {
+        return NULL;
+    }
+
+    Map_Node new_node = mapNodeCreate(map, keyElement, dataElement);
+    if (new_node == NULL)
+    {
+        return NULL;
+    }
+
+    mapLinkNode(map, location, new_node);
+    return new_node;
+}
+
+
+Map mapCreate(copyMapDataElements copyDataElement,
+              copyMapKeyElements copyKeyElement,
+              freeMapDataElements freeDataElement,
+              freeMapKeyElements freeKeyElement,
+              compareMapKeyElements compareKeyElements)
+
+{
+    return mapCreateBackend(copyDataElement, copyKeyElement, freeDataElement,
+                            freeKeyElement, compareKeyElements, NULL, 0);
+}
+
+
+Map mapCreateHashed(copyMapDataElements copyDataElement,
+                    copyMapKeyElements copyKeyElement,
+                    freeMapDataElements freeDataElement,
+                    freeMapKeyElements freeKeyElement,
+                    compareMapKeyElements compareKeyElements,
+                    hashMapKeyElements hashKeyElement)
+{
+    if (hashKeyElement == NULL)
+    {
+        return NULL;
+    }
+
+    return mapCreateBackend(copyDataElement, copyKeyElement, freeDataElement,
+                            freeKeyElement, compareKeyElements, hashKeyElement,
+                            MAP_HASH_INITIAL_CAPACITY);
+}
+
+
+
+Map mapCreateIntKeyed(copyMapDataElements copyDataElement,
+                      freeMapDataElements freeDataElement)
+{
+    Map new_map = mapCreateBackend(copyDataElement, mapIntKeyCopy, freeDataElement,
+                                   mapIntKeyFree, mapIntKeyCompare, NULL, 0);
+    if (new_map != NULL)
+    {
+        new_map->int_keys = true;
+    }
+    return new_map;
+}
+
+
+Map mapCreateIntKeyedHashed(copyMapDataElements copyDataElement,
+                            freeMapDataElements freeDataElement)
+{
+    Map new_map = mapCreateBackend(copyDataElement, mapIntKeyCopy, freeDataElement,
+                                   mapIntKeyFree, mapIntKeyCompare, mapIntKeyHash,
+                                   MAP_HASH_INITIAL_CAPACITY);
+    if (new_map != NULL)
+    {
+        new_map->int_keys = true;
+    }
+    return new_map;
+}
+
+
+
+
+void mapDestroy(Map map)
+{
+    if (map == NULL)
+    {
+        return;
+    }
+    // Other maps still use the pool - only the nodes no other map links to are released
+    if (map->pool->map_count > 1)
+    {
+        if (mapIsHashed(map))
+        {
+            mapHashDrop(map);
+        }
+        else
+        {
+            mapTreeDrop(map, map->root);
+        }
+        (map->pool->map_count)--;
+        free(map->sorted_nodes);
+        free(map);
+        return;
+    }
+
+    mapDestroyAllNodes(map);
+    free(map->pool);
+    free(map->slots);
+    free(map);
+}
+
+
+Map mapCopy(Map map)
+{
+    if (map == NULL)
+    {
+        return NULL;
+    }
+
+    Map new_map = malloc(sizeof(*new_map));
+    if (new_map == NULL)
+    {
+        return NULL;
+    }
+
+    // The copy shares the pool and the nodes, only its iteration state is its own
+    *new_map = *map;
+    (map->pool->map_count)++;
+    map->owns_all_nodes     = false;
+    new_map->owns_all_nodes = false;
+    if (mapIsHashed(map))
+    {
+        (map->slots->map_count)++;
+    }
+    else if (map->root != NULL)
+    {
+        (map->root->share_count)++;
+    }
+    new_map->sorted_nodes      = NULL;
+    new_map->iterator.map      = new_map;
+    new_map->iterator.position = NULL;
+    map->iterator.position     = NULL;
+#ifdef MAP_STATS
+    memset(&(new_map->stats), 0, sizeof(new_map->stats));
+    new_map->stats.peak_size = new_map->size;
+#endif
+
+    return new_map;
+}
+
+
+int mapGetSize(Map map)
+{
+    if (map == NULL)
+    {
+        return -1;
+    }
+
+    // Size will be updated when adding/removing items from the map
+    return map->size;
+}
+
+
+bool mapContains(Map map, MapKeyElement element)
+{
+    // Invalid input, return false
+    if (map == NULL || element == NULL)
+    {
+        return false;
+    }
+
+    MapLocation location;
+    mapLocate(map, element, &location);
+    return location.node != NULL;
+}
+
+
+
+MapResult mapPut(Map map, MapKeyElement keyElement, MapDataElement dataElement)
+{
+    // Verify the input items aren't NULL
+    if (map == NULL || keyElement == NULL || dataElement == NULL)
+    {
+        return MAP_NULL_ARGUMENT;
+    }
+
+    map->iterator.position = NULL;
+
+    // Get the node with specified key / the place it should be linked at
+    MapLocation location;
+    if (!mapLocateForChange(map, keyElement, &location))
+    {
+        return MAP_OUT_OF_MEMORY;
+    }
+
+    // If the key exists, update the data
+    if (location.node != NULL)
+    {
+        MAP_STATS_ADD(map, copy_calls, 1);
+        MapDataElement new_data = map->copy_data_func(dataElement);
+        if (new_data == NULL)
+        {
+            return MAP_OUT_OF_MEMORY;
+        }
+        if (!mapNodeReplaceData(map, location.node, new_data))
+        {
+            MAP_STATS_ADD(map, free_calls, 1);
+            map->free_data_func(new_data);
+            return MAP_OUT_OF_MEMORY;
+        }
+        return MAP_SUCCESS;
+    }
+
+    // Otherwise, create a new node where the search ended
+    if (mapInsertAtLocation(map, keyElement, dataElement, &location) == NULL)
+    {
+        return MAP_OUT_OF_MEMORY;
+    }
+    return MAP_SUCCESS;
+
+}
+
+
+MapResult mapPutMove(Map map, MapKeyElement keyElement, MapDataElement dataElement)
+{
+    // Verify the input items aren't NULL
+    if (map == NULL || keyElement == NULL || dataElement == NULL)
+    {
+        return MAP_NULL_ARGUMENT;
+    }
+
+    map->iterator.position = NULL;
+
+    MapLocation location;
+    if (!mapLocateForChange(map, keyElement, &location))
+    {
+        return MAP_OUT_OF_MEMORY;
+    }
+
+    // If the key exists, the given data replaces the old one
+    if (location.node != NULL)
+    {
+        if (location.node->data != dataElement &&
+            !mapNodeReplaceData(map, location.node, dataElement))
+        {
+            return MAP_OUT_OF_MEMORY;
+        }
+        return MAP_SUCCESS;
+    }
+
+    if (mapAdoptAtLocation(map, keyElement, dataElement, &location) == NULL)
+    {
+        return MAP_OUT_OF_MEMORY;
+    }
+    return MAP_SUCCESS;
+}
+
+
+// Fills an empty map with sorted pairs - copies of the data, or the data itself if adopt
+// is set. On failure the map is left empty, and adopted data still belongs to the caller
+static MapResult mapBuildFromSortedPairs(Map map, MapKeyElement *keyElements,
+                                         MapDataElement *dataElements, int count, bool adopt)
+{
+    if (map == NULL || (count > 0 && (keyElements == NULL || dataElements == NULL)))
+    {
+        return MAP_NULL_ARGUMENT;
+    }
+    if (count < 0 || map->size > 0)
+    {
+        return MAP_ERROR;
+    }
+
+    // Verify the input before anything is allocated
+    for (int i = 0 ; i < count ; i++)
+    {
+        if (keyElements[i] == NULL || dataElements[i] == NULL)
+        {
+            return MAP_NULL_ARGUMENT;
+        }
+        MAP_STATS_ADD(map, comparisons, i > 0 ? 1 : 0);
+        if (i > 0 && map->compare_key_func(keyElements[i - 1], keyElements[i]) >= 0)
+        {
+            return MAP_ERROR;
+        }
+    }
+
+    if (count == 0)
+    {
+        return MAP_SUCCESS;
+    }
+
+    // An empty map sharing its pool builds its nodes in a pool of its own
+    if (map->pool->map_count > 1 && !mapLeavePool(map))
+    {
+        return MAP_OUT_OF_MEMORY;
+    }
+    map->iterator.position = NULL;
+
+    // Hashed maps have no order to exploit - the keys are known to be new, so
+    // each is linked right where its probe ends
+    if (mapIsHashed(map))
+    {
+        for (int i = 0 ; i < count ; i++)
+        {
+            MapLocation location;
+            mapLocate(map, keyElements[i], &location);
+            Map_Node node = adopt ?
+                    mapAdoptAtLocation(map, keyElements[i], dataElements[i], &location) :
+                    mapInsertAtLocation(map, keyElements[i], dataElements[i], &location);
+            if (node == NULL)
+            {
+                adopt ? mapDestroyAllNodesKeepData(map) : mapDestroyAllNodes(map);
+                return MAP_OUT_OF_MEMORY;
+            }
+        }
+        return MAP_SUCCESS;
+    }
+
+    Map_Node root = mapNodeSubtreeBuild(map, keyElements, dataElements, 0, count, adopt);
+    if (root == NULL)
+    {
+        adopt ? mapDestroyAllNodesKeepData(map) : mapDestroyAllNodes(map);
+        return MAP_OUT_OF_MEMORY;
+    }
+
+    map->root       = root;
+    map->first_node = mapNodeMinimum(root);
+    map->last_node  = mapNodeMaximum(root);
+    map->size       = count;
+    MAP_STATS_UPDATE_PEAK(map);
+    return MAP_SUCCESS;
+}
+
+
+MapResult mapBuildFromSorted(Map map, MapKeyElement *keyElements, MapDataElement *dataElements,
+                             int count)
+{
+    return mapBuildFromSortedPairs(map, keyElements, dataElements, count, false);
+}
+
+
+MapResult mapBuildFromSortedMove(Map map, MapKeyElement *keyElements,
+                                 MapDataElement *dataElements, int count)
+{
+    return mapBuildFromSortedPairs(map, keyElements, dataElements, count, true);
+}
+
+
+MapDataElement mapGetOrInsert(Map map, MapKeyElement keyElement, MapDataElement dataElement,
+                              bool *inserted)
+{
+    if (inserted != NULL)
+    {
+        *inserted = false;
+    }
+
+    // Verify the input items aren't NULL
+    if (map == NULL || keyElement == NULL || dataElement == NULL)
+    {
+        return NULL;
+    }
+
+    // The data returned may be changed by the caller
+    MapLocation location;
+    if (!mapLocateForChange(map, keyElement, &location))
+    {
+        return NULL;
+    }
+    if (location.node != NULL)
+    {
+        return mapNodeOwnElements(map, location.node) ? location.node->data : NULL;
+    }
+
+    map->iterator.position = NULL;
+    Map_Node new_node = mapInsertAtLocation(map, keyElement, dataElement, &location);
+    if (new_node == NULL)
+    {
+        return NULL;
+    }
+
+    if (inserted != NULL)
+    {
+        *inserted = true;
+    }
+    return new_node->data;
+}
+
+
+MapDataElement mapGetOrCreate(Map map, MapKeyElement keyElement,
+                              createMapDataElement createDataElement, bool *inserted)
+{
+    if (inserted != NULL)
+    {
+        *inserted = false;
+    }
+
+    // Verify the input items aren't NULL
+    if (map == NULL || keyElement == NULL || createDataElement == NULL)
+    {
+        return NULL;
+    }
+
+    // The data returned may be changed by the caller
+    MapLocation location;
+    if (!mapLocateForChange(map, keyElement, &location))
+    {
+        return NULL;
+    }
+    if (location.node != NULL)
+    {
+        return mapNodeOwnElements(map, location.node) ? location.node->data : NULL;
+    }
+
+    map->iterator.position = NULL;
+
+    // Created data belongs to the map, so it is linked in without being copied
+    MapDataElement new_data = createDataElement(keyElement);
+    if (new_data == NULL)
+    {
+        return NULL;
+    }
+
+    Map_Node new_node = mapAdoptAtLocation(map, keyElement, new_data, &location);
+    if (new_node == NULL)
+    {
+        MAP_STATS_ADD(map, free_calls, 1);
+        map->free_data_func(new_data);
+        return NULL;
+    }
+
+    if (inserted != NULL)
+    {
+        *inserted = true;
+    }
+    return new_node->data;
+}
+
+
+MapDataElement mapGet(Map map, MapKeyElement keyElement)
+{
+    // Verify input
+    if (map == NULL || keyElement == NULL)
+    {
+        return NULL;
+    }
+
+    // The data returned may be changed by the caller
+    Map_Node node = NULL;
+    if (!mapFindForChange(map, keyElement, &node) || node == NULL)
+    {
+        return NULL;
+    }
+    return node->data;
+}
+
+
+const void* mapGetReadOnly(Map map, MapKeyElement keyElement)
+{
+    // Verify input
+    if (map == NULL || keyElement == NULL)
+    {
+        return NULL;
+    }
+
+    // The data isn't changed, so a map sharing its elements keeps sharing them
+    MapLocation location;
+    mapLocate(map, keyElement, &location);
+    if (location.node == NULL)
+    {
+        return NULL;
+    }
+
+    return location.node->data;
+}
+
+
+// Looks up a batch of keys of a hashed map. The home slots of all the keys are
+// prefetched first, then the nodes in them, and only then the keys are probed for
+static void mapHashGetBatch(Map map, MapKeyElement* keys, int count, MapDataElement* data)
+{
+    unsigned int hashes[MAP_GET_MANY_BATCH];
+    for (int i = 0 ; i < count ; i++)
+    {
+        if (keys[i] != NULL)
+        {
+            hashes[i] = map->int_keys ? mapIntKeyHash(keys[i]) : map->hash_key_func(keys[i]);
+            MAP_PREFETCH(&(map->slots->nodes[mapHashHomeSlot(map, hashes[i])]));
+        }
+    }
+
+    for (int i = 0 ; i < count ; i++)
+    {
+        if (keys[i] != NULL)
+        {
+            MAP_PREFETCH(map->slots->nodes[mapHashHomeSlot(map, hashes[i])]);
+        }
+    }
+
+    for (int i = 0 ; i < count ; i++)
+    {
+        data[i] = NULL;
+        if (keys[i] == NULL)
+        {
+            continue;
+        }
+        MAP_STATS_ADD(map, lookups, 1);
+        Map_Node node = map->slots->nodes[mapHashFindSlot(map, keys[i], hashes[i])];
+        data[i] = node == NULL ? NULL : node->data;
+    }
+}
+
+
+// Looks up a batch of keys of a tree map in ascending key order. Consecutive searches
+// walk the same top of the tree, and a key held by the node the cursor of the previous
+// key is on, or by the next one (e.g. sequential ids), is reached without searching
+static void mapTreeGetBatch(Map map, MapKeyElement* keys, int count, MapDataElement* data)
+{
+    // Insertion sort of the (non NULL) keys' indices, the batch is small
+    int order[MAP_GET_MANY_BATCH];
+    int sorted = 0;
+    for (int i = 0 ; i < count ; i++)
+    {
+        data[i] = NULL;
+        if (keys[i] == NULL)
+        {
+            continue;
+        }
+        int position = sorted++;
+        while (position > 0 && mapKeyCompare(map, keys[i], keys[order[position - 1]]) < 0)
+        {
+            order[position] = order[position - 1];
+            position--;
+        }
+        order[position] = i;
+    }
+
+    MapCursor cursor;
+    cursor.position = NULL;
+    for (int i = 0 ; i < sorted ; i++)
+    {
+        MapKeyElement key = keys[order[i]];
+        Map_Node node     = cursor.position;
+        if (node != NULL && mapNodeCompare(map, key, node) == 0)
+        {
+            data[order[i]] = node->data;
+            continue;
+        }
+
+        Map_Node next = node == NULL ? NULL : mapTreeCursorPeek(&cursor);
+        if (next != NULL && mapNodeCompare(map, key, next) == 0)
+        {
+            mapTreeCursorPushLeftEdge(&cursor, node->right);
+            mapTreeCursorPop(&cursor);
+        }
+        else
+        {
+            mapTreeSeek(map, key, false, &cursor);
+            next = cursor.position;
+            if (next == NULL || mapNodeCompare(map, key, next) != 0)
+            {
+                continue;
+            }
+        }
+        data[order[i]] = next->data;
+    }
+}
+
+
+MapResult mapGetMany(Map map, MapKeyElement *keyElements, int count,
+                     MapDataElement *dataElements)
+{
+    if (map == NULL || keyElements == NULL || dataElements == NULL)
+    {
+        return MAP_NULL_ARGUMENT;
+    }
+    if (count < 0)
+    {
+        return MAP_ERROR;
+    }
+
+    // The data returned may be changed by the caller. A shared map copies only the nodes
+    // of the keys found (and for trees, the paths to them), so they're looked up one by one
+    if (map->pool->map_count > 1)
+    {
+        for (int i = 0 ; i < count ; i++)
+        {
+            Map_Node node = NULL;
+            if (keyElements[i] != NULL && !mapFindForChange(map, keyElements[i], &node))
+            {
+                return MAP_OUT_OF_MEMORY;
+            }
+            dataElements[i] = node == NULL ? NULL : node->data;
+        }
+        return MAP_SUCCESS;
+    }
+
+    for (int first = 0 ; first < count ; first += MAP_GET_MANY_BATCH)
+    {
+        int batch_size = count - first < MAP_GET_MANY_BATCH ? count - first : MAP_GET_MANY_BATCH;
+        if (mapIsHashed(map))
+        {
+            mapHashGetBatch(map, keyElements + first, batch_size, dataElements + first);
+        }
+        else
+        {
+            mapTreeGetBatch(map, keyElements + first, batch_size, dataElements + first);
+        }
+    }
+    return MAP_SUCCESS;
+}
+
+
+MapResult mapRemove(Map map, MapKeyElement keyElement)
+{
+    // Verify input
+    if (map == NULL || keyElement == NULL)
+    {
+        return MAP_NULL_ARGUMENT;
+    }
+
+    // A missing key of a shared map is found without copying anything
+    MapLocation location;
+    if (map->pool->map_count > 1)
+    {
+        mapLocate(map, keyElement, &location);
+        if (location.node == NULL)
+        {
+            return MAP_ITEM_DOES_NOT_EXIST;
+        }
+    }
+
+    map->iterator.position = NULL;
+    if (!mapLocateForChange(map, keyElement, &location))
+    {
+        return MAP_OUT_OF_MEMORY;
+    }
+
+    // Item not found
+    if (location.node == NULL)
+    {
+        return MAP_ITEM_DOES_NOT_EXIST;
+    }
+
+    mapUnlinkNode(map, &location);
+    mapNodeRelease(map, location.node);
+    return MAP_SUCCESS;
+}
+
+
+MapKeyElement mapGetFirst(Map map)
+{
+    // Verify input
+    if (map == NULL || map->size == 0)
+    {
+        return NULL;
+    }
+
+    // The internal iterator only reads the map, so a shared map isn't copied
+    if (!mapCursorBeginReadOnly(map, &(map->iterator)))
+    {
+        return NULL;
+    }
+    MAP_STATS_ADD(map, copy_calls, 1);
+    return map->copy_key_func(mapCursorKey(&(map->iterator)));
+}
+
+
+MapKeyElement mapGetNext(Map map)
+{
+    // Verify input
+    if (map == NULL || map->iterator.position == NULL)
+    {
+        return NULL;
+    }
+
+    if (!mapCursorNext(&(map->iterator)))
+    {
+        return NULL;
+    }
+    MAP_STATS_ADD(map, copy_calls, 1);
+    return map->copy_key_func(mapCursorKey(&(map->iterator)));
+}
+
+
+MapResult mapClear(Map map)
+{
+    if (map == NULL)
+    {
+        return MAP_NULL_ARGUMENT;
+    }
+
+    // A map sharing its nodes just leaves them to the other maps
+    if (map->pool->map_count > 1)
+    {
+        return mapLeavePool(map) ? MAP_SUCCESS : MAP_OUT_OF_MEMORY;
+    }
+
+    mapDestroyAllNodes(map);
+    return MAP_SUCCESS;
+}
+
+
+// Returns the first node whose key is greater than the given key, NULL if there is none
+static Map_Node mapTreeUpperBound(Map map, MapKeyElement key)
+{
+    MAP_STATS_ADD(map, lookups, 1);
+    Map_Node bound = NULL;
+    Map_Node node  = map->root;
+    while (node != NULL)
+    {
+        MAP_STATS_ADD(map, nodes_traversed, 1);
+        if (mapNodeCompare(map, key, node) < 0)
+        {
+            bound = node;
+            node  = node->left;
+        }
+        else
+        {
+            node = node->right;
+        }
+    }
+    return bound;
+}
+
+
+// Sets a cursor to the first key not smaller than low_key (greater than it, if strict).
+// If high_key isn't NULL, the cursor stops after the last key not greater than it.
+// Cursors that may change the data they reach give the map elements of its own first
+static bool mapCursorSeek(Map map, MapKeyElement low_key, bool strict, MapKeyElement high_key,
+                          MapCursor *cursor, bool is_read_only)
+{
+    cursor->map      = map;
+    cursor->position = NULL;
+    cursor->index    = 0;
+    cursor->end      = NULL;
+    cursor->depth    = 0;
+    if (map->size == 0)
+    {
+        return false;
+    }
+
+    if (!is_read_only && !mapOwnAll(map))
+    {
+        return false;
+    }
+
+    if (mapIsHashed(map))
+    {
+        if (!mapHashBuildSnapshot(map))
+        {
+            return false;
+        }
+        int first = mapSnapshotBound(map, low_key, strict);
+        int end   = high_key == NULL ? map->size : mapSnapshotBound(map, high_key, true);
+        if (first >= end)
+        {
+            return false;
+        }
+        cursor->index    = first;
+        cursor->position = map->sorted_nodes[first];
+        cursor->end      = end < map->size ? map->sorted_nodes[end] : NULL;
+        return true;
+    }
+
+    mapTreeSeek(map, low_key, strict, cursor);
+    if (cursor->position == NULL ||
+        (high_key != NULL && mapNodeCompare(map, high_key, cursor->position) < 0))
+    {
+        cursor->position = NULL;
+        return false;
+    }
+    cursor->end = high_key == NULL ? NULL : mapTreeUpperBound(map, high_key);
+    return true;
+}
+
+
+// Sets a cursor to the first node of a map. Cursors that may change the data they reach
+// give the map elements of its own first
+static bool mapCursorStart(Map map, MapCursor *cursor, bool is_read_only)
+{
+    if (cursor == NULL)
+    {
+        return false;
+    }
+
+    cursor->map      = map;
+    cursor->position = NULL;
+    cursor->index    = 0;
+    cursor->end      = NULL;
+    cursor->depth    = 0;
+    if (map == NULL || map->size == 0)
+    {
+        return false;
+    }
+
+    if (!is_read_only && !mapOwnAll(map))
+    {
+        return false;
+    }
+
+    // Hashed maps iterate over an ordered snapshot of their nodes
+    if (mapIsHashed(map))
+    {
+        if (!mapHashBuildSnapshot(map))
+        {
+            return false;
+        }
+        cursor->position = map->sorted_nodes[0];
+        return true;
+    }
+
+    mapTreeCursorPushLeftEdge(cursor, map->root);
+    mapTreeCursorPop(cursor);
+    return true;
+}
+
+
+bool mapCursorBegin(Map map, MapCursor *cursor)
+{
+    return mapCursorStart(map, cursor, false);
+}
+
+
+bool mapCursorBeginReadOnly(Map map, MapCursor *cursor)
+{
+    return mapCursorStart(map, cursor, true);
+}
+
+
+bool mapCursorLowerBound(Map map, MapKeyElement keyElement, MapCursor *cursor)
+{
+    if (map == NULL || keyElement == NULL || cursor == NULL)
+    {
+        return false;
+    }
+    return mapCursorSeek(map, keyElement, false, NULL, cursor, false);
+}
+
+
+bool mapCursorLowerBoundReadOnly(Map map, MapKeyElement keyElement, MapCursor *cursor)
+{
+    if (map == NULL || keyElement == NULL || cursor == NULL)
+    {
+        return false;
+    }
+    return mapCursorSeek(map, keyElement, false, NULL, cursor, true);
+}
+
+
+bool mapCursorUpperBound(Map map, MapKeyElement keyElement, MapCursor *cursor)
+{
+    if (map == NULL || keyElement == NULL || cursor == NULL)
+    {
+        return false;
+    }
+    return mapCursorSeek(map, keyElement, true, NULL, cursor, false);
+}
+
+
+bool mapCursorUpperBoundReadOnly(Map map, MapKeyElement keyElement, MapCursor *cursor)
+{
+    if (map == NULL || keyElement == NULL || cursor == NULL)
+    {
+        return false;
+    }
+    return mapCursorSeek(map, keyElement, true, NULL, cursor, true);
+}
+
+
+bool mapCursorRange(Map map, MapKeyElement lowKeyElement, MapKeyElement highKeyElement,
+                    MapCursor *cursor)
+{
+    if (map == NULL || lowKeyElement == NULL || highKeyElement == NULL || cursor == NULL)
+    {
+        return false;
+    }
+    return mapCursorSeek(map, lowKeyElement, false, highKeyElement, cursor, false);
+}
+
+
+bool mapCursorRangeReadOnly(Map map, MapKeyElement lowKeyElement, MapKeyElement highKeyElement,
+                            MapCursor *cursor)
+{
+    if (map == NULL || lowKeyElement == NULL || highKeyElement == NULL || cursor == NULL)
+    {
+        return false;
+    }
+    return mapCursorSeek(map, lowKeyElement, false, highKeyElement, cursor, true);
+}
+
+
+bool mapCursorNext(MapCursor *cursor)
+{
+    if (cursor == NULL || cursor->position == NULL)
+    {
+        return false;
+    }
+
+    Map map = cursor->map;
+    if (mapIsHashed(map))
+    {
+        (cursor->index)++;
+        cursor->position = cursor->index < map->size ? map->sorted_nodes[cursor->index] : NULL;
+
+        // The snapshot is an array - fetch the node a few steps ahead while this one is used
+        if (cursor->index + MAP_PREFETCH_DISTANCE < map->size)
+        {
+            MAP_PREFETCH(map->sorted_nodes[cursor->index + MAP_PREFETCH_DISTANCE]);
+        }
+    }
+    else
+    {
+        // The right subtree comes next, then the nodes on the stack
+        mapTreeCursorPushLeftEdge(cursor, ((Map_Node)cursor->position)->right);
+        mapTreeCursorPop(cursor);
+    }
+
+    // Range cursors stop at the first node past the range
+    if (cursor->position == cursor->end)
+    {
+        cursor->position = NULL;
+    }
+    return cursor->position != NULL;
+}
+
+
+MapKeyElement mapCursorKey(MapCursor *cursor)
+{
+    if (cursor == NULL || cursor->position == NULL)
+    {
+        return NULL;
+    }
+    return ((Map_Node)cursor->position)->key;
+}
+
+
+MapDataElement mapCursorData(MapCursor *cursor)
+{
+    if (cursor == NULL || cursor->position == NULL)
+    {
+        return NULL;
+    }
+    return ((Map_Node)cursor->position)->data;
+}
+
+
+// Calls a function for every element of a map, through a cursor of the given kind
+static MapResult mapVisitAll(Map map, visitMapElement visitElement, void *context,
+                             bool is_read_only)
+{
+    if (map == NULL || visitElement == NULL)
+    {
+        return MAP_NULL_ARGUMENT;
+    }
+
+    MapCursor cursor;
+    if (!mapCursorStart(map, &cursor, is_read_only))
+    {
+        return map->size == 0 ? MAP_SUCCESS : MAP_OUT_OF_MEMORY;
+    }
+
+    do
+    {
+        Map_Node node = cursor.position;
+        if (!visitElement(node->key, node->data, context))
+        {
+            break;
+        }
+    } while (mapCursorNext(&cursor));
+
+    return MAP_SUCCESS;
+}
+
+
+MapResult mapForEach(Map map, visitMapElement visitElement, void *context)
+{
+    return mapVisitAll(map, visitElement, context, false);
+}
+
+
+MapResult mapForEachReadOnly(Map map, visitMapElement visitElement, void *context)
+{
+    return mapVisitAll(map, visitElement, context, true);
+}
+
+
+
+MapResult mapGetStats(Map map, MapStats *stats)
+{
+    if (map == NULL || stats == NULL)
+    {
+        return MAP_NULL_ARGUMENT;
+    }
+#ifdef MAP_STATS
+    *stats = map->stats;
+    return MAP_SUCCESS;
+#else
+    return MAP_ERROR;
+#endif
+}
+
+
+MapResult mapResetStats(Map map)
+{
+    if (map == NULL)
+    {
+        return MAP_NULL_ARGUMENT;
+    }
+#ifdef MAP_STATS
+    memset(&(map->stats), 0, sizeof(map->stats));
+    map->stats.peak_size = map->size;
+    return MAP_SUCCESS;
+#else
+    return MAP_ERROR;
+#endif
+}
@@ -7,22 +7,63 @@
 * Generic Map Container
 *
 * Implements a map container type.
+* The map is kept as a balanced (AVL) binary search tree ordered by the key
+* compare function, so mapPut, mapGet, mapContains and mapRemove take O(log n)
+* key comparisons, and iteration visits the keys in ascending order. Keys greater
+* than all the keys in the map (e.g. sequential ids) are located with
+* a single comparison.
 * The map has an internal iterator for external use. For all functions
 * where the state of the iterator after calling that function is not stated,
 * it is undefined. That is you cannot assume anything about it.
 *
+* A map can also be created as a hash map (mapCreateHashed), which keeps its
+* elements in an open addressing table for expected O(1) lookups. A hashed map
+* builds a sorted snapshot of its keys when an iteration starts (mapGetFirst),
+* so iteration still visits the keys in ascending order.
+*
+* The nodes of a map are taken from a pool owned by the map, which allocates them
+* in blocks. Removed nodes are reused by later insertions, and mapClear/mapDestroy
+* sweep the pool block by block instead of walking the tree recursively.
+*
+* Copying a map is copy on write - mapCopy takes constant time, and the copy shares
+* its nodes with the source. A tree map changing a key copies only the nodes on the
+* path from the root to that key (O(log n) nodes), and the copies borrow the elements
+* of the nodes they were made of - an element is copied only when data that may be
+* changed is handed out (mapGet, mapGetMany, mapGetOrInsert, mapGetOrCreate) while
+* another map still uses it. A hashed map copies its slot array (but no node) before
+* its first change, and then copies the nodes it changes the same way. Cursors (but
+* the ReadOnly ones) and mapForEach hand out all of the data, so on a shared map they
+* copy every element first - once, until the map is copied again. mapContains, the
+* internal iterator, mapGetReadOnly, the ReadOnly cursors and mapForEachReadOnly only
+* read the elements, so they never copy anything.
+*
 * The following functions are available:
 *   mapCreate		- Creates a new empty map
+*   mapCreateHashed	- Creates a new empty hash map
+*   mapCreateIntKeyed	- Creates a new empty map with int keys stored inline
+*   mapCreateIntKeyedHashed - Creates a new empty hash map with int keys stored inline
 *   mapDestroy		- Deletes an existing map and frees all resources
 *   mapCopy		- Copies an existing map
 *   mapGetSize		- Returns the size of a given map
 *   mapContains	- returns weather or not a key exists inside the map.
-*   				  This resets the internal iterator.
+*   				  Iterator status unchanged
 *   mapPut		    - Gives a specific key a given value.
 *   				  If the key exists, the value is overridden.
 *   				  This resets the internal iterator.
+*   mapPutMove	    - Like mapPut, but the map takes the given data element itself
+*   				  instead of a copy of it.
+*   mapBuildFromSorted - Fills an empty map with pairs given in ascending key order.
+*   mapBuildFromSortedMove - Like mapBuildFromSorted, but the map takes the data elements
+*                     themselves instead of copies of them.
 *   mapGet  	    - Returns the data paired to a key which matches the given key.
 *					  Iterator status unchanged
+*   mapGetReadOnly	- Like mapGet, but the data must not be changed, so a copied
+*   				  map keeps sharing its elements.
+*   mapGetMany		- Returns the data paired to each key of an array of keys.
+*   mapGetOrInsert	- Returns the data paired to a key, inserting a copy of a given
+*   				  data element first if the key doesn't exist.
+*   mapGetOrCreate	- Returns the data paired to a key, inserting a data element
+*   				  made by a given create function first if the key doesn't exist.
 *   mapRemove		- Removes a pair of (key,data) elements for which the key
 *                    matches a given element (by the key compare function).
 *   				  This resets the internal iterator.
@@ -32,6 +73,23 @@
 *   				  returns a copy it.
 *	 mapClear		- Clears the contents of the map. Frees all the elements of
 *	 				  the map using the free function.
+*   mapCursorBegin	- Sets an external cursor to the first (smallest) key in the map.
+*   mapCursorBeginReadOnly - Like mapCursorBegin, for a cursor that doesn't change the data.
+*   mapCursorLowerBound - Sets an external cursor to the first key not smaller than a given key.
+*   mapCursorLowerBoundReadOnly - Like mapCursorLowerBound, for a cursor that doesn't change
+*                     the data.
+*   mapCursorUpperBound - Sets an external cursor to the first key greater than a given key.
+*   mapCursorUpperBoundReadOnly - Like mapCursorUpperBound, for a cursor that doesn't change
+*                     the data.
+*   mapCursorRange	- Sets an external cursor to iterate over the keys in a given range.
+*   mapCursorRangeReadOnly - Like mapCursorRange, for a cursor that doesn't change the data.
+*   mapCursorNext	- Advances an external cursor to the next key.
+*   mapCursorKey	- Returns the key a cursor points to (not a copy).
+*   mapCursorData	- Returns the data a cursor points to (not a copy).
+*   mapForEach		- Calls a function for every (key, data) pair, in ascending key order.
+*   mapForEachReadOnly	- Like mapForEach, for a function that doesn't change the data.
+*   mapGetStats		- Returns the counters of the work done by the map (MAP_STATS builds).
+*   mapResetStats	- Zeroes the counters of the work done by the map (MAP_STATS builds).
 * 	 MAP_FOREACH	- A macro for iterating over the map's elements, iterator needs to be deallocated (freed)
 *                     each iteration.
 */
@@ -61,6 +119,50 @@ typedef MapDataElement(*copyMapDataElements)(MapDataElement);
 /** Type of function for copying a key element of the map */
 typedef MapKeyElement(*copyMapKeyElements)(MapKeyElement);
 
+/** The greatest height of a tree map - an AVL tree of 2^31 keys is at most 45 high */
+#define MAP_MAX_TREE_HEIGHT 48
+
+/**
+* Type of an external cursor over a map, used for iterating without allocating.
+* A cursor lends the map's own key and data elements (no copies are made), and any
+* number of cursors may iterate over a map at the same time. Cursors don't use the
+* internal iterator. A cursor becomes invalid once its map changes (a key is
+* inserted / removed, or data that may be changed is handed out by a map sharing its
+* elements). The fields are internal - use the mapCursor functions.
+*/
+typedef struct MapCursor_t {
+    Map map;
+    void *position;
+    int index;
+    void *end;
+    void *path[MAP_MAX_TREE_HEIGHT];    // Tree maps - the nodes to return to, deepest last
+    int depth;
+} MapCursor;
+
+/**
+* Counters of the work done by a map, for profiling. They are counted only when the
+* map is compiled with MAP_STATS defined (cmake -DMAP_STATS=ON), and cost nothing otherwise.
+*/
+typedef struct MapStats_t {
+    long comparisons;       // Key comparisons (through the compare function or directly)
+    long lookups;           // Searches for a key
+    long nodes_traversed;   // Nodes (hashed maps - slots) visited by the searches, and by
+                            // cursors making a shared tree the map's own
+    long copy_calls;        // Calls to the copy functions
+    long free_calls;        // Calls to the free functions
+    int peak_size;          // Greatest amount of elements held at once
+} MapStats;
+
+/**
+* Type of function called by mapForEach for every element of the map.
+* Gets the key and data elements (not copies) and the context given to mapForEach.
+* Should return true to continue the iteration, false to stop it.
+*/
+typedef bool(*visitMapElement)(MapKeyElement, MapDataElement, void*);
+
+/** Type of function for creating a new data element for a given key */
+typedef MapDataElement(*createMapDataElement)(MapKeyElement);
+
 /** Type of function for deallocating a data element of the map */
 typedef void(*freeMapDataElements)(MapDataElement);
 
@@ -77,6 +179,12 @@ typedef void(*freeMapKeyElements)(MapKeyElement);
 */
 typedef int(*compareMapKeyElements)(MapKeyElement, MapKeyElement);
 
+/**
+* Type of function used by hashed maps to hash key elements.
+* Key elements which are equal by the compare function must have the same hash.
+*/
+typedef unsigned int(*hashMapKeyElements)(MapKeyElement);
+
 /**
 * mapCreate: Allocates a new empty map.
 *
@@ -100,6 +208,66 @@ Map mapCreate(copyMapDataElements copyDataElement,
               freeMapKeyElements freeKeyElement,
               compareMapKeyElements compareKeyElements);
 
+/**
+* mapCreateHashed: Allocates a new empty hash map.
+* Behaves exactly like a map created by mapCreate, but lookups are done through a
+* hash table. Iteration starts by sorting a snapshot of the keys, which is kept
+* until the next insertion/removal of a key.
+*
+* @param copyDataElement - Function pointer to be used for copying data elements into
+*  	the map or when copying the map.
+* @param copyKeyElement - Function pointer to be used for copying key elements into
+*  	the map or when copying the map.
+* @param freeDataElement - Function pointer to be used for removing data elements from
+* 		the map
+* @param freeKeyElement - Function pointer to be used for removing key elements from
+* 		the map
+* @param compareKeyElements - Function pointer to be used for comparing key elements
+* 		inside the map. Used to check if new elements already exist in the map.
+* @param hashKeyElement - Function pointer to be used for hashing key elements
+* @return
+* 	NULL - if one of the parameters is NULL or allocations failed.
+* 	A new Map in case of success.
+*/
+Map mapCreateHashed(copyMapDataElements copyDataElement,
+                    copyMapKeyElements copyKeyElement,
+                    freeMapDataElements freeDataElement,
+                    freeMapKeyElements freeKeyElement,
+                    compareMapKeyElements compareKeyElements,
+                    hashMapKeyElements hashKeyElement);
+
+/**
+* mapCreateIntKeyed: Allocates a new empty map whose keys are ints (passed as int*).
+* The keys are stored inside the map's nodes and compared directly, so no key
+* element is allocated per entry. Keys returned by mapGetFirst/mapGetNext are still
+* allocated copies, to be freed with free().
+*
+* @param copyDataElement - Function pointer to be used for copying data elements into
+*  	the map or when copying the map.
+* @param freeDataElement - Function pointer to be used for removing data elements from
+* 		the map
+* @return
+* 	NULL - if one of the parameters is NULL or allocations failed.
+* 	A new Map in case of success.
+*/
+Map mapCreateIntKeyed(copyMapDataElements copyDataElement,
+                      freeMapDataElements freeDataElement);
+
+/**
+* mapCreateIntKeyedHashed: Allocates a new empty hash map whose keys are ints.
+* Combines mapCreateIntKeyed and mapCreateHashed - the int keys are hashed internally.
+*
+* @param copyDataElement - Function pointer to be used for copying data elements into
+*  	the map or when copying the map.
+* @param freeDataElement - Function pointer to be used for removing data elements from
+* 		the map
+* @return
+* 	NULL - if one of the parameters is NULL or allocations failed.
+* 	A new Map in case of success.
+*/
+Map mapCreateIntKeyedHashed(copyMapDataElements copyDataElement,
+                            freeMapDataElements freeDataElement);
+
 /**
 * mapDestroy: Deallocates an existing map. Clears all elements by using the
 * stored free functions.
@@ -111,6 +279,10 @@ void mapDestroy(Map map);
 
 /**
 * mapCopy: Creates a copy of target map.
+* The nodes are shared (not copied) until one of the maps changes - see above.
+* Takes constant time. A change of either map then copies the path to the changed key
+* in O(log n) (the first change of a hashed map copies its slot array, in O(n), but
+* no element).
 * Iterator values for both maps is undefined after this operation.
 *
 * @param map - Target map.
@@ -161,6 +333,62 @@ bool mapContains(Map map, MapKeyElement element);
 */
 MapResult mapPut(Map map, MapKeyElement keyElement, MapDataElement dataElement);
 
+/**
+*	mapPutMove: Gives a specified key a specific value, transferring the ownership of
+*  the value to the map. The data element is inserted as is, without being copied,
+*  and will be freed by the map using the free function given at initialization.
+*  If the key exists, its old data element is freed and replaced.
+*  Iterator's value is undefined after this operation.
+*
+* @param map - The map for which to reassign the data element
+* @param keyElement - The key element which need to be reassigned. A copy of it is inserted.
+* @param dataElement - The data element to move into the map. On MAP_SUCCESS the map
+*      owns it, otherwise it still belongs to the caller.
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as map or keyElement or dataElement
+* 	MAP_OUT_OF_MEMORY if an allocation failed
+* 	MAP_SUCCESS the paired elements had been inserted successfully
+*/
+MapResult mapPutMove(Map map, MapKeyElement keyElement, MapDataElement dataElement);
+
+/**
+*	mapBuildFromSorted: Fills an empty map with pairs of keys & data given in ascending
+*  key order. A map created by mapCreate is built directly as a balanced tree, in
+*  O(count) instead of O(count * log(count)) for inserting the pairs one by one.
+*  Copies of the elements are inserted, as in mapPut.
+*  Iterator's value is undefined after this operation.
+*
+* @param map - The (empty) map to fill
+* @param keyElements - Array of count keys, strictly ascending by the compare function
+* @param dataElements - Array of count data elements, dataElements[i] is paired to keyElements[i]
+* @param count - The amount of pairs
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as map, or as one of the arrays or their elements
+* 	MAP_ERROR if the map isn't empty, count is negative, or the keys aren't strictly ascending
+* 	MAP_OUT_OF_MEMORY if an allocation failed (the map is left empty)
+* 	MAP_SUCCESS the pairs had been inserted successfully
+*/
+MapResult mapBuildFromSorted(Map map, MapKeyElement *keyElements, MapDataElement *dataElements,
+                             int count);
+
+/**
+*	mapBuildFromSortedMove: Like mapBuildFromSorted, but the map takes the data elements
+*  themselves (as in mapPutMove) instead of copies of them, so no data is copied.
+*  On success the map owns the data elements. Otherwise they all still belong to the caller.
+*
+* @param map - The (empty) map to fill
+* @param keyElements - Array of count keys, strictly ascending by the compare function
+* @param dataElements - Array of count data elements to move into the map
+* @param count - The amount of pairs
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as map, or as one of the arrays or their elements
+* 	MAP_ERROR if the map isn't empty, count is negative, or the keys aren't strictly ascending
+* 	MAP_OUT_OF_MEMORY if an allocation failed (the map is left empty)
+* 	MAP_SUCCESS the pairs had been inserted successfully
+*/
+MapResult mapBuildFromSortedMove(Map map, MapKeyElement *keyElements,
+                                 MapDataElement *dataElements, int count);
+
 /**
 *	mapGet: Returns the data associated with a specific key in the map.
 *			Iterator status unchanged
@@ -170,10 +398,83 @@ MapResult mapPut(Map map, MapKeyElement keyElement, MapDataElement dataElement);
 we want to get.
 * @return
 *  NULL if a NULL pointer was sent or if the map does not contain the requested key.
+*  NULL if the map shares the element with a copy of it, and copying it failed.
 * 	The data element associated with the key otherwise.
 */
 MapDataElement mapGet(Map map, MapKeyElement keyElement);
 
+/**
+*	mapGetReadOnly: Returns the data associated with a specific key in the map, for
+*			reading only. Unlike mapGet, an element the map shares with a copy of it
+*			isn't copied, so this never allocates.
+*			Iterator status unchanged
+*
+* @param map - The map for which to get the data element from.
+* @param keyElement - The key element which need to be found and whos data
+we want to get.
+* @return
+*  NULL if a NULL pointer was sent or if the map does not contain the requested key.
+* 	The data element associated with the key otherwise. It must not be changed.
+*/
+const void* mapGetReadOnly(Map map, MapKeyElement keyElement);
+
+/**
+*	mapGetMany: Looks up an array of keys at once, returning the data associated with
+*  each of them. Hashed maps prefetch the slots and nodes of a batch of keys before
+*  probing for any of them, and tree maps search a batch of keys in ascending order,
+*  so the memory accesses of the lookups overlap instead of waiting for each other.
+*			Iterator status unchanged
+*
+* @param map - The map for which to get the data elements from.
+* @param keyElements - The keys to look up. May hold duplicates and NULL elements.
+* @param count - The amount of keys
+* @param dataElements - Filled with the data element associated with each key - NULL for
+*      NULL keys and keys the map does not contain.
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as map, or as one of the arrays
+* 	MAP_ERROR if count is negative
+* 	MAP_OUT_OF_MEMORY if the map shares the elements found with a copy of it, and
+* 	copying them failed
+* 	MAP_SUCCESS otherwise
+*/
+MapResult mapGetMany(Map map, MapKeyElement *keyElements, int count,
+                     MapDataElement *dataElements);
+
+/**
+*	mapGetOrInsert: Returns the data associated with a specific key in the map.
+*	If the key doesn't exist, a copy of the key and of dataElement are inserted first.
+*	The map is searched only once in both cases.
+*  Iterator's value is undefined after this operation if an element was inserted.
+*
+* @param map - The map to get the data element from / insert the element to.
+* @param keyElement - The key element to find.
+* @param dataElement - The data element to insert a copy of if the key is not found.
+* @param inserted - If not NULL, set to whether a new element was inserted.
+* @return
+*  NULL if a NULL pointer was sent or an allocation failed.
+* 	The data element associated with the key otherwise.
+*/
+MapDataElement mapGetOrInsert(Map map, MapKeyElement keyElement, MapDataElement dataElement,
+                              bool *inserted);
+
+/**
+*	mapGetOrCreate: Returns the data associated with a specific key in the map.
+*	If the key doesn't exist, createDataElement is called with the key and its result
+*	is inserted as is (it is not copied, the map frees it with the free function).
+*	The map is searched only once in both cases.
+*  Iterator's value is undefined after this operation if an element was inserted.
+*
+* @param map - The map to get the data element from / insert the element to.
+* @param keyElement - The key element to find.
+* @param createDataElement - Function creating the data element for a missing key.
+* @param inserted - If not NULL, set to whether a new element was inserted.
+* @return
+*  NULL if a NULL pointer was sent or an allocation failed.
+* 	The data element associated with the key otherwise.
+*/
+MapDataElement mapGetOrCreate(Map map, MapKeyElement keyElement,
+                              createMapDataElement createDataElement, bool *inserted);
+
 /**
 * 	mapRemove: Removes a pair of key and data elements from the map. The elements
 *  are found using the comparison function given at initialization. Once found,
@@ -233,6 +534,217 @@ MapKeyElement mapGetNext(Map map);
 */
 MapResult mapClear(Map map);
 
+/**
+*	mapCursorBegin: Sets a cursor to the smallest key element of the map.
+*	The cursor hands out data that may be changed, so a map that shares its elements
+*	with a copy of it copies them all first. Use mapCursorNext to continue the iteration.
+*
+* @param map - The map to iterate over.
+* @param cursor - The cursor to set.
+* @return
+* 	false if a NULL pointer was sent, the map is empty or an allocation failed
+* 	(hashed maps sort a snapshot of their keys if they changed since the last iteration)
+* 	true if the cursor points to the first element of the map
+*/
+bool mapCursorBegin(Map map, MapCursor *cursor);
+
+/**
+*	mapCursorBeginReadOnly: Like mapCursorBegin, for a cursor whose data is only read.
+*	A map that shares its elements with a copy of it keeps sharing them (mapCursorBegin
+*	copies them all first), so the data reached through the cursor must not be changed.
+*
+* @param map - The map to iterate over.
+* @param cursor - The cursor to set.
+* @return
+* 	false if a NULL pointer was sent, the map is empty or an allocation failed
+* 	(hashed maps sort a snapshot of their keys if they changed since the last iteration)
+* 	true if the cursor points to the first element of the map
+*/
+bool mapCursorBeginReadOnly(Map map, MapCursor *cursor);
+
+/**
+*	mapCursorLowerBound: Sets a cursor to the smallest key element of the map which
+*	is not smaller than a given key (by the key compare function). Use mapCursorNext
+*	to continue the iteration up to the end of the map.
+*	Takes O(log n) key comparisons (hashed maps search their sorted snapshot). The
+*	cursor hands out data that may be changed, so a map that shares its elements with
+*	a copy of it copies them all first.
+*
+* @param map - The map to search.
+* @param keyElement - The key to search for. Doesn't have to be in the map.
+* @param cursor - The cursor to set.
+* @return
+* 	false if a NULL pointer was sent, no key in the map is big enough, or an
+* 	allocation failed
+* 	true if the cursor points to the element found
+*/
+bool mapCursorLowerBound(Map map, MapKeyElement keyElement, MapCursor *cursor);
+
+/**
+*	mapCursorLowerBoundReadOnly: Like mapCursorLowerBound, for a cursor whose data is
+*	only read. A map that shares its elements with a copy of it keeps sharing them, so
+*	the seek takes O(log n) even on a copied map, and the data reached through the
+*	cursor must not be changed.
+*
+* @param map - The map to search.
+* @param keyElement - The key to search for. Doesn't have to be in the map.
+* @param cursor - The cursor to set.
+* @return
+* 	false if a NULL pointer was sent, no key in the map is big enough, or an
+* 	allocation failed
+* 	true if the cursor points to the element found
+*/
+bool mapCursorLowerBoundReadOnly(Map map, MapKeyElement keyElement, MapCursor *cursor);
+
+/**
+*	mapCursorUpperBound: Like mapCursorLowerBound, but finds the smallest key element
+*	which is greater than the given key.
+*
+* @param map - The map to search.
+* @param keyElement - The key to search for. Doesn't have to be in the map.
+* @param cursor - The cursor to set.
+* @return
+* 	false if a NULL pointer was sent, no key in the map is greater, or an
+* 	allocation failed
+* 	true if the cursor points to the element found
+*/
+bool mapCursorUpperBound(Map map, MapKeyElement keyElement, MapCursor *cursor);
+
+/**
+*	mapCursorUpperBoundReadOnly: Like mapCursorUpperBound, for a cursor whose data is
+*	only read (see mapCursorLowerBoundReadOnly).
+*
+* @param map - The map to search.
+* @param keyElement - The key to search for. Doesn't have to be in the map.
+* @param cursor - The cursor to set.
+* @return
+* 	false if a NULL pointer was sent, no key in the map is greater, or an
+* 	allocation failed
+* 	true if the cursor points to the element found
+*/
+bool mapCursorUpperBoundReadOnly(Map map, MapKeyElement keyElement, MapCursor *cursor);
+
+/**
+*	mapCursorRange: Sets a cursor to iterate over the key elements between two keys
+*	(both included), in ascending order. mapCursorNext stops after the last key in
+*	the range, so visiting k keys takes O(log n + k).
+*
+* @param map - The map to iterate over.
+* @param lowKeyElement - The smallest key of the range. Doesn't have to be in the map.
+* @param highKeyElement - The greatest key of the range. Doesn't have to be in the map.
+* @param cursor - The cursor to set.
+* @return
+* 	false if a NULL pointer was sent, the range holds no key of the map, or an
+* 	allocation failed
+* 	true if the cursor points to the first element in the range
+*/
+bool mapCursorRange(Map map, MapKeyElement lowKeyElement, MapKeyElement highKeyElement,
+                    MapCursor *cursor);
+
+/**
+*	mapCursorRangeReadOnly: Like mapCursorRange, for a cursor whose data is only read
+*	(see mapCursorLowerBoundReadOnly).
+*
+* @param map - The map to iterate over.
+* @param lowKeyElement - The smallest key of the range. Doesn't have to be in the map.
+* @param highKeyElement - The greatest key of the range. Doesn't have to be in the map.
+* @param cursor - The cursor to set.
+* @return
+* 	false if a NULL pointer was sent, the range holds no key of the map, or an
+* 	allocation failed
+* 	true if the cursor points to the first element in the range
+*/
+bool mapCursorRangeReadOnly(Map map, MapKeyElement lowKeyElement, MapKeyElement highKeyElement,
+                            MapCursor *cursor);
+
+/**
+*	mapCursorNext: Advances a cursor to the next key element of its map.
+*
+* @param cursor - The cursor to advance.
+* @return
+* 	false if a NULL pointer was sent or the cursor reached the end of the map
+* 	(or of its range)
+* 	true if the cursor points to the next element
+*/
+bool mapCursorNext(MapCursor *cursor);
+
+/**
+*	mapCursorKey: Returns the key element a cursor points to. The key belongs to the
+*	map and must not be freed or changed.
+*
+* @param cursor - The cursor.
+* @return
+* 	NULL if a NULL pointer was sent or the cursor doesn't point to an element
+* 	The key element otherwise
+*/
+MapKeyElement mapCursorKey(MapCursor *cursor);
+
+/**
+*	mapCursorData: Returns the data element a cursor points to. The data belongs
+*	to the map and must not be freed.
+*
+* @param cursor - The cursor.
+* @return
+* 	NULL if a NULL pointer was sent or the cursor doesn't point to an element
+* 	The data element otherwise
+*/
+MapDataElement mapCursorData(MapCursor *cursor);
+
+/**
+*	mapForEach: Calls a function for every (key, data) pair of the map, in ascending
+*	key order, until the function returns false. The function may change the data,
+*	so a map that shares its elements with a copy of it copies them all first.
+*	The function must not insert keys to / remove keys from the map.
+*
+* @param map - The map to iterate over.
+* @param visitElement - The function to call.
+* @param context - Passed as is to every call of visitElement.
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as map or visitElement
+* 	MAP_OUT_OF_MEMORY if an allocation failed
+* 	MAP_SUCCESS otherwise
+*/
+MapResult mapForEach(Map map, visitMapElement visitElement, void *context);
+
+/**
+*	mapForEachReadOnly: Like mapForEach, for a function that only reads the data.
+*	A map that shares its elements with a copy of it keeps sharing them (mapForEach
+*	copies them all first), so visitElement must not change the data.
+*
+* @param map - The map to iterate over.
+* @param visitElement - The function to call.
+* @param context - Passed as is to every call of visitElement.
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as map or visitElement
+* 	MAP_OUT_OF_MEMORY if an allocation failed
+* 	MAP_SUCCESS otherwise
+*/
+MapResult mapForEachReadOnly(Map map, visitMapElement visitElement, void *context);
+
+/**
+*	mapGetStats: Returns the counters of the work done by a map since it was created
+*	(or copied, or its counters were reset).
+*
+* @param map - The map.
+* @param stats - Filled with the counters.
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as map or stats
+* 	MAP_ERROR if the map wasn't compiled with MAP_STATS
+* 	MAP_SUCCESS otherwise
+*/
+MapResult mapGetStats(Map map, MapStats *stats);
+
+/**
+*	mapResetStats: Zeroes the counters of a map. The peak size starts from the current size.
+*
+* @param map - The map.
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as map
+* 	MAP_ERROR if the map wasn't compiled with MAP_STATS
+* 	MAP_SUCCESS otherwise
+*/
+MapResult mapResetStats(Map map);
+
 /*!
 * Macro for iterating over a map.
 * Declares a new iterator for the loop.
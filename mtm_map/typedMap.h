@@ -0,0 +1,116 @@
+#ifndef TYPED_MAP_H_
+#define TYPED_MAP_H_
+
+#include <stdbool.h>
+#include "map.h"
+
+/**
+* Typed int keyed maps
+*
+* DEFINE_TYPED_MAP(name, data_type, copy_function, free_function) defines a map type
+* called name, whose keys are ints and whose data elements are of data_type, on top of
+* an int keyed Map (see mapCreateIntKeyed). DEFINE_TYPED_HASH_MAP does the same on top
+* of an int keyed hash map (mapCreateIntKeyedHashed).
+*
+* The generated functions are static inline wrappers around the Map functions: keys are
+* passed by value, data elements are typed, and the copy & free adapters are generated
+* instead of being written by hand with void* casts. Int keys are compared (and hashed)
+* inside the map without calling back through a function pointer. Copying and freeing
+* data elements still is an indirect call - the map calls the generated adapter through
+* a function pointer, and the adapter calls copy_function / free_function.
+*
+* copy_function  - data_type (*)(data_type), returns NULL on failure
+* free_function  - void (*)(data_type)
+*
+* The following functions are generated (e.g. for name PlayerMap - PlayerMapCreate):
+*   nameCreate		- Creates a new empty map
+*   nameDestroy		- Deletes a map and frees all its elements
+*   nameCopy		- Copies a map (copy on write, see mapCopy)
+*   nameGetSize		- Returns the amount of elements in the map
+*   nameContains	- Returns whether a key exists in the map
+*   nameGet		- Returns the data paired to a key, NULL if it doesn't exist
+*   nameGetReadOnly	- Like nameGet, for data that won't be changed (see mapGetReadOnly)
+*   namePut		- Pairs a copy of a data element to a key
+*   namePutMove		- Pairs a data element itself to a key (see mapPutMove)
+*   nameRemove		- Removes a key and frees its data
+*   nameAsMap		- Returns the underlying Map, for the rest of the Map functions
+*                     (cursors, mapForEach, mapGetOrCreate, ...)
+*/
+
+#define TYPED_MAP_DEFINE_FUNCTIONS(name, data_type, copy_function, free_function, create_map) \
+                                                                                              \
+typedef struct name##_t *name;                                                                \
+                                                                                              \
+static inline MapDataElement name##CopyElement(MapDataElement data)                           \
+{                                                                                             \
+    return copy_function((data_type)data);                                                    \
+}                                                                                             \
+                                                                                              \
+static inline void name##FreeElement(MapDataElement data)                                     \
+{                                                                                             \
+    free_function((data_type)data);                                                           \
+}                                                                                             \
+                                                                                              \
+static inline Map name##AsMap(name map)                                                       \
+{                                                                                             \
+    return (Map)map;                                                                          \
+}                                                                                             \
+                                                                                              \
+static inline name name##Create(void)                                                         \
+{                                                                                             \
+    return (name)create_map(name##CopyElement, name##FreeElement);                            \
+}                                                                                             \
+                                                                                              \
+static inline void name##Destroy(name map)                                                    \
+{                                                                                             \
+    mapDestroy((Map)map);                                                                     \
+}                                                                                             \
+                                                                                              \
+static inline name name##Copy(name map)                                                       \
+{                                                                                             \
+    return (name)mapCopy((Map)map);                                                           \
+}                                                                                             \
+                                                                                              \
+static inline int name##GetSize(name map)                                                     \
+{                                                                                             \
+    return mapGetSize((Map)map);                                                              \
+}                                                                                             \
+                                                                                              \
+static inline bool name##Contains(name map, int key)                                          \
+{                                                                                             \
+    return mapContains((Map)map, &key);                                                       \
+}                                                                                             \
+                                                                                              \
+static inline data_type name##Get(name map, int key)                                          \
+{                                                                                             \
+    return (data_type)mapGet((Map)map, &key);                                                 \
+}                                                                                             \
+                                                                                              \
+static inline data_type name##GetReadOnly(name map, int key)                                  \
+{                                                                                             \
+    return (data_type)mapGetReadOnly((Map)map, &key);                                         \
+}                                                                                             \
+                                                                                              \
+static inline MapResult name##Put(name map, int key, data_type data)                          \
+{                                                                                             \
+    return mapPut((Map)map, &key, data);                                                      \
+}                                                                                             \
+                                                                                              \
+static inline MapResult name##PutMove(name map, int key, data_type data)                      \
+{                                                                                             \
+    return mapPutMove((Map)map, &key, data);                                                  \
+}                                                                                             \
+                                                                                              \
+static inline MapResult name##Remove(name map, int key)                                       \
+{                                                                                             \
+    return mapRemove((Map)map, &key);                                                         \
+}
+
+#define DEFINE_TYPED_MAP(name, data_type, copy_function, free_function) \
+    TYPED_MAP_DEFINE_FUNCTIONS(name, data_type, copy_function, free_function, mapCreateIntKeyed)
+
+#define DEFINE_TYPED_HASH_MAP(name, data_type, copy_function, free_function) \
+    TYPED_MAP_DEFINE_FUNCTIONS(name, data_type, copy_function, free_function, \
+                               mapCreateIntKeyedHashed)
+
+#endif /* TYPED_MAP_H_ */
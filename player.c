@@ -1,5 +1,8 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
 
 #include "./mtm_map/map.h"
 #include "mapUtil.h"
@@ -7,6 +10,16 @@
 #include "game.h"
 #include "playerInTournament.h"
 
+#define PLAYER_INLINE_TOURNAMENTS 3
+
+// The scans of the inline records are counted like the work of a map (see MapStats)
+#ifdef MAP_STATS
+#define PLAYER_INLINE_STATS_ADD(player, counter, amount) \
+    ((player)->inline_stats.counter += (amount))
+#else
+#define PLAYER_INLINE_STATS_ADD(player, counter, amount) ((void)0)
+#endif
+
 
 struct player_t {
     int player_id;
@@ -14,7 +27,20 @@ struct player_t {
     int total_draws;
     int total_losses;
     int total_game_time;
-    Map player_in_tournaments; 
+
+    // Most players play in a few tournaments - their records are kept inline, sorted by
+    // tournament id. Once they don't fit, all of them move to player_in_tournaments
+    // (NULL until then) for good. Copies of the player share the inline records (like the
+    // map) until one of them changes them
+    int inline_tournament_ids[PLAYER_INLINE_TOURNAMENTS];
+    PlayerInTournament inline_tournaments[PLAYER_INLINE_TOURNAMENTS];
+    int amount_of_inline_tournaments;
+    int *inline_share_count; // The amount of players sharing them, NULL if not shared
+    int inline_iterator;
+    PlayerInTournamentMap player_in_tournaments; 
+#ifdef MAP_STATS
+    MapStats inline_stats;
+#endif
 };
 
 
@@ -100,6 +126,194 @@ static PlayerResult translatePlayerInTournamentToPlayer(PlayerInTournamentResult
 
 }
 
+// Returns the index of a tournament's inline record, -1 if there is none
+static int playerFindInlineTournament(Player player, int tournament_id)
+{
+    PLAYER_INLINE_STATS_ADD(player, lookups, 1);
+    for (int i = 0 ; i < player->amount_of_inline_tournaments ; i++)
+    {
+        PLAYER_INLINE_STATS_ADD(player, nodes_traversed, 1);
+        PLAYER_INLINE_STATS_ADD(player, comparisons, 1);
+        if (player->inline_tournament_ids[i] == tournament_id)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Gives up the player's hold on its inline records, destroying them if no copy of the
+// player shares them
+static void playerReleaseInlineTournaments(Player player)
+{
+    if (player->inline_share_count != NULL && *(player->inline_share_count) > 1)
+    {
+        (*(player->inline_share_count))--;
+    }
+    else
+    {
+        for (int i = 0 ; i < player->amount_of_inline_tournaments ; i++)
+        {
+            playerInTournamentDestroy(player->inline_tournaments[i]);
+        }
+        PLAYER_INLINE_STATS_ADD(player, free_calls, player->amount_of_inline_tournaments);
+        free(player->inline_share_count);
+    }
+    player->inline_share_count           = NULL;
+    player->amount_of_inline_tournaments = 0;
+}
+
+// Gives the player inline records of its own if it shares them with copies of it.
+// If an allocation fails the records are left as they were
+static bool playerUnshareInlineTournaments(Player player)
+{
+    if (player->inline_share_count == NULL)
+    {
+        return true;
+    }
+
+    PlayerInTournament inline_tournaments[PLAYER_INLINE_TOURNAMENTS];
+    int amount_of_inline_tournaments = player->amount_of_inline_tournaments;
+    if (*(player->inline_share_count) > 1)
+    {
+        for (int i = 0 ; i < amount_of_inline_tournaments ; i++)
+        {
+            inline_tournaments[i] = playerInTournamentCopy(player->inline_tournaments[i]);
+            if (inline_tournaments[i] == NULL)
+            {
+                for (int j = 0 ; j < i ; j++)
+                {
+                    playerInTournamentDestroy(inline_tournaments[j]);
+                }
+                return false;
+            }
+        }
+        (*(player->inline_share_count))--;
+        for (int i = 0 ; i < amount_of_inline_tournaments ; i++)
+        {
+            player->inline_tournaments[i] = inline_tournaments[i];
+        }
+        PLAYER_INLINE_STATS_ADD(player, copy_calls, amount_of_inline_tournaments);
+    }
+    else
+    {
+        // The other players are gone, the records are already this player's own
+        free(player->inline_share_count);
+    }
+    player->inline_share_count = NULL;
+    return true;
+}
+
+// Returns the player's record of a tournament, NULL if the player isn't playing in it.
+// The record may be changed - if it is shared with copies of the player it is copied
+// first, and NULL is returned if that fails
+static PlayerInTournament playerGetPlayerInTournament(Player player, int tournament_id)
+{
+    if (player->player_in_tournaments != NULL)
+    {
+        return PlayerInTournamentMapGet(player->player_in_tournaments, tournament_id);
+    }
+
+    if (!playerUnshareInlineTournaments(player))
+    {
+        return NULL;
+    }
+    int index = playerFindInlineTournament(player, tournament_id);
+    return index < 0 ? NULL : player->inline_tournaments[index];
+}
+
+// Returns a record of the player that won't be changed (see playerGetPlayerInTournament)
+static PlayerInTournament playerGetPlayerInTournamentReadOnly(Player player, int tournament_id)
+{
+    if (player->player_in_tournaments != NULL)
+    {
+        return PlayerInTournamentMapGetReadOnly(player->player_in_tournaments, tournament_id);
+    }
+
+    int index = playerFindInlineTournament(player, tournament_id);
+    return index < 0 ? NULL : player->inline_tournaments[index];
+}
+
+// Adds a record to the inline records (which have room for it, and are the player's own),
+// keeping them sorted
+static void playerAddInlineTournament(Player player, int tournament_id,
+                                      PlayerInTournament player_in_tournament)
+{
+    assert(player->inline_share_count == NULL);
+    int index = player->amount_of_inline_tournaments;
+    while (index > 0 && player->inline_tournament_ids[index - 1] > tournament_id)
+    {
+        player->inline_tournament_ids[index] = player->inline_tournament_ids[index - 1];
+        player->inline_tournaments[index]    = player->inline_tournaments[index - 1];
+        index--;
+    }
+    player->inline_tournament_ids[index] = tournament_id;
+    player->inline_tournaments[index]    = player_in_tournament;
+    player->amount_of_inline_tournaments++;
+#ifdef MAP_STATS
+    if (player->amount_of_inline_tournaments > player->inline_stats.peak_size)
+    {
+        player->inline_stats.peak_size = player->amount_of_inline_tournaments;
+    }
+#endif
+}
+
+// Destroys an inline record (of the player's own), moving the ones after it back
+static void playerRemoveInlineTournament(Player player, int index)
+{
+    assert(player->inline_share_count == NULL);
+    playerInTournamentDestroy(player->inline_tournaments[index]);
+    PLAYER_INLINE_STATS_ADD(player, free_calls, 1);
+    player->amount_of_inline_tournaments--;
+    for (int i = index ; i < player->amount_of_inline_tournaments ; i++)
+    {
+        player->inline_tournament_ids[i] = player->inline_tournament_ids[i + 1];
+        player->inline_tournaments[i]    = player->inline_tournaments[i + 1];
+    }
+}
+
+// Moves the inline records to a new playerInTournament map. The map gets copies of
+// them, so if it fails the inline records are left as they were
+static bool playerSpillTournaments(Player player)
+{
+    PlayerInTournamentMap player_in_tournaments = createPlayerInTournamentsMap();
+    if (player_in_tournaments == NULL)
+    {
+        return false;
+    }
+
+    for (int i = 0 ; i < player->amount_of_inline_tournaments ; i++)
+    {
+        if (PlayerInTournamentMapPut(player_in_tournaments, player->inline_tournament_ids[i],
+                                     player->inline_tournaments[i]) != MAP_SUCCESS)
+        {
+            PlayerInTournamentMapDestroy(player_in_tournaments);
+            return false;
+        }
+    }
+
+    playerReleaseInlineTournaments(player);
+    player->player_in_tournaments = player_in_tournaments;
+    return true;
+}
+
+// Returns a copy of the ID of the inline record the iterator points to, NULL past the end
+static int *playerGetInlineIteratorID(Player player)
+{
+    if (player->inline_iterator >= player->amount_of_inline_tournaments)
+    {
+        return NULL;
+    }
+
+    int *tournament_id = malloc(sizeof(*tournament_id));
+    if (tournament_id == NULL)
+    {
+        return NULL;
+    }
+    *tournament_id = player->inline_tournament_ids[player->inline_iterator];
+    return tournament_id;
+}
+
 //============================================================//
 //================== INTERNAL FUNCTIONS END ==================//
 //============================================================//
@@ -114,20 +328,19 @@ Player playerCreate(int player_id)
         return NULL;
     }
 
-    //Create a new playerInTournament map for the player
-    player->player_in_tournaments = createPlayerInTournamentsMap();
-    if(player->player_in_tournaments == NULL)
-    {
-        free(player);
-        return NULL;
-    }
-
-    // Initializing fields
+    // Initializing fields - the tournament records start inline, without a map
     player->player_id       = player_id;
     player->total_wins      = 0;
     player->total_draws     = 0;
     player->total_losses    = 0;
     player->total_game_time = 0;
+    player->amount_of_inline_tournaments = 0;
+    player->inline_share_count           = NULL;
+    player->inline_iterator              = 0;
+    player->player_in_tournaments        = NULL;
+#ifdef MAP_STATS
+    memset(&(player->inline_stats), 0, sizeof(player->inline_stats));
+#endif
 
     return player;
 }
@@ -139,7 +352,8 @@ void playerDestroy(Player player)
     {
         return;
     }
-   mapDestroy(player->player_in_tournaments);
+   playerReleaseInlineTournaments(player);
+   PlayerInTournamentMapDestroy(player->player_in_tournaments);
    free(player); 
 }
 
@@ -159,15 +373,39 @@ Player playerCopy(Player player)
         return NULL;
     }
 
-    // Copy playerInTournament map
-    Map player_in_tournament_map = mapCopy(player->player_in_tournaments);
-    if (player_in_tournament_map == NULL)
+    // Share the inline records. They are copied once either player changes them
+    if (player->amount_of_inline_tournaments > 0)
     {
-        free(new_player);
-        return NULL;
+        if (player->inline_share_count == NULL)
+        {
+            player->inline_share_count = malloc(sizeof(*(player->inline_share_count)));
+            if (player->inline_share_count == NULL)
+            {
+                playerDestroy(new_player);
+                return NULL;
+            }
+            *(player->inline_share_count) = 1;
+        }
+        for (int i = 0 ; i < player->amount_of_inline_tournaments ; i++)
+        {
+            new_player->inline_tournament_ids[i] = player->inline_tournament_ids[i];
+            new_player->inline_tournaments[i]    = player->inline_tournaments[i];
+        }
+        new_player->amount_of_inline_tournaments = player->amount_of_inline_tournaments;
+        new_player->inline_share_count           = player->inline_share_count;
+        (*(player->inline_share_count))++;
+    }
+
+    // Copy playerInTournament map, if the records moved to one
+    if (player->player_in_tournaments != NULL)
+    {
+        new_player->player_in_tournaments = PlayerInTournamentMapCopy(player->player_in_tournaments);
+        if (new_player->player_in_tournaments == NULL)
+        {
+            playerDestroy(new_player);
+            return NULL;
+        }
     }
-    mapDestroy(new_player->player_in_tournaments);
-    new_player->player_in_tournaments = player_in_tournament_map;
 
     // Copy fields
     new_player->total_wins      = player->total_wins;
@@ -198,9 +436,16 @@ PlayerResult playerAddGame(Player player, Game game /*int max_games_per_player*/
         return PLAYER_TOURNAMENT_NOT_EXIST;
     }
     
+    // The record exists, so it is missing only if copying it (from a copy of the player) failed
+    PlayerInTournament player_in_tournament = playerGetPlayerInTournament(player, tournament_id);
+    if (player_in_tournament == NULL)
+    {
+        return PLAYER_OUT_OF_MEMORY;
+    }
+
     // Add the game's result to the relevant playerInTournament struct
-    PlayerInTournamentResult add_game_result = playerInTournamentAddGame(mapGet(
-                                player->player_in_tournaments, &tournament_id), game);
+    PlayerInTournamentResult add_game_result = playerInTournamentAddGame(player_in_tournament,
+                                                                         game);
     
     // In case if failure, return so
     PlayerResult translated_add_game_result = translatePlayerInTournamentToPlayer(add_game_result);
@@ -233,9 +478,16 @@ PlayerResult playerRemoveLastGame(Player player, Game game)
         return PLAYER_TOURNAMENT_NOT_EXIST;
     }
 
+    // The record is missing only if copying it failed (see playerAddGame)
+    PlayerInTournament player_in_tournament = playerGetPlayerInTournament(player, tournament_id);
+    if (player_in_tournament == NULL)
+    {
+        return PLAYER_OUT_OF_MEMORY;
+    }
+
     // Remove the game from the relevant playerInTournament struct
-    PlayerInTournamentResult remove_game_result = playerInTournamentRemoveLastGame(mapGet(
-                                player->player_in_tournaments, &tournament_id), game);
+    PlayerInTournamentResult remove_game_result = playerInTournamentRemoveLastGame(
+                player_in_tournament, game);
     
     // In case if failure, return so
     PlayerResult translated_remove_game_result = translatePlayerInTournamentToPlayer(remove_game_result);
@@ -277,6 +529,20 @@ double playerGetFinishedGamesAverageTime(Player player)
 }
 
 
+int playerGetLevelScore(Player player)
+{
+    if (player == NULL)
+    {
+        return PLAYER_INVALID_INPUT;
+    }
+
+    int score = (player->total_wins)   * WIN_WEIGHT;
+    score    += (player->total_losses) * LOSS_WEIGHT;
+    score    += (player->total_draws)  * DRAW_WEIGHT;
+    return score;
+}
+
+
 double playerGetLevel(Player player)
 {
     if (player == NULL)
@@ -291,12 +557,7 @@ double playerGetLevel(Player player)
     }
 
     // Calculates level
-    double level = (player->total_wins)   * WIN_WEIGHT;
-    level       += (player->total_losses) * LOSS_WEIGHT;
-    level       += (player->total_draws)  * DRAW_WEIGHT;
-    level       /= amount_of_games;
-
-    return level;
+    return (double)playerGetLevelScore(player) / amount_of_games;
 }
 
 
@@ -308,12 +569,23 @@ PlayerResult playerRemoveTournament(Player player, int tournament_id)
         return PLAYER_NULL_ARGUMENT;
     }
 
-    PlayerInTournament player_in_tournament = mapGet(player->player_in_tournaments, &tournament_id);
+    PlayerInTournament player_in_tournament =
+        playerGetPlayerInTournamentReadOnly(player, tournament_id);
     if (player_in_tournament == NULL)
     {
         return PLAYER_TOURNAMENT_NOT_EXIST;
     }
 
+    // Inline records shared with copies of the player are copied before one is removed
+    if (player->player_in_tournaments == NULL)
+    {
+        if (!playerUnshareInlineTournaments(player))
+        {
+            return PLAYER_OUT_OF_MEMORY;
+        }
+        player_in_tournament = playerGetPlayerInTournamentReadOnly(player, tournament_id);
+    }
+
     // Update stats
     player->total_wins      -= playerInTournamentGetWins(player_in_tournament);
     player->total_draws     -= playerInTournamentGetDraws(player_in_tournament);
@@ -321,7 +593,14 @@ PlayerResult playerRemoveTournament(Player player, int tournament_id)
     player->total_game_time -= playerInTournamentGetTotalTime(player_in_tournament);
 
     // Cleanup
-    mapRemove(player->player_in_tournaments, &tournament_id);
+    if (player->player_in_tournaments != NULL)
+    {
+        PlayerInTournamentMapRemove(player->player_in_tournaments, tournament_id);
+    }
+    else
+    {
+        playerRemoveInlineTournament(player, playerFindInlineTournament(player, tournament_id));
+    }
     player_in_tournament    = NULL;
 
     return PLAYER_SUCCESS;
@@ -340,7 +619,11 @@ int playerGetID(Player player)
 
 bool playerIsPlayingInTournament(Player player, int tournament_id)
 {
-    return mapContains(player->player_in_tournaments, &tournament_id);
+    if (player->player_in_tournaments != NULL)
+    {
+        return PlayerInTournamentMapContains(player->player_in_tournaments, tournament_id);
+    }
+    return playerFindInlineTournament(player, tournament_id) >= 0;
 }
 
 
@@ -351,7 +634,8 @@ int* playerGetGameIdsInTournament(Player player, int tournament_id)
         return NULL;
     }
 
-    PlayerInTournament player_in_tournament = mapGet(player->player_in_tournaments, &tournament_id);
+    PlayerInTournament player_in_tournament =
+        playerGetPlayerInTournamentReadOnly(player, tournament_id);
     if (player_in_tournament == NULL)
     {
         return NULL;
@@ -368,7 +652,8 @@ bool playerCanPlayMoreGamesInTournament(Player player, int tournament_id)
         return false;
     }
 
-    PlayerInTournament player_in_tournament = mapGet(player->player_in_tournaments, &tournament_id);
+    PlayerInTournament player_in_tournament =
+        playerGetPlayerInTournamentReadOnly(player, tournament_id);
     return playerInTournamentCanPlayMore(player_in_tournament);
 }
 
@@ -381,10 +666,17 @@ PlayerResult playerAddTournament(Player player, int tournament_id, int max_games
         return PLAYER_NULL_ARGUMENT;
     }
 
-    if (mapContains(player->player_in_tournaments, &tournament_id))
+    if (playerIsPlayingInTournament(player, tournament_id))
     {
         return PLAYER_TOURNAMENT_ALREADY_EXISTS;
     }
+
+    // The new record doesn't fit inline - move all the records to a map
+    if (player->amount_of_inline_tournaments == PLAYER_INLINE_TOURNAMENTS &&
+        !playerSpillTournaments(player))
+    {
+        return PLAYER_OUT_OF_MEMORY;
+    }
     
     // Create new playerInTournament
     PlayerInTournament player_in_tournament = playerInTournamentCreate(
@@ -395,12 +687,24 @@ PlayerResult playerAddTournament(Player player, int tournament_id, int max_games
         return PLAYER_OUT_OF_MEMORY;
     }
 
-    MapResult put_result = mapPut(player->player_in_tournaments,
-                                 &tournament_id, player_in_tournament);
+    if (player->player_in_tournaments == NULL)
+    {
+        if (!playerUnshareInlineTournaments(player))
+        {
+            playerInTournamentDestroy(player_in_tournament);
+            return PLAYER_OUT_OF_MEMORY;
+        }
+        playerAddInlineTournament(player, tournament_id, player_in_tournament);
+        return PLAYER_SUCCESS;
+    }
+
+    // The map takes the playerInTournament itself, no copy is made
+    MapResult put_result = PlayerInTournamentMapPutMove(player->player_in_tournaments,
+                                                        tournament_id, player_in_tournament);
     
-    playerInTournamentDestroy(player_in_tournament);
     if (put_result != MAP_SUCCESS)
     {
+        playerInTournamentDestroy(player_in_tournament);
         return PLAYER_OUT_OF_MEMORY;
     }
 
@@ -416,7 +720,7 @@ bool playerUpdateResultsAfterOpponentDeletion(Player player, int tournament_id,
     }
 
     // Couldn't find the tournament
-    PlayerInTournament player_in_tournament = mapGet(player->player_in_tournaments, &tournament_id);
+    PlayerInTournament player_in_tournament = playerGetPlayerInTournament(player, tournament_id);
     if (player_in_tournament == NULL)
     {
         return false;
@@ -455,7 +759,12 @@ int *playerGetFirstTournamentID(Player player)
     {
         return NULL;
     }
-    return mapGetFirst(player->player_in_tournaments);
+    if (player->player_in_tournaments == NULL)
+    {
+        player->inline_iterator = 0;
+        return playerGetInlineIteratorID(player);
+    }
+    return mapGetFirst(PlayerInTournamentMapAsMap(player->player_in_tournaments));
 }
 
 int *playerGetNextTournamentID(Player player)
@@ -464,7 +773,15 @@ int *playerGetNextTournamentID(Player player)
     {
         return NULL;
     }
-    return mapGetNext(player->player_in_tournaments);
+    if (player->player_in_tournaments == NULL)
+    {
+        if (player->inline_iterator < player->amount_of_inline_tournaments)
+        {
+            player->inline_iterator++;
+        }
+        return playerGetInlineIteratorID(player);
+    }
+    return mapGetNext(PlayerInTournamentMapAsMap(player->player_in_tournaments));
 }
 
 
@@ -475,7 +792,8 @@ int playerGetWinsInTournament(Player player, int tournament_id)
         return PLAYER_INVALID_INPUT;
     }
 
-    PlayerInTournament player_in_tournament = mapGet(player->player_in_tournaments, &tournament_id);
+    PlayerInTournament player_in_tournament =
+        playerGetPlayerInTournamentReadOnly(player, tournament_id);
     return playerInTournamentGetWins(player_in_tournament);
 }
 
@@ -486,7 +804,8 @@ int playerGetDrawsInTournament(Player player, int tournament_id)
         return PLAYER_INVALID_INPUT;
     }
 
-    PlayerInTournament player_in_tournament = mapGet(player->player_in_tournaments, &tournament_id);
+    PlayerInTournament player_in_tournament =
+        playerGetPlayerInTournamentReadOnly(player, tournament_id);
     return playerInTournamentGetDraws(player_in_tournament);
 }
 
@@ -496,7 +815,199 @@ int playerGetLossesInTournament(Player player, int tournament_id)
     {
         return PLAYER_INVALID_INPUT;
     }
-    PlayerInTournament player_in_tournament = mapGet(player->player_in_tournaments, &tournament_id);
+    PlayerInTournament player_in_tournament =
+        playerGetPlayerInTournamentReadOnly(player, tournament_id);
     return playerInTournamentGetLosses(player_in_tournament);
 }
 
+
+
+MapResult playerGetTournamentsMapStats(Player player, MapStats *stats)
+{
+    if (player == NULL || stats == NULL)
+    {
+        return MAP_NULL_ARGUMENT;
+    }
+#ifdef MAP_STATS
+    // The scans of the inline records, and then the map's work once they moved to one
+    *stats = player->inline_stats;
+    MapStats map_stats;
+    if (player->player_in_tournaments != NULL &&
+        mapGetStats(PlayerInTournamentMapAsMap(player->player_in_tournaments), &map_stats) ==
+        MAP_SUCCESS)
+    {
+        stats->comparisons     += map_stats.comparisons;
+        stats->lookups         += map_stats.lookups;
+        stats->nodes_traversed += map_stats.nodes_traversed;
+        stats->copy_calls      += map_stats.copy_calls;
+        stats->free_calls      += map_stats.free_calls;
+        if (map_stats.peak_size > stats->peak_size)
+        {
+            stats->peak_size = map_stats.peak_size;
+        }
+    }
+    return MAP_SUCCESS;
+#else
+    return MAP_ERROR;
+#endif
+}
+
+void playerResetTournamentsMapStats(Player player)
+{
+    if (player == NULL)
+    {
+        return;
+    }
+#ifdef MAP_STATS
+    memset(&(player->inline_stats), 0, sizeof(player->inline_stats));
+    player->inline_stats.peak_size = player->amount_of_inline_tournaments;
+#endif
+    mapResetStats(PlayerInTournamentMapAsMap(player->player_in_tournaments));
+}
+
+
+PlayerResult playerWriteSnapshot(Player player, SnapshotWriter writer)
+{
+    if (player == NULL)
+    {
+        return PLAYER_NULL_ARGUMENT;
+    }
+
+    snapshotWriteInt(writer, player->player_id);
+    snapshotWriteInt(writer, player->total_wins);
+    snapshotWriteInt(writer, player->total_draws);
+    snapshotWriteInt(writer, player->total_losses);
+    snapshotWriteInt(writer, player->total_game_time);
+
+    // The records are written in ascending tournament id order
+    if (player->player_in_tournaments == NULL)
+    {
+        snapshotWriteInt(writer, player->amount_of_inline_tournaments);
+        for (int i = 0 ; i < player->amount_of_inline_tournaments ; i++)
+        {
+            playerInTournamentWriteSnapshot(player->inline_tournaments[i], writer);
+        }
+        return PLAYER_SUCCESS;
+    }
+
+    int amount_of_tournaments = PlayerInTournamentMapGetSize(player->player_in_tournaments);
+    MapCursor cursor;
+    bool has_tournament = mapCursorBeginReadOnly(
+                              PlayerInTournamentMapAsMap(player->player_in_tournaments), &cursor);
+    if (!has_tournament && amount_of_tournaments > 0)
+    {
+        return PLAYER_OUT_OF_MEMORY;
+    }
+
+    snapshotWriteInt(writer, amount_of_tournaments);
+    for ( ; has_tournament ; has_tournament = mapCursorNext(&cursor))
+    {
+        playerInTournamentWriteSnapshot(mapCursorData(&cursor), writer);
+    }
+    return PLAYER_SUCCESS;
+}
+
+
+Player playerReadSnapshot(SnapshotReader reader)
+{
+    int player_id = 0;
+    if (!snapshotReadInt(reader, &player_id))
+    {
+        return NULL;
+    }
+
+    Player player = playerCreate(player_id);
+    if (player == NULL)
+    {
+        snapshotReaderFail(reader, SNAPSHOT_OUT_OF_MEMORY);
+        return NULL;
+    }
+
+    int amount_of_tournaments = 0;
+    if (!snapshotReadInt(reader, &(player->total_wins))      ||
+        !snapshotReadInt(reader, &(player->total_draws))     ||
+        !snapshotReadInt(reader, &(player->total_losses))    ||
+        !snapshotReadInt(reader, &(player->total_game_time)) ||
+        !snapshotReadCount(reader, INT_MAX / (int)sizeof(MapDataElement), SNAPSHOT_INT_SIZE,
+                           &amount_of_tournaments))
+    {
+        playerDestroy(player);
+        return NULL;
+    }
+
+    // Few records are kept inline, as they are when the player is built game by game
+    if (amount_of_tournaments <= PLAYER_INLINE_TOURNAMENTS)
+    {
+        for (int i = 0 ; i < amount_of_tournaments ; i++)
+        {
+            PlayerInTournament player_in_tournament = playerInTournamentReadSnapshot(reader,
+                                                                                     player_id);
+            if (player_in_tournament == NULL)
+            {
+                playerDestroy(player);
+                return NULL;
+            }
+            playerAddInlineTournament(player, playerInTournamentGetTournamentID(player_in_tournament),
+                                      player_in_tournament);
+        }
+        return player;
+    }
+
+    // The rest are built into the map at once - the records are sorted by tournament id
+    int *tournament_ids = malloc(amount_of_tournaments * sizeof(*tournament_ids));
+    MapKeyElement *keys = malloc(amount_of_tournaments * sizeof(*keys));
+    MapDataElement *player_in_tournaments = malloc(amount_of_tournaments *
+                                                   sizeof(*player_in_tournaments));
+    player->player_in_tournaments = createPlayerInTournamentsMap();
+    int amount_read = 0;
+    if (tournament_ids == NULL || keys == NULL || player_in_tournaments == NULL ||
+        player->player_in_tournaments == NULL)
+    {
+        snapshotReaderFail(reader, SNAPSHOT_OUT_OF_MEMORY);
+    }
+    else
+    {
+        for ( ; amount_read < amount_of_tournaments ; amount_read++)
+        {
+            player_in_tournaments[amount_read] = playerInTournamentReadSnapshot(reader, player_id);
+            if (player_in_tournaments[amount_read] == NULL)
+            {
+                break;
+            }
+            tournament_ids[amount_read] =
+                playerInTournamentGetTournamentID(player_in_tournaments[amount_read]);
+            keys[amount_read] = &(tournament_ids[amount_read]);
+        }
+    }
+
+    MapResult build_result = MAP_ERROR;
+    if (amount_read == amount_of_tournaments)
+    {
+        build_result = mapBuildFromSortedMove(
+                            PlayerInTournamentMapAsMap(player->player_in_tournaments),
+                            keys, player_in_tournaments, amount_of_tournaments);
+        if (build_result != MAP_SUCCESS)
+        {
+            snapshotReaderFail(reader, build_result == MAP_OUT_OF_MEMORY ?
+                                       SNAPSHOT_OUT_OF_MEMORY : SNAPSHOT_INVALID_FILE);
+        }
+    }
+
+    // On failure, the records read still belong to this function
+    if (build_result != MAP_SUCCESS)
+    {
+        for (int i = 0 ; i < amount_read ; i++)
+        {
+            playerInTournamentDestroy(player_in_tournaments[i]);
+        }
+    }
+    free(tournament_ids);
+    free(keys);
+    free(player_in_tournaments);
+    if (build_result != MAP_SUCCESS)
+    {
+        playerDestroy(player);
+        return NULL;
+    }
+    return player;
+}
@@ -3,6 +3,8 @@
 
 #include <stdio.h>
 #include "game.h"
+#include "snapshot.h"
+#include "./mtm_map/map.h"
 
 #define INVALID_PLAYER -3
 #define DELETED_PLAYER -2
@@ -60,6 +62,8 @@ void playerDestroy(Player player);
 
 /**
  * playerCopy: copies a new player.
+ *             The copy shares the player's tournament records until either of
+ *             them changes, so copying doesn't depend on the amount of tournaments.
  *
  * @param player - the player
  * @return The coppied player in case of success, and NULL otherwise (e.g.
@@ -107,6 +111,18 @@ int playerGetTotalGames(Player player);
 double playerGetFinishedGamesAverageTime(Player player);
 
 
+/**
+ * playerGetLevelScore: Returns the weighted score of the games of a given player -
+ *                      the numerator of their level (over their amount of games)
+ *
+ * @param player - the player
+ * @return
+ *      The weighted score of said player
+ *      PLAYER_INVALID_INPUT - if the input is not valid
+ */
+int playerGetLevelScore(Player player);
+
+
 /**
  * playerGetLevel: Calculates and returns the level of a given player
  *
@@ -126,6 +142,8 @@ double playerGetLevel(Player player);
  * @return
  *      PLAYER_NULL_ARGUMENT - if player is NULL
  *      PLAYER_TOURNAMENT_NOT_EXIST - if the player never played in the tournament
+ *      PLAYER_OUT_OF_MEMORY - if the records were shared with a copy of the player, and
+ *                             copying them failed
  *      PLAYER_SUCCESS - in the case of success
  */
 PlayerResult playerRemoveTournament(Player player, int tournament_id);
@@ -280,4 +298,56 @@ int playerGetLossesInTournament(Player player, int tournament_id);
  */
 PlayerResult playerRemoveLastGame(Player player, Game game);
 
+
+/**
+ * playerGetTournamentsMapStats: returns the counters of the work done on the player's
+ *                               tournament records - the scans of the records kept
+ *                               inline (each record visited is a node traversed and a
+ *                               comparison), plus the work of the map holding them once
+ *                               they moved to one. peak_size is the larger of the two.
+ *
+ * @param player - the player
+ * @param stats  - filled with the counters
+ * @return
+ *      MAP_NULL_ARGUMENT - if a NULL was sent
+ *      MAP_ERROR         - if the player wasn't compiled with MAP_STATS
+ *      MAP_SUCCESS       - otherwise
+ */
+MapResult playerGetTournamentsMapStats(Player player, MapStats *stats);
+
+
+/**
+ * playerResetTournamentsMapStats: zeroes the counters of the work done on the
+ *                                 player's tournament records (see
+ *                                 playerGetTournamentsMapStats).
+ *
+ * @param player - the player
+ */
+void playerResetTournamentsMapStats(Player player);
+
+
+/**
+ * playerWriteSnapshot: writes a player, with its records of every tournament, to a
+ *                      snapshot.
+ *
+ * @param player - the player
+ * @param writer - the snapshot writer
+ * @return
+ *     PLAYER_NULL_ARGUMENT - if player is NULL
+ *     PLAYER_OUT_OF_MEMORY - if iterating the player's records failed
+ *     PLAYER_SUCCESS - otherwise (write errors are kept by the writer)
+ */
+PlayerResult playerWriteSnapshot(Player player, SnapshotWriter writer);
+
+
+/**
+ * playerReadSnapshot: reads a player written by playerWriteSnapshot. The player's
+ *                     records are put in place as they are, without verifying them.
+ *
+ * @param reader - the snapshot reader
+ * @return
+ *     A new Player in case of success, and NULL otherwise (the reader then fails)
+ */
+Player playerReadSnapshot(SnapshotReader reader);
+
 #endif //_PLAYER_H
\ No newline at end of file
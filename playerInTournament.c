@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
 
 #include "playerInTournament.h"
 
@@ -343,4 +344,63 @@ PlayerInTournamentResult playerInTournamentRemoveLastGame(PlayerInTournament pla
     }
     (player_in_tournament->losses)--;
     return PLAYER_IN_TOURNAMENT_SUCCESS;
-}
\ No newline at end of file
+}
+
+
+void playerInTournamentWriteSnapshot(PlayerInTournament player_in_tournament, SnapshotWriter writer)
+{
+    if (player_in_tournament == NULL)
+    {
+        return;
+    }
+
+    snapshotWriteInt(writer, player_in_tournament->tournament_id);
+    snapshotWriteInt(writer, player_in_tournament->max_games_per_player);
+    snapshotWriteInt(writer, player_in_tournament->wins);
+    snapshotWriteInt(writer, player_in_tournament->draws);
+    snapshotWriteInt(writer, player_in_tournament->losses);
+    snapshotWriteInt(writer, player_in_tournament->total_game_time);
+
+    // Only the games played - the rest of the ids are INVALID_GAME_ID
+    int amount_of_games = 0;
+    while (amount_of_games < player_in_tournament->max_games_per_player &&
+           player_in_tournament->game_ids[amount_of_games] != INVALID_GAME_ID)
+    {
+        amount_of_games++;
+    }
+    snapshotWriteInt(writer, amount_of_games);
+    snapshotWriteInts(writer, player_in_tournament->game_ids, amount_of_games);
+}
+
+
+PlayerInTournament playerInTournamentReadSnapshot(SnapshotReader reader, int player_id)
+{
+    int tournament_id        = 0;
+    int max_games_per_player = 0;
+    if (!snapshotReadInt(reader, &tournament_id) ||
+        !snapshotReadCount(reader, INT_MAX / (int)sizeof(int), 0, &max_games_per_player))
+    {
+        return NULL;
+    }
+
+    PlayerInTournament player_in_tournament = playerInTournamentCreate(player_id, tournament_id,
+                                                                       max_games_per_player);
+    if (player_in_tournament == NULL)
+    {
+        snapshotReaderFail(reader, SNAPSHOT_OUT_OF_MEMORY);
+        return NULL;
+    }
+
+    int amount_of_games = 0;
+    if (!snapshotReadInt(reader, &(player_in_tournament->wins))            ||
+        !snapshotReadInt(reader, &(player_in_tournament->draws))           ||
+        !snapshotReadInt(reader, &(player_in_tournament->losses))          ||
+        !snapshotReadInt(reader, &(player_in_tournament->total_game_time)) ||
+        !snapshotReadCount(reader, max_games_per_player, SNAPSHOT_INT_SIZE, &amount_of_games) ||
+        !snapshotReadInts(reader, player_in_tournament->game_ids, amount_of_games))
+    {
+        playerInTournamentDestroy(player_in_tournament);
+        return NULL;
+    }
+    return player_in_tournament;
+}
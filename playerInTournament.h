@@ -3,6 +3,7 @@
 
 #include <stdio.h>
 #include "game.h"
+#include "snapshot.h"
 
 #define PLAYER_IN_TOURNAMENT_INVALID_INPUT -10
 
@@ -209,4 +210,26 @@ bool playerInTournamentUpdateLossToWin(PlayerInTournament player_in_tournament);
 PlayerInTournamentResult playerInTournamentRemoveLastGame(PlayerInTournament player_in_tournament, Game game);
 
 
+/**
+ * playerInTournamentWriteSnapshot: writes a player in tournament to a snapshot.
+ *                                  The player's id isn't written.
+ *
+ * @param player_in_tournament - the player in tournament
+ * @param writer - the snapshot writer
+ */
+void playerInTournamentWriteSnapshot(PlayerInTournament player_in_tournament, SnapshotWriter writer);
+
+
+/**
+ * playerInTournamentReadSnapshot: reads a player in tournament written by
+ *                                 playerInTournamentWriteSnapshot.
+ *
+ * @param reader - the snapshot reader
+ * @param player_id - the id of the player
+ * @return
+ *     A new PlayerInTournament in case of success, and NULL otherwise (the reader then fails)
+ */
+PlayerInTournament playerInTournamentReadSnapshot(SnapshotReader reader, int player_id);
+
+
 #endif //  _PLAYER_IN_TOURNAMENT_H
\ No newline at end of file
@@ -0,0 +1,504 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <unistd.h>
+
+#include "snapshot.h"
+
+#define SNAPSHOT_BUFFER_SIZE (1 << 16)
+#define SNAPSHOT_MAGIC "CHSS"
+#define SNAPSHOT_MAGIC_SIZE 4
+#define SNAPSHOT_TEMPORARY_SUFFIX ".tmp"
+#define SNAPSHOT_CHECKSUM_SIZE 8
+#define SNAPSHOT_FNV_OFFSET 0xcbf29ce484222325ull
+#define SNAPSHOT_FNV_PRIME  0x100000001b3ull
+
+
+struct snapshot_writer_t {
+    FILE *file;
+    char *path;
+    char *temporary_path;   // The file is written here, and replaces path once it's whole
+    unsigned char *buffer;
+    int filled;
+    uint64_t checksum;      // FNV-1a of everything written
+    bool failed;
+};
+
+struct snapshot_reader_t {
+    FILE *file;
+    unsigned char *buffer;
+    int position;
+    int filled;
+    long unread;            // Bytes of the file not read into the buffer yet
+    uint64_t checksum;      // FNV-1a of everything read
+    SnapshotResult error;   // SNAPSHOT_SUCCESS until a read fails
+};
+
+//==============================================================//
+//================== INTERNAL FUNCTIONS START ==================//
+//==============================================================//
+
+// Adds bytes to an FNV-1a checksum
+static uint64_t snapshotChecksum(uint64_t checksum, const unsigned char *bytes, int size)
+{
+    for (int i = 0 ; i < size ; i++)
+    {
+        checksum ^= bytes[i];
+        checksum *= SNAPSHOT_FNV_PRIME;
+    }
+    return checksum;
+}
+
+// Writes the buffer of a writer to its file
+static void snapshotWriterFlush(SnapshotWriter writer)
+{
+    if (!writer->failed && writer->filled > 0 &&
+        fwrite(writer->buffer, 1, writer->filled, writer->file) != (size_t)writer->filled)
+    {
+        writer->failed = true;
+    }
+    writer->filled = 0;
+}
+
+// Writes bytes through the buffer of a writer, adding them to the checksum if needed
+static void snapshotWriteBytes(SnapshotWriter writer, const void *bytes, int size,
+                               bool is_checksummed)
+{
+    if (writer->failed)
+    {
+        return;
+    }
+
+    if (is_checksummed)
+    {
+        writer->checksum = snapshotChecksum(writer->checksum, bytes, size);
+    }
+    while (size > 0)
+    {
+        if (writer->filled == SNAPSHOT_BUFFER_SIZE)
+        {
+            snapshotWriterFlush(writer);
+        }
+        int chunk = SNAPSHOT_BUFFER_SIZE - writer->filled < size ?
+                    SNAPSHOT_BUFFER_SIZE - writer->filled : size;
+        memcpy(writer->buffer + writer->filled, bytes, chunk);
+        writer->filled += chunk;
+        bytes           = (const unsigned char*)bytes + chunk;
+        size           -= chunk;
+    }
+}
+
+// Encodes an int as little endian bytes
+static void snapshotEncodeInt(int value, unsigned char bytes[SNAPSHOT_INT_SIZE])
+{
+    uint32_t bits = (uint32_t)value;
+    for (int i = 0 ; i < SNAPSHOT_INT_SIZE ; i++)
+    {
+        bytes[i] = (unsigned char)(bits >> (8 * i));
+    }
+}
+
+// Decodes an int from little endian bytes
+static int snapshotDecodeInt(const unsigned char bytes[SNAPSHOT_INT_SIZE])
+{
+    uint32_t bits = 0;
+    for (int i = 0 ; i < SNAPSHOT_INT_SIZE ; i++)
+    {
+        bits |= (uint32_t)bytes[i] << (8 * i);
+    }
+    return bits <= INT_MAX ? (int)bits : -(int)(UINT32_MAX - bits) - 1;
+}
+
+// Reads bytes through the buffer of a reader, adding them to the checksum if needed.
+// Returns false if the file ended or couldn't be read
+static bool snapshotReadBytes(SnapshotReader reader, void *bytes, int size, bool is_checksummed)
+{
+    if (reader->error != SNAPSHOT_SUCCESS)
+    {
+        return false;
+    }
+
+    unsigned char *destination = bytes;
+    int remaining = size;
+    while (remaining > 0)
+    {
+        if (reader->position == reader->filled)
+        {
+            reader->filled   = (int)fread(reader->buffer, 1, SNAPSHOT_BUFFER_SIZE, reader->file);
+            reader->position = 0;
+            reader->unread  -= reader->filled;
+            if (reader->filled == 0)
+            {
+                snapshotReaderFail(reader, ferror(reader->file) ? SNAPSHOT_IO_ERROR
+                                                                : SNAPSHOT_INVALID_FILE);
+                return false;
+            }
+        }
+        int chunk = reader->filled - reader->position < remaining ?
+                    reader->filled - reader->position : remaining;
+        memcpy(destination, reader->buffer + reader->position, chunk);
+        reader->position += chunk;
+        destination      += chunk;
+        remaining        -= chunk;
+    }
+
+    if (is_checksummed)
+    {
+        reader->checksum = snapshotChecksum(reader->checksum, bytes, size);
+    }
+    return true;
+}
+
+// Returns the amount of bytes of a reader's file that weren't read yet
+static long snapshotGetRemaining(SnapshotReader reader)
+{
+    return reader->unread + (reader->filled - reader->position);
+}
+
+// Sets the amount of unread bytes of a reader's new file to the size of the file
+static bool snapshotMeasureFile(SnapshotReader reader)
+{
+    if (fseek(reader->file, 0, SEEK_END) != 0)
+    {
+        return false;
+    }
+    reader->unread = ftell(reader->file);
+    return reader->unread >= 0 && fseek(reader->file, 0, SEEK_SET) == 0;
+}
+
+// Frees a writer whose file is closed already
+static void snapshotWriterFree(SnapshotWriter writer)
+{
+    free(writer->path);
+    free(writer->temporary_path);
+    free(writer->buffer);
+    free(writer);
+}
+
+//============================================================//
+//================== INTERNAL FUNCTIONS END ==================//
+//============================================================//
+
+
+SnapshotWriter snapshotWriterCreate(const char *path)
+{
+    if (path == NULL)
+    {
+        return NULL;
+    }
+
+    SnapshotWriter writer = malloc(sizeof(*writer));
+    if (writer == NULL)
+    {
+        return NULL;
+    }
+
+    writer->buffer = malloc(SNAPSHOT_BUFFER_SIZE);
+    if (writer->buffer == NULL)
+    {
+        free(writer);
+        return NULL;
+    }
+
+    writer->path           = malloc(strlen(path) + 1);
+    writer->temporary_path = malloc(strlen(path) + strlen(SNAPSHOT_TEMPORARY_SUFFIX) + 1);
+    if (writer->path == NULL || writer->temporary_path == NULL)
+    {
+        free(writer->path);
+        free(writer->temporary_path);
+        free(writer->buffer);
+        free(writer);
+        return NULL;
+    }
+    strcpy(writer->path, path);
+    strcpy(writer->temporary_path, path);
+    strcat(writer->temporary_path, SNAPSHOT_TEMPORARY_SUFFIX);
+
+    writer->file = fopen(writer->temporary_path, "wb");
+    if (writer->file == NULL)
+    {
+        free(writer->path);
+        free(writer->temporary_path);
+        free(writer->buffer);
+        free(writer);
+        return NULL;
+    }
+
+    writer->filled   = 0;
+    writer->checksum = SNAPSHOT_FNV_OFFSET;
+    writer->failed   = false;
+    snapshotWriteBytes(writer, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE, true);
+    snapshotWriteInt(writer, SNAPSHOT_VERSION);
+    return writer;
+}
+
+
+void snapshotWriteInt(SnapshotWriter writer, int value)
+{
+    if (writer == NULL)
+    {
+        return;
+    }
+
+    unsigned char bytes[SNAPSHOT_INT_SIZE];
+    snapshotEncodeInt(value, bytes);
+    snapshotWriteBytes(writer, bytes, SNAPSHOT_INT_SIZE, true);
+}
+
+
+void snapshotWriteInts(SnapshotWriter writer, const int *values, int amount_of_values)
+{
+    if (writer == NULL || values == NULL)
+    {
+        return;
+    }
+
+    for (int i = 0 ; i < amount_of_values ; i++)
+    {
+        snapshotWriteInt(writer, values[i]);
+    }
+}
+
+
+void snapshotWriteString(SnapshotWriter writer, const char *string)
+{
+    if (writer == NULL || string == NULL)
+    {
+        return;
+    }
+
+    int length = (int)strlen(string);
+    snapshotWriteInt(writer, length);
+    snapshotWriteBytes(writer, string, length, true);
+}
+
+
+SnapshotResult snapshotWriterClose(SnapshotWriter writer)
+{
+    if (writer == NULL)
+    {
+        return SNAPSHOT_NULL_ARGUMENT;
+    }
+
+    // The checksum isn't part of itself
+    unsigned char checksum[SNAPSHOT_CHECKSUM_SIZE];
+    for (int i = 0 ; i < SNAPSHOT_CHECKSUM_SIZE ; i++)
+    {
+        checksum[i] = (unsigned char)(writer->checksum >> (8 * i));
+    }
+    snapshotWriteBytes(writer, checksum, SNAPSHOT_CHECKSUM_SIZE, false);
+    snapshotWriterFlush(writer);
+
+    // The previous snapshot is replaced only by a whole one, that reached the disk
+    bool failed = writer->failed || fflush(writer->file) != 0 || fsync(fileno(writer->file)) != 0;
+    if (fclose(writer->file) != 0)
+    {
+        failed = true;
+    }
+    if (!failed && rename(writer->temporary_path, writer->path) != 0)
+    {
+        failed = true;
+    }
+    if (failed)
+    {
+        remove(writer->temporary_path);
+    }
+    snapshotWriterFree(writer);
+    return failed ? SNAPSHOT_IO_ERROR : SNAPSHOT_SUCCESS;
+}
+
+
+void snapshotWriterAbort(SnapshotWriter writer)
+{
+    if (writer == NULL)
+    {
+        return;
+    }
+
+    // The partial file never replaces the previous snapshot
+    fclose(writer->file);
+    remove(writer->temporary_path);
+    snapshotWriterFree(writer);
+}
+
+
+SnapshotReader snapshotReaderCreate(const char *path)
+{
+    if (path == NULL)
+    {
+        return NULL;
+    }
+
+    SnapshotReader reader = malloc(sizeof(*reader));
+    if (reader == NULL)
+    {
+        return NULL;
+    }
+
+    reader->buffer = malloc(SNAPSHOT_BUFFER_SIZE);
+    if (reader->buffer == NULL)
+    {
+        free(reader);
+        return NULL;
+    }
+
+    reader->file = fopen(path, "rb");
+    if (reader->file == NULL)
+    {
+        free(reader->buffer);
+        free(reader);
+        return NULL;
+    }
+    if (!snapshotMeasureFile(reader))
+    {
+        fclose(reader->file);
+        free(reader->buffer);
+        free(reader);
+        return NULL;
+    }
+
+    reader->position = 0;
+    reader->filled   = 0;
+    reader->checksum = SNAPSHOT_FNV_OFFSET;
+    reader->error    = SNAPSHOT_SUCCESS;
+
+    // Verify the header
+    char magic[SNAPSHOT_MAGIC_SIZE];
+    int version = 0;
+    if (!snapshotReadBytes(reader, magic, SNAPSHOT_MAGIC_SIZE, true) ||
+        memcmp(magic, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE) != 0 ||
+        !snapshotReadInt(reader, &version) || version != SNAPSHOT_VERSION)
+    {
+        snapshotReaderClose(reader);
+        return NULL;
+    }
+    return reader;
+}
+
+
+bool snapshotReadInt(SnapshotReader reader, int *value)
+{
+    if (reader == NULL || value == NULL)
+    {
+        return false;
+    }
+
+    unsigned char bytes[SNAPSHOT_INT_SIZE];
+    if (!snapshotReadBytes(reader, bytes, SNAPSHOT_INT_SIZE, true))
+    {
+        *value = 0;
+        return false;
+    }
+    *value = snapshotDecodeInt(bytes);
+    return true;
+}
+
+
+bool snapshotReadCount(SnapshotReader reader, int maximum, int element_size, int *count)
+{
+    if (!snapshotReadInt(reader, count))
+    {
+        return false;
+    }
+
+    // The counted elements must fit in the rest of the file, so a corrupted count fails
+    // here instead of allocating for elements that aren't there
+    if (*count < 0 || *count > maximum ||
+        (element_size > 0 && *count > snapshotGetRemaining(reader) / element_size))
+    {
+        *count = 0;
+        snapshotReaderFail(reader, SNAPSHOT_INVALID_FILE);
+        return false;
+    }
+    return true;
+}
+
+
+bool snapshotReadInts(SnapshotReader reader, int *values, int amount_of_values)
+{
+    if (reader == NULL || values == NULL)
+    {
+        return false;
+    }
+
+    for (int i = 0 ; i < amount_of_values ; i++)
+    {
+        if (!snapshotReadInt(reader, &(values[i])))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+char *snapshotReadString(SnapshotReader reader)
+{
+    int length = 0;
+    if (!snapshotReadCount(reader, INT_MAX - 1, 1, &length))
+    {
+        return NULL;
+    }
+
+    char *string = malloc(length + 1);
+    if (string == NULL)
+    {
+        snapshotReaderFail(reader, SNAPSHOT_OUT_OF_MEMORY);
+        return NULL;
+    }
+
+    if (!snapshotReadBytes(reader, string, length, true))
+    {
+        free(string);
+        return NULL;
+    }
+    string[length] = '\0';
+    return string;
+}
+
+
+void snapshotReaderFail(SnapshotReader reader, SnapshotResult result)
+{
+    if (reader == NULL || reader->error != SNAPSHOT_SUCCESS)
+    {
+        return;
+    }
+    reader->error = result;
+}
+
+
+SnapshotResult snapshotReaderClose(SnapshotReader reader)
+{
+    if (reader == NULL)
+    {
+        return SNAPSHOT_NULL_ARGUMENT;
+    }
+
+    // Everything read must match the checksum at the end of the file
+    uint64_t expected_checksum = reader->checksum;
+    unsigned char checksum[SNAPSHOT_CHECKSUM_SIZE];
+    if (snapshotReadBytes(reader, checksum, SNAPSHOT_CHECKSUM_SIZE, false))
+    {
+        uint64_t file_checksum = 0;
+        for (int i = 0 ; i < SNAPSHOT_CHECKSUM_SIZE ; i++)
+        {
+            file_checksum |= (uint64_t)checksum[i] << (8 * i);
+        }
+
+        bool is_file_over = reader->position == reader->filled && fgetc(reader->file) == EOF;
+        if (file_checksum != expected_checksum || !is_file_over)
+        {
+            snapshotReaderFail(reader, SNAPSHOT_INVALID_FILE);
+        }
+    }
+
+    SnapshotResult result = reader->error;
+    fclose(reader->file);
+    free(reader->buffer);
+    free(reader);
+    return result;
+}
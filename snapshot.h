@@ -0,0 +1,190 @@
+#ifndef _SNAPSHOT_H
+#define _SNAPSHOT_H
+
+#include <stdio.h>
+#include <stdbool.h>
+
+#define SNAPSHOT_VERSION 2
+#define SNAPSHOT_INT_SIZE 4     // The bytes an int takes in the file
+
+typedef enum {
+    SNAPSHOT_OUT_OF_MEMORY,
+    SNAPSHOT_NULL_ARGUMENT,
+    SNAPSHOT_IO_ERROR,
+    SNAPSHOT_INVALID_FILE,
+    SNAPSHOT_SUCCESS
+} SnapshotResult ;
+
+
+/**
+ * Types for writing and reading a snapshot file - a binary file of ints and strings,
+ * read back in the order they were written.
+ *
+ * The file starts with a magic number and SNAPSHOT_VERSION, and ends with a checksum
+ * of everything before it. Ints are stored as 4 little endian bytes, so a snapshot
+ * doesn't depend on the machine that wrote it. The file is written and read through
+ * a buffer. A snapshot is written to a temporary file, which replaces the previous
+ * snapshot only once it was written whole and synced to the disk.
+ *
+ * Errors are kept by the writer / reader - once a write or a read failed, the next
+ * ones do nothing, and the error is returned when the file is closed. A reader can
+ * only tell that the checksum is wrong once everything was read (see
+ * snapshotReaderClose), so whatever was read from it is used only after it's closed.
+ */
+typedef struct snapshot_writer_t *SnapshotWriter;
+typedef struct snapshot_reader_t *SnapshotReader;
+
+
+/**
+ * snapshotWriterCreate: creates a snapshot file and writes its header. An existing file
+ *                       is replaced when the writer is closed successfully.
+ *
+ * @param path - the path of the file
+ *
+ * @return A new SnapshotWriter in case of success, and NULL otherwise (e.g. if the
+ *     file couldn't be created, or in case of an allocation error)
+ */
+SnapshotWriter snapshotWriterCreate(const char *path);
+
+
+/**
+ * snapshotWriteInt: writes an int to the snapshot.
+ *
+ * @param writer - the writer
+ * @param value  - the int to write
+ */
+void snapshotWriteInt(SnapshotWriter writer, int value);
+
+
+/**
+ * snapshotWriteInts: writes an array of ints to the snapshot (without its size).
+ *
+ * @param writer - the writer
+ * @param values - the ints to write
+ * @param amount_of_values - the amount of ints
+ */
+void snapshotWriteInts(SnapshotWriter writer, const int *values, int amount_of_values);
+
+
+/**
+ * snapshotWriteString: writes a string (its length, then its chars) to the snapshot.
+ *
+ * @param writer - the writer
+ * @param string - the string to write
+ */
+void snapshotWriteString(SnapshotWriter writer, const char *string);
+
+
+/**
+ * snapshotWriterClose: writes the checksum, syncs and closes the file, and frees the
+ *                      writer. The file then replaces the previous snapshot, if any.
+ *
+ * @param writer - the writer. A NULL value is allowed, and in that case the function
+ *     does nothing.
+ *
+ * @return
+ *     SNAPSHOT_NULL_ARGUMENT - if writer is NULL
+ *     SNAPSHOT_IO_ERROR      - if writing any part of the file failed
+ *     SNAPSHOT_SUCCESS       - otherwise
+ */
+SnapshotResult snapshotWriterClose(SnapshotWriter writer);
+
+
+/**
+ * snapshotWriterAbort: closes and deletes a partially written file, and frees the
+ *                      writer. The previous snapshot, if any, is kept.
+ *
+ * @param writer - the writer. A NULL value is allowed, and in that case the function
+ *     does nothing.
+ */
+void snapshotWriterAbort(SnapshotWriter writer);
+
+
+/**
+ * snapshotReaderCreate: opens a snapshot file and reads its header.
+ *
+ * @param path - the path of the file
+ *
+ * @return A new SnapshotReader in case of success, and NULL otherwise (e.g. if the
+ *     file couldn't be opened, isn't a snapshot of SNAPSHOT_VERSION, or in case of
+ *     an allocation error)
+ */
+SnapshotReader snapshotReaderCreate(const char *path);
+
+
+/**
+ * snapshotReadInt: reads an int from the snapshot.
+ *
+ * @param reader - the reader
+ * @param value  - set to the int read, 0 if the read failed
+ *
+ * @return true if the int was read, false otherwise
+ */
+bool snapshotReadInt(SnapshotReader reader, int *value);
+
+
+/**
+ * snapshotReadCount: reads an int that counts something (e.g. an array size) - it is
+ *                    invalid if it's negative, greater than a given maximum, or if the
+ *                    counted elements can't fit in the rest of the file.
+ *
+ * @param reader - the reader
+ * @param maximum - the greatest valid count
+ * @param element_size - the least amount of bytes every counted element takes in the
+ *     file, 0 if the counted elements aren't stored in the file
+ * @param count  - set to the count read, 0 if the read failed
+ *
+ * @return true if a valid count was read, false otherwise (the reader then fails
+ *     with SNAPSHOT_INVALID_FILE)
+ */
+bool snapshotReadCount(SnapshotReader reader, int maximum, int element_size, int *count);
+
+
+/**
+ * snapshotReadInts: reads an array of ints from the snapshot.
+ *
+ * @param reader - the reader
+ * @param values - the array to fill
+ * @param amount_of_values - the amount of ints to read
+ *
+ * @return true if all the ints were read, false otherwise
+ */
+bool snapshotReadInts(SnapshotReader reader, int *values, int amount_of_values);
+
+
+/**
+ * snapshotReadString: reads a string written by snapshotWriteString.
+ *
+ * @param reader - the reader
+ *
+ * @return A new string (that should be freed) in case of success, and NULL otherwise
+ */
+char *snapshotReadString(SnapshotReader reader);
+
+
+/**
+ * snapshotReaderFail: makes the reader fail, e.g. when the data read is invalid.
+ *
+ * @param reader - the reader
+ * @param result - the error to return when the reader is closed
+ */
+void snapshotReaderFail(SnapshotReader reader, SnapshotResult result);
+
+
+/**
+ * snapshotReaderClose: verifies the checksum of everything read, and that nothing is
+ *                      left after it. Closes the file and frees the reader.
+ *
+ * @param reader - the reader. A NULL value is allowed, and in that case the function
+ *     does nothing.
+ *
+ * @return
+ *     SNAPSHOT_NULL_ARGUMENT - if reader is NULL
+ *     SNAPSHOT_IO_ERROR      - if reading the file failed
+ *     SNAPSHOT_INVALID_FILE  - if the file is cut, corrupted, or its contents are invalid
+ *     SNAPSHOT_OUT_OF_MEMORY - if the reader failed for an allocation error
+ *     SNAPSHOT_SUCCESS       - otherwise
+ */
+SnapshotResult snapshotReaderClose(SnapshotReader reader);
+
+#endif //_SNAPSHOT_H
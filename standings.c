@@ -0,0 +1,303 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "./mtm_map/typedMap.h"
+#include "standings.h"
+
+#define STANDINGS_INITIAL_CAPACITY 4
+
+
+// helper struct - a player's standing, as ranked by the standings
+typedef struct standing_t {
+    int player_id;
+    int score;
+    int wins;
+    int losses;
+} Standing;
+
+
+// Copies a heap position, for the positions map
+static int *standingsPositionCopy(int *position)
+{
+    int *new_position = malloc(sizeof(*new_position));
+    if (new_position == NULL)
+    {
+        return NULL;
+    }
+    *new_position = *position;
+    return new_position;
+}
+
+// Frees a heap position, for the positions map
+static void standingsPositionFree(int *position)
+{
+    free(position);
+}
+
+DEFINE_TYPED_HASH_MAP(StandingPositionMap, int*, standingsPositionCopy, standingsPositionFree)
+
+
+struct standings_t {
+    Standing *heap;                 // A max heap - the leader is heap[0]
+    int size;
+    int capacity;
+    StandingPositionMap positions;  // Player id -> the index of the player in the heap
+};
+
+
+//==============================================================//
+//================== INTERNAL FUNCTIONS START ==================//
+//==============================================================//
+
+// Checks whether the first standing ranks above the second one
+static bool standingIsAbove(Standing *first, Standing *second)
+{
+    if (first->score != second->score)
+    {
+        return first->score > second->score;
+    }
+    if (first->losses != second->losses)
+    {
+        return first->losses < second->losses;
+    }
+    if (first->wins != second->wins)
+    {
+        return first->wins > second->wins;
+    }
+    return first->player_id < second->player_id;
+}
+
+// Puts a standing at an index of the heap, recording its new position.
+// The player is in the positions map already, so nothing is allocated
+static void standingsPlace(Standings standings, int index, Standing standing)
+{
+    standings->heap[index] = standing;
+    *StandingPositionMapGet(standings->positions, standing.player_id) = index;
+}
+
+// Moves the standing at an index up the heap, while it ranks above its parent
+static void standingsSiftUp(Standings standings, int index)
+{
+    Standing standing = standings->heap[index];
+    while (index > 0)
+    {
+        int parent = (index - 1) / 2;
+        if (!standingIsAbove(&standing, &(standings->heap[parent])))
+        {
+            break;
+        }
+        standingsPlace(standings, index, standings->heap[parent]);
+        index = parent;
+    }
+    standingsPlace(standings, index, standing);
+}
+
+// Moves the standing at an index down the heap, while one of its children ranks above it
+static void standingsSiftDown(Standings standings, int index)
+{
+    Standing standing = standings->heap[index];
+    while (2 * index + 1 < standings->size)
+    {
+        int child = 2 * index + 1;
+        if (child + 1 < standings->size &&
+            standingIsAbove(&(standings->heap[child + 1]), &(standings->heap[child])))
+        {
+            child++;
+        }
+        if (!standingIsAbove(&(standings->heap[child]), &standing))
+        {
+            break;
+        }
+        standingsPlace(standings, index, standings->heap[child]);
+        index = child;
+    }
+    standingsPlace(standings, index, standing);
+}
+
+// Returns the heap index of a player, -1 if the player is not in the standings
+static int standingsFind(Standings standings, int player_id)
+{
+    int *position = StandingPositionMapGetReadOnly(standings->positions, player_id);
+    return position == NULL ? -1 : *position;
+}
+
+//============================================================//
+//================== INTERNAL FUNCTIONS END ==================//
+//============================================================//
+
+
+Standings standingsCreate()
+{
+    Standings standings = malloc(sizeof(*standings));
+    if (standings == NULL)
+    {
+        return NULL;
+    }
+
+    standings->heap = malloc(STANDINGS_INITIAL_CAPACITY * sizeof(*(standings->heap)));
+    if (standings->heap == NULL)
+    {
+        free(standings);
+        return NULL;
+    }
+
+    standings->positions = StandingPositionMapCreate();
+    if (standings->positions == NULL)
+    {
+        free(standings->heap);
+        free(standings);
+        return NULL;
+    }
+
+    standings->size     = 0;
+    standings->capacity = STANDINGS_INITIAL_CAPACITY;
+    return standings;
+}
+
+
+void standingsDestroy(Standings standings)
+{
+    if (standings == NULL)
+    {
+        return;
+    }
+    StandingPositionMapDestroy(standings->positions);
+    free(standings->heap);
+    free(standings);
+}
+
+
+Standings standingsCopy(Standings standings)
+{
+    if (standings == NULL)
+    {
+        return NULL;
+    }
+
+    Standings new_standings = standingsCreate();
+    if (new_standings == NULL)
+    {
+        return NULL;
+    }
+
+    // The positions are put one by one instead of copying the map - a copied map would
+    // copy a position when standingsPlace first changes it, which may then fail
+    for (int i = 0 ; i < standings->size ; i++)
+    {
+        if (standingsAdd(new_standings, standings->heap[i].player_id) != STANDINGS_SUCCESS)
+        {
+            standingsDestroy(new_standings);
+            return NULL;
+        }
+    }
+    for (int i = 0 ; i < standings->size ; i++)
+    {
+        standingsPlace(new_standings, i, standings->heap[i]);
+    }
+    return new_standings;
+}
+
+
+StandingsResult standingsAdd(Standings standings, int player_id)
+{
+    if (standings == NULL)
+    {
+        return STANDINGS_NULL_ARGUMENT;
+    }
+
+    if (StandingPositionMapContains(standings->positions, player_id))
+    {
+        return STANDINGS_PLAYER_ALREADY_EXISTS;
+    }
+
+    if (standings->size == standings->capacity)
+    {
+        Standing *new_heap = realloc(standings->heap, 2 * standings->capacity * sizeof(*new_heap));
+        if (new_heap == NULL)
+        {
+            return STANDINGS_OUT_OF_MEMORY;
+        }
+        standings->heap      = new_heap;
+        standings->capacity *= 2;
+    }
+
+    int position = standings->size;
+    if (StandingPositionMapPut(standings->positions, player_id, &position) != MAP_SUCCESS)
+    {
+        return STANDINGS_OUT_OF_MEMORY;
+    }
+
+    Standing standing = { player_id, 0, 0, 0 };
+    standings->heap[standings->size] = standing;
+    (standings->size)++;
+    standingsSiftUp(standings, position);
+    return STANDINGS_SUCCESS;
+}
+
+
+StandingsResult standingsUpdate(Standings standings, int player_id, int score, int wins, int losses)
+{
+    if (standings == NULL)
+    {
+        return STANDINGS_NULL_ARGUMENT;
+    }
+
+    int index = standingsFind(standings, player_id);
+    if (index < 0)
+    {
+        return STANDINGS_PLAYER_NOT_EXIST;
+    }
+
+    Standing standing = { player_id, score, wins, losses };
+    standings->heap[index] = standing;
+    standingsSiftUp(standings, index);
+    standingsSiftDown(standings, standingsFind(standings, player_id));
+    return STANDINGS_SUCCESS;
+}
+
+
+StandingsResult standingsRemove(Standings standings, int player_id)
+{
+    if (standings == NULL)
+    {
+        return STANDINGS_NULL_ARGUMENT;
+    }
+
+    int index = standingsFind(standings, player_id);
+    if (index < 0)
+    {
+        return STANDINGS_PLAYER_NOT_EXIST;
+    }
+
+    // The last standing takes the removed one's place, and moves to where it belongs
+    (standings->size)--;
+    if (index < standings->size)
+    {
+        int moved_player_id = standings->heap[standings->size].player_id;
+        standingsPlace(standings, index, standings->heap[standings->size]);
+        standingsSiftUp(standings, index);
+        standingsSiftDown(standings, standingsFind(standings, moved_player_id));
+    }
+    StandingPositionMapRemove(standings->positions, player_id);
+    return STANDINGS_SUCCESS;
+}
+
+
+int standingsGetLeader(Standings standings)
+{
+    if (standings == NULL)
+    {
+        return STANDINGS_INVALID_INPUT;
+    }
+    return standings->size == 0 ? STANDINGS_NO_LEADER : standings->heap[0].player_id;
+}
+
+
+int standingsGetSize(Standings standings)
+{
+    if (standings == NULL)
+    {
+        return STANDINGS_INVALID_INPUT;
+    }
+    return standings->size;
+}
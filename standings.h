@@ -0,0 +1,122 @@
+#ifndef _STANDINGS_H
+#define _STANDINGS_H
+
+#include <stdio.h>
+#include <stdbool.h>
+
+#define STANDINGS_INVALID_INPUT -10
+#define STANDINGS_NO_LEADER     -1
+
+typedef enum {
+    STANDINGS_OUT_OF_MEMORY,
+    STANDINGS_NULL_ARGUMENT,
+    STANDINGS_PLAYER_ALREADY_EXISTS,
+    STANDINGS_PLAYER_NOT_EXIST,
+    STANDINGS_SUCCESS
+} StandingsResult ;
+
+
+/**
+ * Type for the live standings of the players of a tournament.
+ * Players are ranked by their score (higher first), then by their losses (fewer first),
+ * then by their wins (more first), and then by their id (smaller first).
+ * The leader is read in constant time, and a player's standing is updated in O(log n).
+ */
+typedef struct standings_t *Standings;
+
+/**
+ * standingsCreate: create empty standings.
+ *
+ * @return New Standings in case of success, and NULL otherwise (e.g.
+ *     in case of an allocation error)
+ */
+Standings standingsCreate();
+
+
+/**
+ * standingsDestroy: free standings, and all their contents, from memory.
+ *
+ * @param standings - the standings to free from memory. A NULL value is
+ *     allowed, and in that case the function does nothing.
+ */
+void standingsDestroy(Standings standings);
+
+
+/**
+ * standingsCopy: copies given standings
+ *
+ * @param standings - the standings to copy
+ * @return
+ *     The coppied standings if the function Succeeded
+ *     if the allocation failed the function return NULL
+ */
+Standings standingsCopy(Standings standings);
+
+
+/**
+ * standingsAdd: adds a player to the standings, with no score, wins or losses.
+ *
+ * @param standings - the standings
+ * @param player_id - the id of the player to add
+ * @return
+ *      STANDINGS_NULL_ARGUMENT         - if standings is NULL
+ *      STANDINGS_PLAYER_ALREADY_EXISTS - if the player is already in the standings
+ *      STANDINGS_OUT_OF_MEMORY         - if an allocation failed
+ *      STANDINGS_SUCCESS               - otherwise
+ */
+StandingsResult standingsAdd(Standings standings, int player_id);
+
+
+/**
+ * standingsUpdate: sets the score, wins and losses of a player in the standings.
+ *                  Never allocates memory, so it can't fail for a player in the standings.
+ *
+ * @param standings - the standings
+ * @param player_id - the id of the player
+ * @param score     - the player's score
+ * @param wins      - the player's wins
+ * @param losses    - the player's losses
+ * @return
+ *      STANDINGS_NULL_ARGUMENT    - if standings is NULL
+ *      STANDINGS_PLAYER_NOT_EXIST - if the player is not in the standings
+ *      STANDINGS_SUCCESS          - otherwise
+ */
+StandingsResult standingsUpdate(Standings standings, int player_id, int score, int wins, int losses);
+
+
+/**
+ * standingsRemove: removes a player from the standings.
+ *
+ * @param standings - the standings
+ * @param player_id - the id of the player to remove
+ * @return
+ *      STANDINGS_NULL_ARGUMENT    - if standings is NULL
+ *      STANDINGS_PLAYER_NOT_EXIST - if the player is not in the standings
+ *      STANDINGS_SUCCESS          - otherwise
+ */
+StandingsResult standingsRemove(Standings standings, int player_id);
+
+
+/**
+ * standingsGetLeader: returns the id of the leading player, in constant time.
+ *
+ * @param standings - the standings
+ * @return
+ *      STANDINGS_INVALID_INPUT - if standings is NULL
+ *      STANDINGS_NO_LEADER     - if there are no players in the standings
+ *      The id of the leading player otherwise
+ */
+int standingsGetLeader(Standings standings);
+
+
+/**
+ * standingsGetSize: returns the amount of players in the standings.
+ *
+ * @param standings - the standings
+ * @return
+ *      STANDINGS_INVALID_INPUT - if standings is NULL
+ *      The amount of players in the standings otherwise
+ */
+int standingsGetSize(Standings standings);
+
+#endif //_STANDINGS_H
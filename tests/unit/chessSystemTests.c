@@ -0,0 +1,688 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "chessSystem.h"
+#include "test_utilities.h"
+
+#define CHESS_TEST_LOAD_LINES 5000
+#define CHESS_TEST_LOAD_PLAYERS 200
+#define CHESS_TEST_LONG_LINE 70000  // Longer than the game log read buffer
+
+
+// Reads the first line of a file, without its new line. Returns false on failure
+static bool readFirstLine(const char *path, char *line, int size)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+    {
+        return false;
+    }
+    bool is_read = fgets(line, size, file) != NULL;
+    fclose(file);
+    if (is_read)
+    {
+        line[strcspn(line, "\n")] = '\0';
+    }
+    return is_read;
+}
+
+
+// Reads the whole of an open file, from its start, as a string. Returns false on failure
+static bool readWholeStream(FILE *file, char *contents, int size)
+{
+    rewind(file);
+    size_t length = fread(contents, 1, size - 1, file);
+    contents[length] = '\0';
+    return !ferror(file) && feof(file);
+}
+
+
+// Adds two tournaments to a system, ends one of them, with a few games each
+static bool addSampleCalls(ChessSystem chess)
+{
+    return chessAddTournament(chess, 1, 4, "London") == CHESS_SUCCESS &&
+           chessAddTournament(chess, 2, 2, "Paris") == CHESS_SUCCESS &&
+           chessAddGame(chess, 1, 1, 2, FIRST_PLAYER, 10) == CHESS_SUCCESS &&
+           chessAddGame(chess, 1, 1, 3, DRAW, 20) == CHESS_SUCCESS &&
+           chessAddGame(chess, 1, 2, 3, SECOND_PLAYER, 5) == CHESS_SUCCESS &&
+           chessAddGame(chess, 2, 4, 1, SECOND_PLAYER, 30) == CHESS_SUCCESS &&
+           chessAddGame(chess, 2, 4, 5, DRAW, 7) == CHESS_SUCCESS &&
+           chessEndTournament(chess, 1) == CHESS_SUCCESS;
+}
+
+// Creates a system of the sample calls
+static ChessSystem createSampleSystem()
+{
+    ChessSystem chess = chessCreate();
+    if (chess == NULL || !addSampleCalls(chess))
+    {
+        chessDestroy(chess);
+        return NULL;
+    }
+    return chess;
+}
+
+// Writes the levels and the statistics of a system to a file. Returns false on failure
+static bool saveSystemOutput(ChessSystem chess, const char *path)
+{
+    char statistics_path[] = "unit_output_statistics.txt";
+    FILE *file = fopen(path, "w");
+    if (file == NULL)
+    {
+        return false;
+    }
+    bool is_saved = chessSavePlayersLevels(chess, file) == CHESS_SUCCESS &&
+                    chessSaveTournamentStatistics(chess, statistics_path) == CHESS_SUCCESS;
+    FILE *statistics_file = fopen(statistics_path, "r");
+    for (int c = statistics_file == NULL ? EOF : fgetc(statistics_file) ; c != EOF ;
+         c = fgetc(statistics_file))
+    {
+        fputc(c, file);
+    }
+    if (statistics_file != NULL)
+    {
+        fclose(statistics_file);
+    }
+    remove(statistics_path);
+    return fclose(file) == 0 && is_saved;
+}
+
+// Checks whether two files have the same contents
+static bool filesAreEqual(const char *first_path, const char *second_path)
+{
+    FILE *first  = fopen(first_path, "r");
+    FILE *second = fopen(second_path, "r");
+    bool is_equal = first != NULL && second != NULL;
+    while (is_equal)
+    {
+        int first_char = fgetc(first);
+        is_equal = first_char == fgetc(second);
+        if (first_char == EOF)
+        {
+            break;
+        }
+    }
+    if (first != NULL)
+    {
+        fclose(first);
+    }
+    if (second != NULL)
+    {
+        fclose(second);
+    }
+    return is_equal;
+}
+
+// Creates a system with two active tournaments (max 2 and 3 games) and an ended one
+static ChessSystem createBatchSystem()
+{
+    ChessSystem chess = chessCreate();
+    if (chess == NULL ||
+        chessAddTournament(chess, 1, 2, "London") != CHESS_SUCCESS ||
+        chessAddTournament(chess, 2, 3, "Paris") != CHESS_SUCCESS ||
+        chessAddTournament(chess, 3, 2, "Rome") != CHESS_SUCCESS ||
+        chessAddGame(chess, 3, 7, 8, DRAW, 1) != CHESS_SUCCESS ||
+        chessEndTournament(chess, 3) != CHESS_SUCCESS)
+    {
+        chessDestroy(chess);
+        return NULL;
+    }
+    return chess;
+}
+
+// Overwrites an int of a snapshot or journal file, at a given offset, with a little endian value
+static bool overwriteFileInt(const char *path, long offset, unsigned int value)
+{
+    FILE *file = fopen(path, "r+b");
+    if (file == NULL)
+    {
+        return false;
+    }
+    bool is_written = fseek(file, offset, SEEK_SET) == 0;
+    for (int i = 0 ; i < 4 && is_written ; i++)
+    {
+        is_written = fputc((int)((value >> (8 * i)) & 0xff), file) != EOF;
+    }
+    return fclose(file) == 0 && is_written;
+}
+
+
+bool testEndTournamentWithNoPlayersLeft()
+{
+    ChessSystem chess = chessCreate();
+    ASSERT_TEST(chess != NULL);
+    ASSERT_TEST_WITH_FREE(chessAddTournament(chess, 1, 3, "London") == CHESS_SUCCESS,
+                          chessDestroy(chess));
+    ASSERT_TEST_WITH_FREE(chessAddGame(chess, 1, 1, 2, FIRST_PLAYER, 10) == CHESS_SUCCESS,
+                          chessDestroy(chess));
+    ASSERT_TEST_WITH_FREE(chessRemovePlayer(chess, 1) == CHESS_SUCCESS, chessDestroy(chess));
+    ASSERT_TEST_WITH_FREE(chessRemovePlayer(chess, 2) == CHESS_SUCCESS, chessDestroy(chess));
+
+    // No one is left to win, so the tournament stays active
+    ASSERT_TEST_WITH_FREE(chessEndTournament(chess, 1) == CHESS_SUCCESS, chessDestroy(chess));
+    ASSERT_TEST_WITH_FREE(chessAddGame(chess, 1, 3, 4, FIRST_PLAYER, 10) == CHESS_SUCCESS,
+                          chessDestroy(chess));
+    ChessResult result;
+    ASSERT_TEST_WITH_FREE(chessGetTournamentLeader(chess, 1, &result) == 3 &&
+                          result == CHESS_SUCCESS, chessDestroy(chess));
+
+    ASSERT_TEST_WITH_FREE(chessEndTournament(chess, 1) == CHESS_SUCCESS, chessDestroy(chess));
+    char path[] = "unit_statistics.txt";
+    ASSERT_TEST_WITH_FREE(chessSaveTournamentStatistics(chess, path) == CHESS_SUCCESS,
+                          chessDestroy(chess));
+    chessDestroy(chess);
+
+    char winner[32];
+    ASSERT_TEST(readFirstLine(path, winner, sizeof(winner)));
+    remove(path);
+    ASSERT_TEST(strcmp(winner, "3") == 0);
+    return true;
+}
+
+
+bool testRemoveTournamentAndPlayer()
+{
+    ChessSystem chess = createSampleSystem();
+    ASSERT_TEST(chess != NULL);
+
+    // Removing a player passes the lead of its active tournament on
+    ChessResult result;
+    ASSERT_TEST_WITH_FREE(chessGetTournamentLeader(chess, 2, &result) == 1 &&
+                          chessRemovePlayer(chess, 1) == CHESS_SUCCESS &&
+                          chessGetTournamentLeader(chess, 2, &result) == 4, chessDestroy(chess));
+
+    // Removing a tournament removes the games of its participants only
+    ASSERT_TEST_WITH_FREE(chessRemoveTournament(chess, 2) == CHESS_SUCCESS &&
+                          chessRemoveTournament(chess, 2) == CHESS_TOURNAMENT_NOT_EXIST,
+                          chessDestroy(chess));
+    ASSERT_TEST_WITH_FREE(saveSystemOutput(chess, "unit_actual.txt"), chessDestroy(chess));
+    chessDestroy(chess);
+
+    ChessSystem expected = chessCreate();
+    ASSERT_TEST(expected != NULL);
+    ASSERT_TEST_WITH_FREE(chessAddTournament(expected, 1, 4, "London") == CHESS_SUCCESS &&
+                          chessAddGame(expected, 1, 1, 2, FIRST_PLAYER, 10) == CHESS_SUCCESS &&
+                          chessAddGame(expected, 1, 1, 3, DRAW, 20) == CHESS_SUCCESS &&
+                          chessAddGame(expected, 1, 2, 3, SECOND_PLAYER, 5) == CHESS_SUCCESS &&
+                          chessEndTournament(expected, 1) == CHESS_SUCCESS &&
+                          chessRemovePlayer(expected, 1) == CHESS_SUCCESS,
+                          chessDestroy(expected));
+    ASSERT_TEST_WITH_FREE(saveSystemOutput(expected, "unit_expected.txt"),
+                          chessDestroy(expected));
+    chessDestroy(expected);
+
+    bool is_equal = filesAreEqual("unit_expected.txt", "unit_actual.txt");
+    remove("unit_expected.txt");
+    remove("unit_actual.txt");
+    ASSERT_TEST(is_equal);
+    return true;
+}
+
+
+bool testAddGamesLikeAddGame()
+{
+    // Records of every result, interleaving tournaments, where some depend on earlier ones
+    ChessGameRecord records[] = {
+        { 1, 1, 2, FIRST_PLAYER, 10 }, { 2, 1, 2, DRAW, 10 },    { 1, 2, 1, DRAW, 5 },
+        { 1, 1, 3, SECOND_PLAYER, 3 }, { 1, 1, 4, DRAW, 4 },     { 2, 3, 3, DRAW, 1 },
+        { 3, 1, 2, DRAW, 1 },          { 9, 1, 2, DRAW, 1 },     { 0, 1, 2, DRAW, 1 },
+        { 2, 5, 6, DRAW, -1 },         { 2, 5, -6, DRAW, 1 },    { 2, 5, 6, SECOND_PLAYER, 0 },
+        { 2, 6, 1, FIRST_PLAYER, 8 },  { 2, 6, 7, DRAW, 9 },     { 2, 6, 8, DRAW, 9 },
+        { 2, 6, 9, DRAW, 9 },          { 1, 4, 5, FIRST_PLAYER, 2 }
+    };
+    int amount_of_records = sizeof(records) / sizeof(*records);
+    ChessResult expected_results[sizeof(records) / sizeof(*records)];
+    ChessResult results[sizeof(records) / sizeof(*records)];
+
+    // The same system gets the records one by one, and as a batch
+    ChessSystem systems[2] = { createBatchSystem(), createBatchSystem() };
+    ASSERT_TEST_WITH_FREE(systems[0] != NULL && systems[1] != NULL,
+                          (chessDestroy(systems[0]), chessDestroy(systems[1])));
+    for (int i = 0 ; i < amount_of_records ; i++)
+    {
+        expected_results[i] = chessAddGame(systems[0], records[i].tournament_id,
+                                           records[i].first_player, records[i].second_player,
+                                           records[i].winner, records[i].play_time);
+    }
+    ASSERT_TEST_WITH_FREE(chessAddGames(systems[1], records, amount_of_records, results) ==
+                          CHESS_SUCCESS, (chessDestroy(systems[0]), chessDestroy(systems[1])));
+    ASSERT_TEST_WITH_FREE(memcmp(results, expected_results, sizeof(results)) == 0,
+                          (chessDestroy(systems[0]), chessDestroy(systems[1])));
+    ASSERT_TEST_WITH_FREE(saveSystemOutput(systems[0], "unit_expected.txt") &&
+                          saveSystemOutput(systems[1], "unit_actual.txt"),
+                          (chessDestroy(systems[0]), chessDestroy(systems[1])));
+
+    // Every kind of result is covered
+    ChessResult covered[] = { CHESS_SUCCESS, CHESS_GAME_ALREADY_EXISTS, CHESS_EXCEEDED_GAMES,
+                              CHESS_INVALID_ID, CHESS_TOURNAMENT_ENDED,
+                              CHESS_TOURNAMENT_NOT_EXIST, CHESS_INVALID_PLAY_TIME };
+    bool is_covered = true;
+    for (int i = 0 ; i < (int)(sizeof(covered) / sizeof(*covered)) ; i++)
+    {
+        bool is_found = false;
+        for (int j = 0 ; j < amount_of_records ; j++)
+        {
+            is_found = is_found || results[j] == covered[i];
+        }
+        is_covered = is_covered && is_found;
+    }
+
+    ASSERT_TEST_WITH_FREE(chessAddGames(systems[1], NULL, 0, NULL) == CHESS_SUCCESS &&
+                          chessAddGames(systems[1], NULL, 1, results) == CHESS_NULL_ARGUMENT &&
+                          chessAddGames(NULL, records, 1, results) == CHESS_NULL_ARGUMENT,
+                          (chessDestroy(systems[0]), chessDestroy(systems[1])));
+    chessDestroy(systems[0]);
+    chessDestroy(systems[1]);
+
+    bool is_equal = filesAreEqual("unit_expected.txt", "unit_actual.txt");
+    remove("unit_expected.txt");
+    remove("unit_actual.txt");
+    ASSERT_TEST(is_covered && is_equal);
+    return true;
+}
+
+
+bool testLoadGamesFromFile()
+{
+    char path[] = "unit_games.txt";
+    FILE *games_file = fopen(path, "w");
+    ASSERT_TEST(games_file != NULL);
+    fputs("# tournament first second winner time\n"
+          "1 1 2 0 10\n"
+          "\n"
+          "1,2,3,2,5\n"
+          "  2\t1\t2\t1\t7  \n"
+          "1 1 2 1 3\n"
+          "1 2 4 0 3\n"
+          "3 1 2 0 1\n"
+          "1 5 6 3 1\n"
+          "1 5 6 0\n"
+          "1 5 6 0 1 9\n"
+          "1 5 x6 0 1\n"
+          "9 5 6 0 1\n"
+          "2 5 6 0 -1\n"
+          "2 5 6 2 4\r\n"
+          "1 7 8 0 2", games_file);
+    ASSERT_TEST(fclose(games_file) == 0);
+
+    ChessSystem chess = createBatchSystem();
+    FILE *error_file = fopen("unit_errors.txt", "w+");
+    ASSERT_TEST_WITH_FREE(chess != NULL && error_file != NULL,
+                          (chessDestroy(chess), error_file == NULL ? 0 : fclose(error_file)));
+    ChessResult result = chessLoadGamesFromFile(chess, path, error_file);
+    char errors[512];
+    bool is_read = readWholeStream(error_file, errors, sizeof(errors));
+    fclose(error_file);
+    remove("unit_errors.txt");
+    remove(path);
+    ASSERT_TEST_WITH_FREE(result == CHESS_SUCCESS && is_read, chessDestroy(chess));
+    ASSERT_TEST_WITH_FREE(strcmp(errors, "line 6: CHESS_GAME_ALREADY_EXISTS\n"
+                                         "line 7: CHESS_EXCEEDED_GAMES\n"
+                                         "line 8: CHESS_TOURNAMENT_ENDED\n"
+                                         "line 9: invalid line\n"
+                                         "line 10: invalid line\n"
+                                         "line 11: invalid line\n"
+                                         "line 12: invalid line\n"
+                                         "line 13: CHESS_TOURNAMENT_NOT_EXIST\n"
+                                         "line 14: CHESS_INVALID_PLAY_TIME\n") == 0,
+                          chessDestroy(chess));
+    ASSERT_TEST_WITH_FREE(saveSystemOutput(chess, "unit_actual.txt"), chessDestroy(chess));
+    chessDestroy(chess);
+
+    // The same as adding the valid games one by one
+    ChessSystem expected = createBatchSystem();
+    ASSERT_TEST(expected != NULL);
+    ASSERT_TEST_WITH_FREE(chessAddGame(expected, 1, 1, 2, FIRST_PLAYER, 10) == CHESS_SUCCESS &&
+                          chessAddGame(expected, 1, 2, 3, DRAW, 5) == CHESS_SUCCESS &&
+                          chessAddGame(expected, 2, 1, 2, SECOND_PLAYER, 7) == CHESS_SUCCESS &&
+                          chessAddGame(expected, 2, 5, 6, DRAW, 4) == CHESS_SUCCESS &&
+                          chessAddGame(expected, 1, 7, 8, FIRST_PLAYER, 2) == CHESS_SUCCESS,
+                          chessDestroy(expected));
+    ASSERT_TEST_WITH_FREE(saveSystemOutput(expected, "unit_expected.txt"),
+                          chessDestroy(expected));
+    chessDestroy(expected);
+
+    bool is_equal = filesAreEqual("unit_expected.txt", "unit_actual.txt");
+    remove("unit_expected.txt");
+    remove("unit_actual.txt");
+    ASSERT_TEST(is_equal);
+
+    ASSERT_TEST(chessLoadGamesFromFile(NULL, path, NULL) == CHESS_NULL_ARGUMENT);
+    chess = chessCreate();
+    ASSERT_TEST(chess != NULL);
+    ASSERT_TEST_WITH_FREE(chessLoadGamesFromFile(chess, "unit_missing.txt", NULL) ==
+                          CHESS_SAVE_FAILURE, chessDestroy(chess));
+    chessDestroy(chess);
+    return true;
+}
+
+
+bool testLoadGamesFromLargeFile()
+{
+    // More games than fit in the read buffer or in a batch, and a line too long to read
+    char path[] = "unit_games.txt";
+    FILE *games_file = fopen(path, "w");
+    ASSERT_TEST(games_file != NULL);
+    ChessSystem expected = createBatchSystem();
+    ASSERT_TEST_WITH_FREE(expected != NULL, (fclose(games_file), remove(path)));
+    unsigned int random = 1;
+    int amount_of_errors = 0;
+    for (int line_number = 1 ; line_number <= CHESS_TEST_LOAD_LINES ; line_number++)
+    {
+        if (line_number == CHESS_TEST_LOAD_LINES / 2)
+        {
+            for (int i = 0 ; i < CHESS_TEST_LONG_LINE ; i++)
+            {
+                fputc('1', games_file);
+            }
+            fputc('\n', games_file);
+            amount_of_errors++;
+            continue;
+        }
+        random = random * 1103515245u + 12345u;
+        int tournament_id = 1 + (random >> 8) % 2;
+        int first_player  = 1 + (random >> 12) % CHESS_TEST_LOAD_PLAYERS;
+        int second_player = 1 + (random >> 20) % CHESS_TEST_LOAD_PLAYERS;
+        Winner winner     = (random >> 4) % 3;
+        int play_time     = (random >> 16) % 100;
+        fprintf(games_file, "%d %d %d %d %d\n", tournament_id, first_player, second_player,
+                winner, play_time);
+        amount_of_errors += chessAddGame(expected, tournament_id, first_player, second_player,
+                                         winner, play_time) != CHESS_SUCCESS;
+    }
+    ASSERT_TEST_WITH_FREE(fclose(games_file) == 0, (chessDestroy(expected), remove(path)));
+    ASSERT_TEST_WITH_FREE(saveSystemOutput(expected, "unit_expected.txt"),
+                          (chessDestroy(expected), remove(path)));
+    chessDestroy(expected);
+
+    ChessSystem chess = createBatchSystem();
+    FILE *error_file = fopen("unit_errors.txt", "w+");
+    bool is_loaded = chess != NULL && error_file != NULL &&
+                     chessLoadGamesFromFile(chess, path, error_file) == CHESS_SUCCESS &&
+                     saveSystemOutput(chess, "unit_actual.txt");
+    chessDestroy(chess);
+    remove(path);
+
+    // Every line that wasn't added is reported
+    int amount_of_reported = 0;
+    if (error_file != NULL)
+    {
+        rewind(error_file);
+        for (int c = fgetc(error_file) ; c != EOF ; c = fgetc(error_file))
+        {
+            amount_of_reported += c == '\n';
+        }
+        fclose(error_file);
+        remove("unit_errors.txt");
+    }
+
+    bool is_equal = filesAreEqual("unit_expected.txt", "unit_actual.txt");
+    remove("unit_expected.txt");
+    remove("unit_actual.txt");
+    ASSERT_TEST(is_loaded && is_equal && amount_of_reported == amount_of_errors);
+    return true;
+}
+
+
+bool testSavePlayersLevelsOrder()
+{
+    ChessSystem chess = chessCreate();
+    ASSERT_TEST(chess != NULL);
+    ASSERT_TEST_WITH_FREE(chessAddTournament(chess, 1, 10, "London") == CHESS_SUCCESS &&
+                          chessAddGame(chess, 1, 2, 1, DRAW, 1) == CHESS_SUCCESS &&
+                          chessAddGame(chess, 1, 4, 3, SECOND_PLAYER, 1) == CHESS_SUCCESS &&
+                          chessAddGame(chess, 1, 7, 5, DRAW, 1) == CHESS_SUCCESS &&
+                          chessAddGame(chess, 1, 5, 6, DRAW, 1) == CHESS_SUCCESS,
+                          chessDestroy(chess));
+
+    // Equal levels (even over different amounts of games) are ordered by id
+    char levels[256];
+    char path[] = "unit_levels.txt";
+    FILE *file = fopen(path, "w+");
+    ASSERT_TEST_WITH_FREE(file != NULL, chessDestroy(chess));
+    bool is_saved = chessSavePlayersLevels(chess, file) == CHESS_SUCCESS &&
+                    readWholeStream(file, levels, sizeof(levels));
+    fclose(file);
+    ASSERT_TEST_WITH_FREE(is_saved && strcmp(levels, "3 6.00\n"
+                                                      "1 2.00\n"
+                                                      "2 2.00\n"
+                                                      "5 2.00\n"
+                                                      "6 2.00\n"
+                                                      "7 2.00\n"
+                                                      "4 -10.00\n") == 0,
+                          (chessDestroy(chess), remove(path)));
+
+    // Player 5 wins the game of the removed player 7, and moves up
+    ASSERT_TEST_WITH_FREE(chessRemovePlayer(chess, 7) == CHESS_SUCCESS,
+                          (chessDestroy(chess), remove(path)));
+    file = fopen(path, "w+");
+    ASSERT_TEST_WITH_FREE(file != NULL, (chessDestroy(chess), remove(path)));
+    is_saved = chessSavePlayersLevels(chess, file) == CHESS_SUCCESS &&
+               readWholeStream(file, levels, sizeof(levels));
+    fclose(file);
+    remove(path);
+    chessDestroy(chess);
+    ASSERT_TEST(is_saved && strcmp(levels, "3 6.00\n"
+                                           "5 4.00\n"
+                                           "1 2.00\n"
+                                           "2 2.00\n"
+                                           "6 2.00\n"
+                                           "4 -10.00\n") == 0);
+    return true;
+}
+
+
+bool testPlayerRankAndTopPlayers()
+{
+    // The sample levels are 4.67, -10, 4, -4 and 2 for players 1 to 5
+    ChessSystem chess = createSampleSystem();
+    ASSERT_TEST(chess != NULL);
+    int expected_ranks[] = { 0, 1, 5, 2, 4, 3 };
+    ChessResult result;
+    for (int player_id = 1 ; player_id <= 5 ; player_id++)
+    {
+        ASSERT_TEST_WITH_FREE(chessGetPlayerRank(chess, player_id, &result) ==
+                              expected_ranks[player_id] && result == CHESS_SUCCESS,
+                              chessDestroy(chess));
+    }
+    int top_players[8];
+    ASSERT_TEST_WITH_FREE(chessGetTopPlayers(chess, 3, top_players, &result) == 3 &&
+                          result == CHESS_SUCCESS && top_players[0] == 1 &&
+                          top_players[1] == 3 && top_players[2] == 5, chessDestroy(chess));
+    ASSERT_TEST_WITH_FREE(chessGetTopPlayers(chess, 8, top_players, &result) == 5 &&
+                          top_players[3] == 4 && top_players[4] == 2, chessDestroy(chess));
+
+    // The ranks follow removals - players 1 and 3 tie at 4, and players 4 and 5 have no games
+    ASSERT_TEST_WITH_FREE(chessRemoveTournament(chess, 2) == CHESS_SUCCESS,
+                          chessDestroy(chess));
+    ASSERT_TEST_WITH_FREE(chessGetPlayerRank(chess, 1, &result) == 1 &&
+                          chessGetPlayerRank(chess, 3, &result) == 2 &&
+                          chessGetPlayerRank(chess, 2, &result) == 3 &&
+                          chessGetTopPlayers(chess, 8, top_players, &result) == 3,
+                          chessDestroy(chess));
+    ASSERT_TEST_WITH_FREE(chessRemovePlayer(chess, 1) == CHESS_SUCCESS &&
+                          chessGetPlayerRank(chess, 3, &result) == 1 &&
+                          chessGetPlayerRank(chess, 1, &result) < 0 &&
+                          result == CHESS_PLAYER_NOT_EXIST, chessDestroy(chess));
+
+    ASSERT_TEST_WITH_FREE(chessGetPlayerRank(chess, 0, &result) < 0 &&
+                          result == CHESS_INVALID_ID &&
+                          chessGetTopPlayers(chess, 0, NULL, &result) == 0 &&
+                          result == CHESS_SUCCESS &&
+                          chessGetTopPlayers(chess, 1, NULL, &result) < 0 &&
+                          result == CHESS_NULL_ARGUMENT, chessDestroy(chess));
+    chessDestroy(chess);
+    return true;
+}
+
+
+bool testSnapshotRoundTrip()
+{
+    ChessSystem chess = createSampleSystem();
+    ASSERT_TEST(chess != NULL);
+    ASSERT_TEST_WITH_FREE(chessSaveSnapshot(chess, "unit_snapshot.bin") == CHESS_SUCCESS,
+                          chessDestroy(chess));
+    ASSERT_TEST_WITH_FREE(saveSystemOutput(chess, "unit_expected.txt"), chessDestroy(chess));
+    chessDestroy(chess);
+
+    ChessSystem loaded = chessLoadSnapshot("unit_snapshot.bin");
+    ASSERT_TEST(loaded != NULL);
+    ASSERT_TEST_WITH_FREE(saveSystemOutput(loaded, "unit_actual.txt"), chessDestroy(loaded));
+
+    // The loaded system goes on like the saved one
+    ChessResult result;
+    ASSERT_TEST_WITH_FREE(chessGetTournamentLeader(loaded, 2, &result) == 1, chessDestroy(loaded));
+    ASSERT_TEST_WITH_FREE(chessAddGame(loaded, 1, 1, 2, DRAW, 1) == CHESS_TOURNAMENT_ENDED,
+                          chessDestroy(loaded));
+    ASSERT_TEST_WITH_FREE(chessAddGame(loaded, 2, 4, 1, DRAW, 1) == CHESS_GAME_ALREADY_EXISTS,
+                          chessDestroy(loaded));
+    ASSERT_TEST_WITH_FREE(chessAddGame(loaded, 2, 5, 6, DRAW, 1) == CHESS_SUCCESS,
+                          chessDestroy(loaded));
+    chessDestroy(loaded);
+
+    bool is_equal = filesAreEqual("unit_expected.txt", "unit_actual.txt");
+    remove("unit_snapshot.bin");
+    remove("unit_expected.txt");
+    remove("unit_actual.txt");
+    ASSERT_TEST(is_equal);
+    return true;
+}
+
+
+bool testSnapshotCorrupted()
+{
+    ChessSystem chess = createSampleSystem();
+    ASSERT_TEST(chess != NULL);
+    ASSERT_TEST_WITH_FREE(chessSaveSnapshot(chess, "unit_snapshot.bin") == CHESS_SUCCESS,
+                          chessDestroy(chess));
+    chessDestroy(chess);
+
+    // The amount of tournaments follows the magic, the version and the journal sequence.
+    // A count that can't fit in the file fails before anything is allocated for it
+    ASSERT_TEST(overwriteFileInt("unit_snapshot.bin", 12, 0x7fffffff));
+    ASSERT_TEST(chessLoadSnapshot("unit_snapshot.bin") == NULL);
+    ASSERT_TEST(overwriteFileInt("unit_snapshot.bin", 12, 0xffffffff));
+    ASSERT_TEST(chessLoadSnapshot("unit_snapshot.bin") == NULL);
+
+    // A count that fits, but is wrong, fails the checksum
+    ASSERT_TEST(overwriteFileInt("unit_snapshot.bin", 12, 1));
+    ASSERT_TEST(chessLoadSnapshot("unit_snapshot.bin") == NULL);
+
+    // Another version
+    ASSERT_TEST(overwriteFileInt("unit_snapshot.bin", 12, 2));
+    ASSERT_TEST(overwriteFileInt("unit_snapshot.bin", 4, 1));
+    ASSERT_TEST(chessLoadSnapshot("unit_snapshot.bin") == NULL);
+    remove("unit_snapshot.bin");
+    ASSERT_TEST(chessLoadSnapshot("unit_snapshot.bin") == NULL);
+    return true;
+}
+
+
+bool testJournalRecovery()
+{
+    remove("unit_journal.bin");
+    ChessSystem chess = chessCreate();
+    ASSERT_TEST(chess != NULL);
+    ASSERT_TEST_WITH_FREE(chessJournalOpen(chess, "unit_journal.bin", 3, 0) == CHESS_SUCCESS &&
+                          addSampleCalls(chess), chessDestroy(chess));
+
+    // The snapshot has the calls so far, and the journal the calls after it
+    ASSERT_TEST_WITH_FREE(chessSaveSnapshot(chess, "unit_snapshot.bin") == CHESS_SUCCESS,
+                          chessDestroy(chess));
+    ASSERT_TEST_WITH_FREE(chessAddTournament(chess, 3, 1, "Rome") == CHESS_SUCCESS &&
+                          chessAddGame(chess, 3, 6, 2, FIRST_PLAYER, 40) == CHESS_SUCCESS &&
+                          chessRemovePlayer(chess, 4) == CHESS_SUCCESS &&
+                          chessRemoveTournament(chess, 2) == CHESS_SUCCESS &&
+                          chessEndTournament(chess, 3) == CHESS_SUCCESS, chessDestroy(chess));
+    ASSERT_TEST_WITH_FREE(saveSystemOutput(chess, "unit_expected.txt"), chessDestroy(chess));
+    ASSERT_TEST_WITH_FREE(chessJournalClose(chess) == CHESS_SUCCESS, chessDestroy(chess));
+    chessDestroy(chess);
+
+    ChessSystem recovered = chessRecover("unit_snapshot.bin", "unit_journal.bin");
+    ASSERT_TEST(recovered != NULL);
+    ASSERT_TEST_WITH_FREE(saveSystemOutput(recovered, "unit_actual.txt"),
+                          chessDestroy(recovered));
+    bool is_equal = filesAreEqual("unit_expected.txt", "unit_actual.txt");
+
+    // The journal continues where it stopped
+    ASSERT_TEST_WITH_FREE(chessJournalOpen(recovered, "unit_journal.bin", 0, 0) == CHESS_SUCCESS &&
+                          chessAddTournament(recovered, 4, 1, "Oslo") == CHESS_SUCCESS,
+                          chessDestroy(recovered));
+    chessDestroy(recovered);
+    recovered = chessRecover("unit_snapshot.bin", "unit_journal.bin");
+    ASSERT_TEST(recovered != NULL);
+    ASSERT_TEST_WITH_FREE(chessAddTournament(recovered, 4, 1, "Oslo") ==
+                          CHESS_TOURNAMENT_ALREADY_EXISTS, chessDestroy(recovered));
+    chessDestroy(recovered);
+
+    // Without the snapshot, the calls before the journal are missing
+    ASSERT_TEST(chessRecover(NULL, "unit_journal.bin") == NULL);
+
+    remove("unit_journal.bin");
+    remove("unit_snapshot.bin");
+    remove("unit_expected.txt");
+    remove("unit_actual.txt");
+    ASSERT_TEST(is_equal);
+    return true;
+}
+
+
+bool testJournalCorrupted()
+{
+    remove("unit_journal.bin");
+    ChessSystem chess = chessCreate();
+    ASSERT_TEST(chess != NULL);
+    ASSERT_TEST_WITH_FREE(chessJournalOpen(chess, "unit_journal.bin", 0, 0) == CHESS_SUCCESS &&
+                          chessAddTournament(chess, 1, 4, "London") == CHESS_SUCCESS &&
+                          chessAddTournament(chess, 2, 4, "Paris") == CHESS_SUCCESS,
+                          chessDestroy(chess));
+    chessDestroy(chess);
+
+    // The location length of the first record follows the header (magic and version), the
+    // sequence, the type and two ints. A length longer than the file makes the record cut,
+    // so the journal ends before it
+    ASSERT_TEST(overwriteFileInt("unit_journal.bin", 24, 0x7ffffff0));
+    ChessSystem recovered = chessRecover(NULL, "unit_journal.bin");
+    ASSERT_TEST(recovered != NULL);
+    ASSERT_TEST_WITH_FREE(chessAddGame(recovered, 1, 1, 2, DRAW, 1) == CHESS_TOURNAMENT_NOT_EXIST,
+                          chessDestroy(recovered));
+    ASSERT_TEST_WITH_FREE(chessAddGame(recovered, 2, 1, 2, DRAW, 1) == CHESS_TOURNAMENT_NOT_EXIST,
+                          chessDestroy(recovered));
+    chessDestroy(recovered);
+
+    // A length that fits, but is wrong, fails the checksum of the record
+    ASSERT_TEST(overwriteFileInt("unit_journal.bin", 24, 2));
+    recovered = chessRecover(NULL, "unit_journal.bin");
+    ASSERT_TEST(recovered != NULL);
+    ASSERT_TEST_WITH_FREE(chessAddGame(recovered, 1, 1, 2, DRAW, 1) == CHESS_TOURNAMENT_NOT_EXIST,
+                          chessDestroy(recovered));
+    chessDestroy(recovered);
+
+    // Restoring the length restores both records
+    ASSERT_TEST(overwriteFileInt("unit_journal.bin", 24, 6));
+    recovered = chessRecover(NULL, "unit_journal.bin");
+    ASSERT_TEST(recovered != NULL);
+    ASSERT_TEST_WITH_FREE(chessAddGame(recovered, 2, 1, 2, DRAW, 1) == CHESS_SUCCESS,
+                          chessDestroy(recovered));
+    chessDestroy(recovered);
+    remove("unit_journal.bin");
+    return true;
+}
+
+
+int main()
+{
+    RUN_TEST(testEndTournamentWithNoPlayersLeft, "testEndTournamentWithNoPlayersLeft");
+    RUN_TEST(testRemoveTournamentAndPlayer, "testRemoveTournamentAndPlayer");
+    RUN_TEST(testAddGamesLikeAddGame, "testAddGamesLikeAddGame");
+    RUN_TEST(testLoadGamesFromFile, "testLoadGamesFromFile");
+    RUN_TEST(testLoadGamesFromLargeFile, "testLoadGamesFromLargeFile");
+    RUN_TEST(testSavePlayersLevelsOrder, "testSavePlayersLevelsOrder");
+    RUN_TEST(testPlayerRankAndTopPlayers, "testPlayerRankAndTopPlayers");
+    RUN_TEST(testSnapshotRoundTrip, "testSnapshotRoundTrip");
+    RUN_TEST(testSnapshotCorrupted, "testSnapshotCorrupted");
+    RUN_TEST(testJournalRecovery, "testJournalRecovery");
+    RUN_TEST(testJournalCorrupted, "testJournalCorrupted");
+    return 0;
+}
@@ -0,0 +1,182 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "mtm_map/concurrentMap.h"
+#include "test_utilities.h"
+
+#define CONCURRENT_TEST_THREADS 4
+#define CONCURRENT_TEST_KEYS 1000
+#define CONCURRENT_TEST_SHARDS 8
+#define CONCURRENT_TEST_COUNTER_KEY 0
+
+
+/** Function to be used for copying an int as a data element of the map */
+static MapDataElement copyInt(MapDataElement number)
+{
+    int *copy = malloc(sizeof(*copy));
+    if (copy != NULL)
+    {
+        *copy = *(int*)number;
+    }
+    return copy;
+}
+
+/** Function to be used by the map for freeing elements */
+static void freeInt(MapDataElement number)
+{
+    free(number);
+}
+
+/** concurrentMapUpdate function - adds the int given as context to the data */
+static bool addToInt(MapKeyElement key, MapDataElement data, void *context)
+{
+    *(int*)data += *(int*)context;
+    return true;
+}
+
+/** concurrentMapForEach function - sums the data of the elements */
+static bool sumInts(MapKeyElement key, MapDataElement data, void *context)
+{
+    *(long*)context += *(int*)data;
+    return true;
+}
+
+// helper struct - the map a thread works on, and the keys it inserts
+typedef struct concurrent_test_thread_t {
+    ConcurrentMap map;
+    int first_key;
+    bool is_failed;
+} ConcurrentTestThread;
+
+/** Thread function - inserts keys of its own, and adds to the shared counter */
+static void *insertAndCount(void *argument)
+{
+    ConcurrentTestThread *thread = argument;
+    int one = 1;
+    for (int i = 0 ; i < CONCURRENT_TEST_KEYS ; i++)
+    {
+        int key = thread->first_key + i;
+        if (concurrentMapPut(thread->map, &key, &key) != MAP_SUCCESS)
+        {
+            thread->is_failed = true;
+        }
+        int counter_key = CONCURRENT_TEST_COUNTER_KEY;
+        if (concurrentMapUpdate(thread->map, &counter_key, addToInt, &one) != MAP_SUCCESS)
+        {
+            thread->is_failed = true;
+        }
+        int *copy = concurrentMapGetCopy(thread->map, &key);
+        if (copy == NULL || *copy != key)
+        {
+            thread->is_failed = true;
+        }
+        free(copy);
+    }
+    return NULL;
+}
+
+
+bool testConcurrentMapBasic()
+{
+    ConcurrentMap map = concurrentMapCreateIntKeyed(copyInt, freeInt, CONCURRENT_TEST_SHARDS);
+    ASSERT_TEST(map != NULL);
+    for (int key = 1 ; key <= CONCURRENT_TEST_KEYS ; key++)
+    {
+        ASSERT_TEST_WITH_FREE(concurrentMapPut(map, &key, &key) == MAP_SUCCESS,
+                              concurrentMapDestroy(map));
+    }
+    int *moved = copyInt(&(int){ -1 });
+    int moved_key = -1;
+    ASSERT_TEST_WITH_FREE(moved != NULL && concurrentMapPutMove(map, &moved_key, moved) ==
+                          MAP_SUCCESS, (free(moved), concurrentMapDestroy(map)));
+    ASSERT_TEST_WITH_FREE(concurrentMapGetSize(map) == CONCURRENT_TEST_KEYS + 1,
+                          concurrentMapDestroy(map));
+
+    // Copies belong to the caller, and updates are seen by later copies
+    int key = 7;
+    int seven = 7;
+    int *copy = concurrentMapGetCopy(map, &key);
+    ASSERT_TEST_WITH_FREE(copy != NULL && *copy == 7, (free(copy), concurrentMapDestroy(map)));
+    free(copy);
+    ASSERT_TEST_WITH_FREE(concurrentMapUpdate(map, &key, addToInt, &seven) == MAP_SUCCESS,
+                          concurrentMapDestroy(map));
+    copy = concurrentMapGetCopy(map, &key);
+    ASSERT_TEST_WITH_FREE(copy != NULL && *copy == 14, (free(copy), concurrentMapDestroy(map)));
+    free(copy);
+
+    int missing_key = CONCURRENT_TEST_KEYS + 1;
+    ASSERT_TEST_WITH_FREE(!concurrentMapContains(map, &missing_key) &&
+                          concurrentMapGetCopy(map, &missing_key) == NULL &&
+                          concurrentMapUpdate(map, &missing_key, addToInt, &seven) ==
+                          MAP_ITEM_DOES_NOT_EXIST, concurrentMapDestroy(map));
+
+    // Every element is visited once
+    long sum = 0;
+    ASSERT_TEST_WITH_FREE(concurrentMapForEach(map, sumInts, &sum) == MAP_SUCCESS &&
+                          sum == (long)CONCURRENT_TEST_KEYS * (CONCURRENT_TEST_KEYS + 1) / 2 + 6,
+                          concurrentMapDestroy(map));
+
+    ASSERT_TEST_WITH_FREE(concurrentMapRemove(map, &key) == MAP_SUCCESS &&
+                          concurrentMapRemove(map, &key) == MAP_ITEM_DOES_NOT_EXIST &&
+                          !concurrentMapContains(map, &key), concurrentMapDestroy(map));
+    ASSERT_TEST_WITH_FREE(concurrentMapClear(map) == MAP_SUCCESS &&
+                          concurrentMapGetSize(map) == 0, concurrentMapDestroy(map));
+    concurrentMapDestroy(map);
+    return true;
+}
+
+
+bool testConcurrentMapThreads()
+{
+    ConcurrentMap map = concurrentMapCreateIntKeyed(copyInt, freeInt, CONCURRENT_TEST_SHARDS);
+    ASSERT_TEST(map != NULL);
+    int counter = 0;
+    int counter_key = CONCURRENT_TEST_COUNTER_KEY;
+    ASSERT_TEST_WITH_FREE(concurrentMapPut(map, &counter_key, &counter) == MAP_SUCCESS,
+                          concurrentMapDestroy(map));
+
+    pthread_t threads[CONCURRENT_TEST_THREADS];
+    ConcurrentTestThread arguments[CONCURRENT_TEST_THREADS];
+    int amount_started = 0;
+    for ( ; amount_started < CONCURRENT_TEST_THREADS ; amount_started++)
+    {
+        arguments[amount_started].map       = map;
+        arguments[amount_started].first_key = 1 + amount_started * CONCURRENT_TEST_KEYS;
+        arguments[amount_started].is_failed = false;
+        if (pthread_create(&threads[amount_started], NULL, insertAndCount,
+                           &arguments[amount_started]) != 0)
+        {
+            break;
+        }
+    }
+    bool is_failed = amount_started < CONCURRENT_TEST_THREADS;
+    for (int i = 0 ; i < amount_started ; i++)
+    {
+        pthread_join(threads[i], NULL);
+        is_failed = is_failed || arguments[i].is_failed;
+    }
+    ASSERT_TEST_WITH_FREE(!is_failed, concurrentMapDestroy(map));
+
+    // No insertion nor update was lost
+    int *total = concurrentMapGetCopy(map, &counter_key);
+    ASSERT_TEST_WITH_FREE(total != NULL &&
+                          *total == CONCURRENT_TEST_THREADS * CONCURRENT_TEST_KEYS,
+                          (free(total), concurrentMapDestroy(map)));
+    free(total);
+    ASSERT_TEST_WITH_FREE(concurrentMapGetSize(map) ==
+                          CONCURRENT_TEST_THREADS * CONCURRENT_TEST_KEYS + 1,
+                          concurrentMapDestroy(map));
+    concurrentMapDestroy(map);
+    return true;
+}
+
+
+int main()
+{
+    RUN_TEST(testConcurrentMapBasic, "testConcurrentMapBasic");
+    RUN_TEST(testConcurrentMapThreads, "testConcurrentMapThreads");
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "idFilter.h"
+#include "test_utilities.h"
+
+#define ID_FILTER_TEST_IDS 1000
+
+
+bool testIdFilterNoFalseNegatives()
+{
+    IdFilter filter = idFilterCreate();
+    ASSERT_TEST(filter != NULL);
+    ASSERT_TEST_WITH_FREE(idFilterReset(filter, 2 * ID_FILTER_TEST_IDS) == ID_FILTER_SUCCESS,
+                          idFilterDestroy(filter));
+
+    // The even ids are added
+    for (int id = 2 ; id <= 2 * ID_FILTER_TEST_IDS ; id += 2)
+    {
+        idFilterAdd(filter, id);
+    }
+    ASSERT_TEST_WITH_FREE(!idFilterIsFull(filter), idFilterDestroy(filter));
+    int false_positives = 0;
+    for (int id = 1 ; id <= 2 * ID_FILTER_TEST_IDS ; id++)
+    {
+        bool may_contain = idFilterMayContain(filter, id);
+        ASSERT_TEST_WITH_FREE(id % 2 == 1 || may_contain, idFilterDestroy(filter));
+        false_positives += id % 2 == 1 && may_contain;
+    }
+    ASSERT_TEST_WITH_FREE(false_positives < ID_FILTER_TEST_IDS / 10, idFilterDestroy(filter));
+
+    // Removing ids keeps the rest
+    for (int id = 4 ; id <= 2 * ID_FILTER_TEST_IDS ; id += 4)
+    {
+        idFilterRemove(filter, id);
+    }
+    int removed_found = 0;
+    for (int id = 2 ; id <= 2 * ID_FILTER_TEST_IDS ; id += 2)
+    {
+        bool may_contain = idFilterMayContain(filter, id);
+        ASSERT_TEST_WITH_FREE(id % 4 == 0 || may_contain, idFilterDestroy(filter));
+        removed_found += id % 4 == 0 && may_contain;
+    }
+    ASSERT_TEST_WITH_FREE(removed_found < ID_FILTER_TEST_IDS / 10, idFilterDestroy(filter));
+    idFilterDestroy(filter);
+    return true;
+}
+
+
+bool testIdFilterFullAndDisabled()
+{
+    IdFilter filter = idFilterCreate();
+    ASSERT_TEST(filter != NULL);
+    ASSERT_TEST_WITH_FREE(idFilterReset(filter, ID_FILTER_TEST_IDS) == ID_FILTER_SUCCESS,
+                          idFilterDestroy(filter));
+
+    // Adding more ids than the filter was reset for makes it full
+    int id = 1;
+    for ( ; id <= 10 * ID_FILTER_TEST_IDS && !idFilterIsFull(filter) ; id++)
+    {
+        idFilterAdd(filter, id);
+    }
+    ASSERT_TEST_WITH_FREE(idFilterIsFull(filter) && id > ID_FILTER_TEST_IDS / 2,
+                          idFilterDestroy(filter));
+
+    // A disabled filter may contain every id, until it's reset
+    idFilterDisable(filter);
+    ASSERT_TEST_WITH_FREE(idFilterIsFull(filter) && idFilterMayContain(filter, -5) &&
+                          idFilterMayContain(filter, 20 * ID_FILTER_TEST_IDS),
+                          idFilterDestroy(filter));
+    ASSERT_TEST_WITH_FREE(idFilterReset(filter, 10 * ID_FILTER_TEST_IDS) == ID_FILTER_SUCCESS &&
+                          !idFilterIsFull(filter), idFilterDestroy(filter));
+    int found = 0;
+    for (id = 1 ; id <= ID_FILTER_TEST_IDS ; id++)
+    {
+        found += idFilterMayContain(filter, id);
+    }
+    ASSERT_TEST_WITH_FREE(found == 0, idFilterDestroy(filter));
+    idFilterDestroy(filter);
+
+    ASSERT_TEST(idFilterMayContain(NULL, 1) && idFilterReset(NULL, 1) == ID_FILTER_NULL_ARGUMENT);
+    return true;
+}
+
+
+int main()
+{
+    RUN_TEST(testIdFilterNoFalseNegatives, "testIdFilterNoFalseNegatives");
+    RUN_TEST(testIdFilterFullAndDisabled, "testIdFilterFullAndDisabled");
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "leaderboard.h"
+#include "test_utilities.h"
+
+#define LEADERBOARD_TEST_PLAYERS 500
+#define LEADERBOARD_TEST_UPDATES 2000
+#define LEADERBOARD_TEST_TOP 10
+
+
+// helper struct - the level of a player, as given to the leaderboard
+typedef struct leaderboard_test_player_t {
+    int level_score;
+    int amount_of_games;
+} LeaderboardTestPlayer;
+
+// helper struct - the players expected by a walk of the leaderboard, and how far it got
+typedef struct leaderboard_test_walk_t {
+    Leaderboard leaderboard;
+    int amount_visited;
+    int amount_to_visit;
+    bool is_failed;
+} LeaderboardTestWalk;
+
+
+// Checks whether the first player ranks above the second one, by the definition
+static bool testPlayerIsAbove(LeaderboardTestPlayer *players, int first_id, int second_id)
+{
+    long long first_product  = (long long)players[first_id].level_score *
+                               players[second_id].amount_of_games;
+    long long second_product = (long long)players[second_id].level_score *
+                               players[first_id].amount_of_games;
+    return first_product > second_product ||
+           (first_product == second_product && first_id < second_id);
+}
+
+// Returns the rank of a player by counting the ranked players above it
+static int testPlayerGetRank(LeaderboardTestPlayer *players, int player_id)
+{
+    if (players[player_id].amount_of_games == 0)
+    {
+        return LEADERBOARD_NOT_RANKED;
+    }
+    int rank = 1;
+    for (int other_id = 1 ; other_id <= LEADERBOARD_TEST_PLAYERS ; other_id++)
+    {
+        rank += players[other_id].amount_of_games > 0 &&
+                testPlayerIsAbove(players, other_id, player_id);
+    }
+    return rank;
+}
+
+/** visitLeaderboardPlayer function - checks the players are visited by rank */
+static bool checkVisitedRank(int player_id, int level_score, int amount_of_games, void *walk)
+{
+    LeaderboardTestWalk *test_walk = walk;
+    (test_walk->amount_visited)++;
+    if (leaderboardGetRank(test_walk->leaderboard, player_id) != test_walk->amount_visited ||
+        amount_of_games <= 0)
+    {
+        test_walk->is_failed = true;
+    }
+    return test_walk->amount_visited < test_walk->amount_to_visit;
+}
+
+
+bool testLeaderboardExactOrder()
+{
+    Leaderboard leaderboard = leaderboardCreate();
+    ASSERT_TEST(leaderboard != NULL);
+    for (int player_id = 1 ; player_id <= 5 ; player_id++)
+    {
+        ASSERT_TEST_WITH_FREE(leaderboardAdd(leaderboard, player_id) == LEADERBOARD_SUCCESS,
+                              leaderboardDestroy(leaderboard));
+    }
+    ASSERT_TEST_WITH_FREE(leaderboardAdd(leaderboard, 3) == LEADERBOARD_PLAYER_ALREADY_EXISTS &&
+                          leaderboardGetSize(leaderboard) == 0 &&
+                          leaderboardGetRank(leaderboard, 1) == LEADERBOARD_NOT_RANKED,
+                          leaderboardDestroy(leaderboard));
+
+    // Player 2 is above 2 by less than any rounding, players 1 and 3 are exactly 2,
+    // player 4 has no games, and player 5 is negative
+    ASSERT_TEST_WITH_FREE(leaderboardUpdate(leaderboard, 1, 2, 1) == LEADERBOARD_SUCCESS &&
+                          leaderboardUpdate(leaderboard, 2, 2000001, 1000000) ==
+                          LEADERBOARD_SUCCESS &&
+                          leaderboardUpdate(leaderboard, 3, 4, 2) == LEADERBOARD_SUCCESS &&
+                          leaderboardUpdate(leaderboard, 5, -10, 1) == LEADERBOARD_SUCCESS,
+                          leaderboardDestroy(leaderboard));
+    ASSERT_TEST_WITH_FREE(leaderboardGetSize(leaderboard) == 4 &&
+                          leaderboardGetRank(leaderboard, 2) == 1 &&
+                          leaderboardGetRank(leaderboard, 1) == 2 &&
+                          leaderboardGetRank(leaderboard, 3) == 3 &&
+                          leaderboardGetRank(leaderboard, 5) == 4 &&
+                          leaderboardGetRank(leaderboard, 4) == LEADERBOARD_NOT_RANKED,
+                          leaderboardDestroy(leaderboard));
+
+    // A player with no games left is not ranked anymore
+    ASSERT_TEST_WITH_FREE(leaderboardUpdate(leaderboard, 2, 0, 0) == LEADERBOARD_SUCCESS &&
+                          leaderboardGetRank(leaderboard, 2) == LEADERBOARD_NOT_RANKED &&
+                          leaderboardGetRank(leaderboard, 1) == 1 &&
+                          leaderboardGetSize(leaderboard) == 3, leaderboardDestroy(leaderboard));
+    ASSERT_TEST_WITH_FREE(leaderboardRemove(leaderboard, 1) == LEADERBOARD_SUCCESS &&
+                          leaderboardRemove(leaderboard, 1) == LEADERBOARD_PLAYER_NOT_EXIST &&
+                          leaderboardUpdate(leaderboard, 1, 2, 1) ==
+                          LEADERBOARD_PLAYER_NOT_EXIST &&
+                          leaderboardGetRank(leaderboard, 3) == 1 &&
+                          leaderboardGetSize(leaderboard) == 2, leaderboardDestroy(leaderboard));
+    leaderboardDestroy(leaderboard);
+
+    ASSERT_TEST(leaderboardAdd(NULL, 1) == LEADERBOARD_NULL_ARGUMENT &&
+                leaderboardGetRank(NULL, 1) == LEADERBOARD_INVALID_INPUT &&
+                leaderboardGetSize(NULL) == LEADERBOARD_INVALID_INPUT);
+    return true;
+}
+
+
+bool testLeaderboardRanks()
+{
+    Leaderboard leaderboard = leaderboardCreate();
+    ASSERT_TEST(leaderboard != NULL);
+    LeaderboardTestPlayer players[LEADERBOARD_TEST_PLAYERS + 1] = { { 0, 0 } };
+    for (int player_id = 1 ; player_id <= LEADERBOARD_TEST_PLAYERS ; player_id++)
+    {
+        ASSERT_TEST_WITH_FREE(leaderboardAdd(leaderboard, player_id) == LEADERBOARD_SUCCESS,
+                              leaderboardDestroy(leaderboard));
+    }
+
+    // Random levels from a few values, so there are many ties, some players without games
+    unsigned int random = 1;
+    for (int i = 0 ; i < LEADERBOARD_TEST_UPDATES ; i++)
+    {
+        random = random * 1103515245u + 12345u;
+        int player_id = 1 + (random >> 8) % LEADERBOARD_TEST_PLAYERS;
+        players[player_id].amount_of_games = (random >> 4) % 5;
+        players[player_id].level_score     = players[player_id].amount_of_games == 0 ? 0 :
+                                             (int)((random >> 16) % 21) - 10;
+        ASSERT_TEST_WITH_FREE(leaderboardUpdate(leaderboard, player_id,
+                                                players[player_id].level_score,
+                                                players[player_id].amount_of_games) ==
+                              LEADERBOARD_SUCCESS, leaderboardDestroy(leaderboard));
+    }
+
+    int amount_ranked = 0;
+    for (int player_id = 1 ; player_id <= LEADERBOARD_TEST_PLAYERS ; player_id++)
+    {
+        ASSERT_TEST_WITH_FREE(leaderboardGetRank(leaderboard, player_id) ==
+                              testPlayerGetRank(players, player_id),
+                              leaderboardDestroy(leaderboard));
+        amount_ranked += players[player_id].amount_of_games > 0;
+    }
+    ASSERT_TEST_WITH_FREE(leaderboardGetSize(leaderboard) == amount_ranked,
+                          leaderboardDestroy(leaderboard));
+
+    // A walk visits the ranked players in order, and can stop early
+    LeaderboardTestWalk walk = { leaderboard, 0, LEADERBOARD_TEST_PLAYERS + 1, false };
+    ASSERT_TEST_WITH_FREE(leaderboardForEach(leaderboard, checkVisitedRank, &walk) ==
+                          LEADERBOARD_SUCCESS && !walk.is_failed &&
+                          walk.amount_visited == amount_ranked, leaderboardDestroy(leaderboard));
+    LeaderboardTestWalk top_walk = { leaderboard, 0, LEADERBOARD_TEST_TOP, false };
+    ASSERT_TEST_WITH_FREE(leaderboardForEach(leaderboard, checkVisitedRank, &top_walk) ==
+                          LEADERBOARD_SUCCESS && !top_walk.is_failed &&
+                          top_walk.amount_visited == LEADERBOARD_TEST_TOP,
+                          leaderboardDestroy(leaderboard));
+    leaderboardDestroy(leaderboard);
+    return true;
+}
+
+
+int main()
+{
+    RUN_TEST(testLeaderboardExactOrder, "testLeaderboardExactOrder");
+    RUN_TEST(testLeaderboardRanks, "testLeaderboardRanks");
+    return 0;
+}
@@ -0,0 +1,1367 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+
+#include "mtm_map/map.h"
+#include "mtm_map/typedMap.h"
+#include "test_utilities.h"
+
+#define MAP_TEST_SIZE 100
+#define MAP_BALANCE_TEST_SIZE 1000
+
+
+/** Function to be used for copying an int as a data element of the map */
+static MapDataElement copyInt(MapDataElement number)
+{
+    int *copy = malloc(sizeof(*copy));
+    if (copy != NULL)
+    {
+        *copy = *(int*)number;
+    }
+    return copy;
+}
+
+/** Function to be used by the map for freeing elements */
+static void freeInt(MapDataElement number)
+{
+    free(number);
+}
+
+/** Typed copy of an int, for the typed maps */
+static int *copyIntPointer(int *number)
+{
+    return copyInt(number);
+}
+
+/** Typed free of an int, for the typed maps */
+static void freeIntPointer(int *number)
+{
+    free(number);
+}
+
+DEFINE_TYPED_MAP(IntTreeMap, int*, copyIntPointer, freeIntPointer)
+DEFINE_TYPED_HASH_MAP(IntHashMap, int*, copyIntPointer, freeIntPointer)
+
+/** Returns the data of a key, read without copying the map's elements. -1 if the key is not
+ *  in the map */
+static int readInt(Map map, int key)
+{
+    const int *data = mapGetReadOnly(map, &key);
+    return data == NULL ? -1 : *data;
+}
+
+/** Compares int keys */
+static int compareInt(MapKeyElement first, MapKeyElement second)
+{
+    return *(int*)first - *(int*)second;
+}
+
+/** Hashes an int key */
+static unsigned int hashInt(MapKeyElement key)
+{
+    return (unsigned int)*(int*)key;
+}
+
+/** Creates an empty int keyed map of int data, which frees its data with free_data */
+static Map createEmptyMap(bool is_hashed, freeMapDataElements free_data)
+{
+    return is_hashed ? mapCreateIntKeyedHashed(copyInt, free_data) :
+                       mapCreateIntKeyed(copyInt, free_data);
+}
+
+/** Creates an int keyed map of the keys 1..size, where the data of every key is 10 * key */
+static Map createFilledMap(bool is_hashed, int size)
+{
+    Map map = createEmptyMap(is_hashed, freeInt);
+    for (int key = 1 ; map != NULL && key <= size ; key++)
+    {
+        int data = 10 * key;
+        if (mapPut(map, &key, &data) != MAP_SUCCESS)
+        {
+            mapDestroy(map);
+            return NULL;
+        }
+    }
+    return map;
+}
+
+/** Checks that the keys of a map are visited in ascending order, and returns their amount */
+static int countAscendingKeys(Map map)
+{
+    int count = 0;
+    int previous_key = 0;
+    MapCursor cursor;
+    for (bool has_key = mapCursorBeginReadOnly(map, &cursor) ; has_key ;
+         has_key = mapCursorNext(&cursor))
+    {
+        int key = *(int*)mapCursorKey(&cursor);
+        if (count > 0 && key <= previous_key)
+        {
+            return -1;
+        }
+        previous_key = key;
+        count++;
+    }
+    return count;
+}
+
+
+/** The orders keys are put in and removed in, by the balance tests */
+typedef enum {
+    KEYS_ASCENDING,
+    KEYS_DESCENDING,
+    KEYS_ZIG_ZAG        // 1, size, 2, size - 1, ...
+} KeyOrder;
+
+/** Returns the key at an index of an order of the keys 1..size */
+static int keyAt(KeyOrder order, int index, int size)
+{
+    switch (order)
+    {
+        case KEYS_ASCENDING:
+            return index + 1;
+        case KEYS_DESCENDING:
+            return size - index;
+        default:
+            return index % 2 == 0 ? index / 2 + 1 : size - index / 2;
+    }
+}
+
+#ifdef MAP_STATS
+/** Returns the greatest height an AVL tree of the given size may have */
+static int maxAvlHeight(int size)
+{
+    // The fewest nodes an AVL tree of a height has - N(h) = N(h - 1) + N(h - 2) + 1
+    int height = 0;
+    int fewest_nodes = 0;
+    int previous_fewest_nodes = 0;
+    while (fewest_nodes + previous_fewest_nodes + 1 <= size)
+    {
+        int next_fewest_nodes = fewest_nodes + previous_fewest_nodes + 1;
+        previous_fewest_nodes = fewest_nodes;
+        fewest_nodes = next_fewest_nodes;
+        height++;
+    }
+    return height;
+}
+#endif
+
+/** Checks that a map holds 10 * key for the keys 1..size marked in is_in_map, and no
+ *  other key, in ascending order, and (in MAP_STATS builds) that no lookup passes more
+ *  nodes than an AVL tree of the map's size is high */
+static bool isBalancedMap(Map map, bool *is_in_map, int size)
+{
+    int amount = 0;
+    for (int key = 1 ; key <= size ; key++)
+    {
+#ifdef MAP_STATS
+        MapStats stats;
+        mapResetStats(map);
+#endif
+        if (readInt(map, key) != (is_in_map[key] ? 10 * key : -1))
+        {
+            return false;
+        }
+#ifdef MAP_STATS
+        // A lookup also checks the greatest key before it starts from the root
+        mapGetStats(map, &stats);
+        if (stats.nodes_traversed > maxAvlHeight(mapGetSize(map)) + 1)
+        {
+            return false;
+        }
+#endif
+        amount += is_in_map[key];
+    }
+    return mapGetSize(map) == amount && countAscendingKeys(map) == amount;
+}
+
+
+static bool checkBalance(KeyOrder put_order, KeyOrder remove_order)
+{
+    bool is_in_map[MAP_BALANCE_TEST_SIZE + 1] = { false };
+    Map map = mapCreate(copyInt, copyInt, freeInt, freeInt, compareInt);
+    ASSERT_TEST(map != NULL);
+
+    for (int i = 0 ; i < MAP_BALANCE_TEST_SIZE ; i++)
+    {
+        int key = keyAt(put_order, i, MAP_BALANCE_TEST_SIZE);
+        int data = 10 * key;
+        ASSERT_TEST_WITH_FREE(mapPut(map, &key, &data) == MAP_SUCCESS, mapDestroy(map));
+        is_in_map[key] = true;
+    }
+    ASSERT_TEST_WITH_FREE(isBalancedMap(map, is_in_map, MAP_BALANCE_TEST_SIZE),
+                          mapDestroy(map));
+
+    // Removing half of the keys from one side (or both) rotates the rest
+    for (int i = 0 ; i < MAP_BALANCE_TEST_SIZE / 2 ; i++)
+    {
+        int key = keyAt(remove_order, i, MAP_BALANCE_TEST_SIZE);
+        ASSERT_TEST_WITH_FREE(mapRemove(map, &key) == MAP_SUCCESS, mapDestroy(map));
+        is_in_map[key] = false;
+    }
+    ASSERT_TEST_WITH_FREE(isBalancedMap(map, is_in_map, MAP_BALANCE_TEST_SIZE),
+                          mapDestroy(map));
+
+    // Removing every other key of the rest, then the rest of them
+    for (int parity = 0 ; parity <= 1 ; parity++)
+    {
+        for (int key = 1 + parity ; key <= MAP_BALANCE_TEST_SIZE ; key += 2)
+        {
+            if (is_in_map[key])
+            {
+                ASSERT_TEST_WITH_FREE(mapRemove(map, &key) == MAP_SUCCESS, mapDestroy(map));
+                is_in_map[key] = false;
+            }
+        }
+        ASSERT_TEST_WITH_FREE(isBalancedMap(map, is_in_map, MAP_BALANCE_TEST_SIZE),
+                              mapDestroy(map));
+    }
+    ASSERT_TEST_WITH_FREE(mapGetSize(map) == 0, mapDestroy(map));
+    mapDestroy(map);
+    return true;
+}
+
+
+bool testMapBalance()
+{
+    KeyOrder orders[] = { KEYS_ASCENDING, KEYS_DESCENDING, KEYS_ZIG_ZAG };
+    int amount_of_orders = sizeof(orders) / sizeof(*orders);
+    for (int i = 0 ; i < amount_of_orders ; i++)
+    {
+        for (int j = 0 ; j < amount_of_orders ; j++)
+        {
+            ASSERT_TEST(checkBalance(orders[i], orders[j]));
+        }
+    }
+    return true;
+}
+
+
+/** Hashes every key to the same bucket, so every lookup goes through collisions */
+static unsigned int hashCollide(MapKeyElement key)
+{
+    return 0;
+}
+
+
+static bool checkCreateHashed(hashMapKeyElements hash_key_func)
+{
+    Map map = mapCreateHashed(copyInt, copyInt, freeInt, freeInt, compareInt, hash_key_func);
+    ASSERT_TEST(map != NULL);
+
+    // More keys than the table starts with, put in a scrambled order
+    for (int i = 0 ; i < MAP_TEST_SIZE ; i++)
+    {
+        int key = (37 * i) % MAP_TEST_SIZE + 1;
+        int data = 10 * key;
+        ASSERT_TEST_WITH_FREE(mapPut(map, &key, &data) == MAP_SUCCESS, mapDestroy(map));
+    }
+    ASSERT_TEST_WITH_FREE(mapGetSize(map) == MAP_TEST_SIZE &&
+                          countAscendingKeys(map) == MAP_TEST_SIZE, mapDestroy(map));
+    for (int key = 1 ; key <= MAP_TEST_SIZE ; key++)
+    {
+        ASSERT_TEST_WITH_FREE(readInt(map, key) == 10 * key, mapDestroy(map));
+    }
+    int missing_key = MAP_TEST_SIZE + 1;
+    ASSERT_TEST_WITH_FREE(!mapContains(map, &missing_key) &&
+                          mapRemove(map, &missing_key) == MAP_ITEM_DOES_NOT_EXIST,
+                          mapDestroy(map));
+
+    // Removed keys leave the others reachable, and can be put again
+    for (int key = 2 ; key <= MAP_TEST_SIZE ; key += 2)
+    {
+        ASSERT_TEST_WITH_FREE(mapRemove(map, &key) == MAP_SUCCESS, mapDestroy(map));
+    }
+    ASSERT_TEST_WITH_FREE(mapGetSize(map) == MAP_TEST_SIZE / 2 &&
+                          countAscendingKeys(map) == MAP_TEST_SIZE / 2, mapDestroy(map));
+    for (int key = 1 ; key <= MAP_TEST_SIZE ; key++)
+    {
+        ASSERT_TEST_WITH_FREE(readInt(map, key) == (key % 2 == 0 ? -1 : 10 * key),
+                              mapDestroy(map));
+    }
+    for (int key = MAP_TEST_SIZE ; key >= 2 ; key -= 2)
+    {
+        int data = 10 * key;
+        ASSERT_TEST_WITH_FREE(mapPut(map, &key, &data) == MAP_SUCCESS, mapDestroy(map));
+    }
+    ASSERT_TEST_WITH_FREE(mapGetSize(map) == MAP_TEST_SIZE &&
+                          countAscendingKeys(map) == MAP_TEST_SIZE, mapDestroy(map));
+    for (int key = 1 ; key <= MAP_TEST_SIZE ; key++)
+    {
+        ASSERT_TEST_WITH_FREE(readInt(map, key) == 10 * key, mapDestroy(map));
+    }
+    mapDestroy(map);
+    return true;
+}
+
+
+bool testMapCreateHashed()
+{
+    ASSERT_TEST(mapCreateHashed(NULL, copyInt, freeInt, freeInt, compareInt, hashInt) == NULL &&
+                mapCreateHashed(copyInt, NULL, freeInt, freeInt, compareInt, hashInt) == NULL &&
+                mapCreateHashed(copyInt, copyInt, NULL, freeInt, compareInt, hashInt) == NULL &&
+                mapCreateHashed(copyInt, copyInt, freeInt, NULL, compareInt, hashInt) == NULL &&
+                mapCreateHashed(copyInt, copyInt, freeInt, freeInt, NULL, hashInt) == NULL &&
+                mapCreateHashed(copyInt, copyInt, freeInt, freeInt, compareInt, NULL) == NULL);
+    return checkCreateHashed(hashInt) && checkCreateHashed(hashCollide);
+}
+
+
+/** The amount of data elements createTenTimesKey made */
+static int created_elements = 0;
+
+/** Creates the data element of a missing key - 10 * key, like createFilledMap */
+static MapDataElement createTenTimesKey(MapKeyElement key)
+{
+    created_elements++;
+    int data = 10 * *(int*)key;
+    return copyInt(&data);
+}
+
+/** Fails to create the data element of a missing key */
+static MapDataElement createNothing(MapKeyElement key)
+{
+    return NULL;
+}
+
+
+static bool checkGetOrInsert(bool is_hashed)
+{
+    Map map = createFilledMap(is_hashed, MAP_TEST_SIZE);
+    ASSERT_TEST(map != NULL);
+
+    // An existing key keeps its data
+    int key = 7;
+    int data = -1;
+    bool inserted = true;
+    int *found = mapGetOrInsert(map, &key, &data, &inserted);
+    ASSERT_TEST_WITH_FREE(found != NULL && *found == 70 && !inserted &&
+                          mapGetSize(map) == MAP_TEST_SIZE, mapDestroy(map));
+
+    // Missing keys - after all the keys, before them and between them - get a copy of the data
+    int removed_key = MAP_TEST_SIZE / 2;
+    ASSERT_TEST_WITH_FREE(mapRemove(map, &removed_key) == MAP_SUCCESS, mapDestroy(map));
+    int new_keys[] = { MAP_TEST_SIZE + 1, 0, removed_key };
+    for (int i = 0 ; i < 3 ; i++)
+    {
+        found = mapGetOrInsert(map, &new_keys[i], &data, &inserted);
+        ASSERT_TEST_WITH_FREE(found != NULL && found != &data && *found == -1 && inserted,
+                              mapDestroy(map));
+        ASSERT_TEST_WITH_FREE(readInt(map, new_keys[i]) == -1, mapDestroy(map));
+    }
+    ASSERT_TEST_WITH_FREE(mapGetSize(map) == MAP_TEST_SIZE + 2 &&
+                          countAscendingKeys(map) == MAP_TEST_SIZE + 2, mapDestroy(map));
+
+    // The data returned is the map's, and may be changed. inserted may be NULL
+    found = mapGetOrInsert(map, &key, &data, NULL);
+    ASSERT_TEST_WITH_FREE(found != NULL, mapDestroy(map));
+    *found = 700;
+    ASSERT_TEST_WITH_FREE(readInt(map, key) == 700, mapDestroy(map));
+
+    ASSERT_TEST_WITH_FREE(mapGetOrInsert(NULL, &key, &data, NULL) == NULL &&
+                          mapGetOrInsert(map, NULL, &data, NULL) == NULL &&
+                          mapGetOrInsert(map, &key, NULL, NULL) == NULL, mapDestroy(map));
+    mapDestroy(map);
+    return true;
+}
+
+
+static bool checkGetOrCreate(bool is_hashed)
+{
+    Map map = createFilledMap(is_hashed, MAP_TEST_SIZE);
+    ASSERT_TEST(map != NULL);
+
+    // An existing key doesn't create anything
+    created_elements = 0;
+    int key = 7;
+    bool inserted = true;
+    int *found = mapGetOrCreate(map, &key, createTenTimesKey, &inserted);
+    ASSERT_TEST_WITH_FREE(found != NULL && *found == 70 && !inserted && created_elements == 0,
+                          mapDestroy(map));
+
+    // A missing key gets the created element itself
+    int new_key = MAP_TEST_SIZE + 5;
+    found = mapGetOrCreate(map, &new_key, createTenTimesKey, &inserted);
+    ASSERT_TEST_WITH_FREE(found != NULL && *found == 10 * new_key && inserted &&
+                          created_elements == 1 && mapGet(map, &new_key) == found &&
+                          mapGetSize(map) == MAP_TEST_SIZE + 1, mapDestroy(map));
+
+    // If creating fails nothing is inserted
+    int failed_key = -3;
+    ASSERT_TEST_WITH_FREE(mapGetOrCreate(map, &failed_key, createNothing, &inserted) == NULL &&
+                          !mapContains(map, &failed_key) &&
+                          mapGetSize(map) == MAP_TEST_SIZE + 1 &&
+                          countAscendingKeys(map) == MAP_TEST_SIZE + 1, mapDestroy(map));
+
+    ASSERT_TEST_WITH_FREE(mapGetOrCreate(NULL, &key, createTenTimesKey, NULL) == NULL &&
+                          mapGetOrCreate(map, NULL, createTenTimesKey, NULL) == NULL &&
+                          mapGetOrCreate(map, &key, NULL, NULL) == NULL, mapDestroy(map));
+    mapDestroy(map);
+    return true;
+}
+
+
+static bool checkGetOrInsertOnCopy(bool is_hashed)
+{
+    Map map = createFilledMap(is_hashed, MAP_TEST_SIZE);
+    ASSERT_TEST(map != NULL);
+    Map copy = mapCopy(map);
+    ASSERT_TEST_WITH_FREE(copy != NULL, mapDestroy(map));
+
+    // Data found in a copy is its own, and keys inserted to it don't reach the source
+    int key = 3;
+    int new_key = 2 * MAP_TEST_SIZE;
+    int data = 5;
+    int *found = mapGetOrInsert(copy, &key, &data, NULL);
+    int *created = mapGetOrCreate(copy, &new_key, createTenTimesKey, NULL);
+    ASSERT_TEST_WITH_FREE(found != NULL && created != NULL, (mapDestroy(map), mapDestroy(copy)));
+    *found = -3;
+    ASSERT_TEST_WITH_FREE(readInt(map, key) == 30 && readInt(copy, key) == -3 &&
+                          !mapContains(map, &new_key) && mapContains(copy, &new_key),
+                          (mapDestroy(map), mapDestroy(copy)));
+    mapDestroy(map);
+    mapDestroy(copy);
+    return true;
+}
+
+
+bool testMapGetOrInsert()
+{
+    return checkGetOrInsert(false) && checkGetOrInsert(true) &&
+           checkGetOrCreate(false) && checkGetOrCreate(true) &&
+           checkGetOrInsertOnCopy(false) && checkGetOrInsertOnCopy(true);
+}
+
+
+/** The amount of data elements freeCountedInt freed */
+static int freed_elements = 0;
+
+/** Frees an int data element, counting it */
+static void freeCountedInt(MapDataElement number)
+{
+    freed_elements++;
+    free(number);
+}
+
+
+static bool checkPutMove(bool is_hashed)
+{
+    Map map = createEmptyMap(is_hashed, freeCountedInt);
+    ASSERT_TEST(map != NULL);
+    freed_elements = 0;
+
+    // The map takes the data element itself, and a copy of the key
+    for (int key = 1 ; key <= MAP_TEST_SIZE ; key++)
+    {
+        int *data = copyInt(&key);
+        ASSERT_TEST_WITH_FREE(data != NULL, mapDestroy(map));
+        ASSERT_TEST_WITH_FREE(mapPutMove(map, &key, data) == MAP_SUCCESS, mapDestroy(map));
+        ASSERT_TEST_WITH_FREE(mapGetReadOnly(map, &key) == data, mapDestroy(map));
+    }
+    ASSERT_TEST_WITH_FREE(mapGetSize(map) == MAP_TEST_SIZE &&
+                          countAscendingKeys(map) == MAP_TEST_SIZE && freed_elements == 0,
+                          mapDestroy(map));
+
+    // Moving to an existing key frees the data it replaces
+    int key = 9;
+    int new_value = -9;
+    int *data = copyInt(&new_value);
+    ASSERT_TEST_WITH_FREE(data != NULL, mapDestroy(map));
+    ASSERT_TEST_WITH_FREE(mapPutMove(map, &key, data) == MAP_SUCCESS, mapDestroy(map));
+    ASSERT_TEST_WITH_FREE(mapGetReadOnly(map, &key) == data && freed_elements == 1 &&
+                          mapGetSize(map) == MAP_TEST_SIZE, mapDestroy(map));
+
+    // The data element stays the caller's if it wasn't moved
+    data = copyInt(&new_value);
+    ASSERT_TEST_WITH_FREE(data != NULL, mapDestroy(map));
+    ASSERT_TEST_WITH_FREE(mapPutMove(NULL, &key, data) == MAP_NULL_ARGUMENT &&
+                          mapPutMove(map, NULL, data) == MAP_NULL_ARGUMENT &&
+                          mapPutMove(map, &key, NULL) == MAP_NULL_ARGUMENT,
+                          (free(data), mapDestroy(map)));
+    free(data);
+    ASSERT_TEST_WITH_FREE(readInt(map, key) == new_value && freed_elements == 1,
+                          mapDestroy(map));
+    mapDestroy(map);
+    ASSERT_TEST(freed_elements == MAP_TEST_SIZE + 1);
+    return true;
+}
+
+
+static bool checkPutMoveOnCopy(bool is_hashed)
+{
+    Map map = createFilledMap(is_hashed, MAP_TEST_SIZE);
+    ASSERT_TEST(map != NULL);
+    Map copy = mapCopy(map);
+    ASSERT_TEST_WITH_FREE(copy != NULL, mapDestroy(map));
+
+    // Data moved to a copy replaces only the copy's data
+    int key = 4;
+    int new_key = MAP_TEST_SIZE + 1;
+    int *data = copyInt(&new_key);
+    int *new_data = copyInt(&new_key);
+    ASSERT_TEST_WITH_FREE(data != NULL && new_data != NULL,
+                          (free(data), free(new_data), mapDestroy(map), mapDestroy(copy)));
+    ASSERT_TEST_WITH_FREE(mapPutMove(copy, &key, data) == MAP_SUCCESS,
+                          (free(data), free(new_data), mapDestroy(map), mapDestroy(copy)));
+    ASSERT_TEST_WITH_FREE(mapPutMove(copy, &new_key, new_data) == MAP_SUCCESS,
+                          (free(new_data), mapDestroy(map), mapDestroy(copy)));
+    ASSERT_TEST_WITH_FREE(readInt(map, key) == 40 && mapGetReadOnly(copy, &key) == data &&
+                          !mapContains(map, &new_key) && readInt(copy, new_key) == new_key,
+                          (mapDestroy(map), mapDestroy(copy)));
+    mapDestroy(map);
+    mapDestroy(copy);
+    return true;
+}
+
+
+bool testMapPutMove()
+{
+    return checkPutMove(false) && checkPutMove(true) &&
+           checkPutMoveOnCopy(false) && checkPutMoveOnCopy(true);
+}
+
+
+/** mapForEach visitor - records the visited keys in a buffer, until it holds the given limit */
+static bool recordKeys(MapKeyElement key, MapDataElement data, void *context)
+{
+    int *record = context;  // { limit, amount, keys... }
+    record[2 + record[1]] = *(int*)key;
+    (record[1])++;
+    return record[1] < record[0];
+}
+
+/** mapForEach visitor - negates the data of every key */
+static bool negateData(MapKeyElement key, MapDataElement data, void *context)
+{
+    *(int*)data = -*(int*)data;
+    return true;
+}
+
+/** mapForEachReadOnly visitor - counts the elements whose data is shared with another map */
+static bool countSharedData(MapKeyElement key, MapDataElement data, void *context)
+{
+    void **other = context;
+    if (mapGetReadOnly(other[0], key) == data)
+    {
+        (*(int*)other[1])++;
+    }
+    return true;
+}
+
+/** Checks that a record of recordKeys holds the keys 1..amount in ascending order */
+static bool isRecordAscending(int *record, int amount)
+{
+    if (record[1] != amount)
+    {
+        return false;
+    }
+    for (int i = 0 ; i < amount ; i++)
+    {
+        if (record[2 + i] != i + 1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+static bool checkForEach(bool is_hashed)
+{
+    int record[2 + MAP_TEST_SIZE] = { MAP_TEST_SIZE, 0 };
+    Map map = createEmptyMap(is_hashed, freeInt);
+    ASSERT_TEST(map != NULL);
+
+    // An empty map visits nothing
+    ASSERT_TEST_WITH_FREE(mapForEach(map, recordKeys, record) == MAP_SUCCESS && record[1] == 0,
+                          mapDestroy(map));
+    ASSERT_TEST_WITH_FREE(mapForEach(NULL, recordKeys, record) == MAP_NULL_ARGUMENT &&
+                          mapForEach(map, NULL, record) == MAP_NULL_ARGUMENT &&
+                          mapForEachReadOnly(NULL, recordKeys, record) == MAP_NULL_ARGUMENT &&
+                          mapForEachReadOnly(map, NULL, record) == MAP_NULL_ARGUMENT,
+                          mapDestroy(map));
+
+    // Keys put in any order are visited in ascending order (37 and MAP_TEST_SIZE are coprime)
+    for (int i = 0 ; i < MAP_TEST_SIZE ; i++)
+    {
+        int key = (37 * i) % MAP_TEST_SIZE + 1;
+        ASSERT_TEST_WITH_FREE(mapPut(map, &key, &i) == MAP_SUCCESS, mapDestroy(map));
+    }
+    ASSERT_TEST_WITH_FREE(mapForEach(map, recordKeys, record) == MAP_SUCCESS &&
+                          isRecordAscending(record, MAP_TEST_SIZE), mapDestroy(map));
+    record[1] = 0;
+    ASSERT_TEST_WITH_FREE(mapForEachReadOnly(map, recordKeys, record) == MAP_SUCCESS &&
+                          isRecordAscending(record, MAP_TEST_SIZE), mapDestroy(map));
+
+    // The walk stops once the visitor returns false
+    record[0] = MAP_TEST_SIZE / 4;
+    record[1] = 0;
+    ASSERT_TEST_WITH_FREE(mapForEach(map, recordKeys, record) == MAP_SUCCESS &&
+                          isRecordAscending(record, MAP_TEST_SIZE / 4), mapDestroy(map));
+    record[1] = 0;
+    ASSERT_TEST_WITH_FREE(mapForEachReadOnly(map, recordKeys, record) == MAP_SUCCESS &&
+                          isRecordAscending(record, MAP_TEST_SIZE / 4), mapDestroy(map));
+    mapDestroy(map);
+    return true;
+}
+
+
+static bool checkForEachOnCopy(bool is_hashed)
+{
+    Map map = createFilledMap(is_hashed, MAP_TEST_SIZE);
+    ASSERT_TEST(map != NULL);
+    Map copy = mapCopy(map);
+    ASSERT_TEST_WITH_FREE(copy != NULL, mapDestroy(map));
+
+    // Data changed through mapForEach of a copy changes only in the copy
+    ASSERT_TEST_WITH_FREE(mapForEach(copy, negateData, NULL) == MAP_SUCCESS,
+                          (mapDestroy(map), mapDestroy(copy)));
+    for (int key = 1 ; key <= MAP_TEST_SIZE ; key++)
+    {
+        ASSERT_TEST_WITH_FREE(readInt(map, key) == 10 * key && readInt(copy, key) == -10 * key,
+                              (mapDestroy(map), mapDestroy(copy)));
+    }
+
+    // The source's elements aren't shared anymore, and still belong to it
+    int shared = 0;
+    void *context[2] = { copy, &shared };
+    ASSERT_TEST_WITH_FREE(mapForEachReadOnly(map, countSharedData, context) == MAP_SUCCESS &&
+                          shared == 0, (mapDestroy(map), mapDestroy(copy)));
+    mapDestroy(copy);
+    ASSERT_TEST_WITH_FREE(readInt(map, MAP_TEST_SIZE) == 10 * MAP_TEST_SIZE, mapDestroy(map));
+    mapDestroy(map);
+    return true;
+}
+
+
+bool testMapForEach()
+{
+    return checkForEach(false) && checkForEach(true) &&
+           checkForEachOnCopy(false) && checkForEachOnCopy(true);
+}
+
+
+/** Checks that a map holds offset + key for every key 1..size in a step from 1, and no
+ *  other key, and (in MAP_STATS builds) that every data element copied into it was freed
+ *  unless it's still in the map */
+static bool isRefilledMap(Map map, int size, int step, int offset)
+{
+    int amount = 0;
+    for (int key = 1 ; key <= size ; key++)
+    {
+        bool is_in_map = (key - 1) % step == 0;
+        if (readInt(map, key) != (is_in_map ? key + offset : -1))
+        {
+            return false;
+        }
+        amount += is_in_map;
+    }
+    if (mapGetSize(map) != amount || countAscendingKeys(map) != amount)
+    {
+        return false;
+    }
+#ifdef MAP_STATS
+    MapStats stats;
+    return mapGetStats(map, &stats) == MAP_SUCCESS &&
+           stats.copy_calls - stats.free_calls == amount;
+#else
+    return true;
+#endif
+}
+
+/** Puts offset + key as the data of every key 1..size that is in a step from 1 */
+static bool putKeys(Map map, int size, int step, int offset)
+{
+    for (int key = 1 ; key <= size ; key += step)
+    {
+        int data = key + offset;
+        if (mapPut(map, &key, &data) != MAP_SUCCESS)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** Removes every key 1..size that isn't in a step from 1 */
+static bool removeSkippedKeys(Map map, int size, int step)
+{
+    for (int key = 1 ; key <= size ; key++)
+    {
+        if ((key - 1) % step != 0 && mapRemove(map, &key) != MAP_SUCCESS)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+static bool checkPoolReuse(bool is_hashed)
+{
+    Map map = createEmptyMap(is_hashed, freeInt);
+    ASSERT_TEST(map != NULL);
+
+    // Nodes freed by removing half of the keys are taken again by new keys
+    ASSERT_TEST_WITH_FREE(putKeys(map, MAP_TEST_SIZE, 1, 0) &&
+                          removeSkippedKeys(map, MAP_TEST_SIZE, 2) &&
+                          isRefilledMap(map, MAP_TEST_SIZE, 2, 0), mapDestroy(map));
+    ASSERT_TEST_WITH_FREE(putKeys(map, 2 * MAP_TEST_SIZE, 1, 1) &&
+                          isRefilledMap(map, 2 * MAP_TEST_SIZE, 1, 1), mapDestroy(map));
+
+    // And so are the nodes of all of the keys
+    for (int key = 1 ; key <= 2 * MAP_TEST_SIZE ; key++)
+    {
+        ASSERT_TEST_WITH_FREE(mapRemove(map, &key) == MAP_SUCCESS, mapDestroy(map));
+    }
+    ASSERT_TEST_WITH_FREE(mapGetSize(map) == 0 && countAscendingKeys(map) == 0 &&
+                          readInt(map, 1) == -1, mapDestroy(map));
+    ASSERT_TEST_WITH_FREE(putKeys(map, MAP_TEST_SIZE, 1, 2) &&
+                          isRefilledMap(map, MAP_TEST_SIZE, 1, 2), mapDestroy(map));
+
+    // A cleared map refills from its pool too
+    ASSERT_TEST_WITH_FREE(mapClear(map) == MAP_SUCCESS && mapGetSize(map) == 0,
+                          mapDestroy(map));
+    ASSERT_TEST_WITH_FREE(putKeys(map, 3 * MAP_TEST_SIZE, 3, 3) &&
+                          isRefilledMap(map, 3 * MAP_TEST_SIZE, 3, 3), mapDestroy(map));
+    mapDestroy(map);
+    return true;
+}
+
+
+static bool checkPoolReuseOnCopy(bool is_hashed)
+{
+    Map map = createFilledMap(is_hashed, MAP_TEST_SIZE);
+    ASSERT_TEST(map != NULL);
+    Map copy = mapCopy(map);
+    ASSERT_TEST_WITH_FREE(copy != NULL, mapDestroy(map));
+
+    // The pool is shared by the copies - nodes one map frees are reused by the other
+    ASSERT_TEST_WITH_FREE(removeSkippedKeys(copy, MAP_TEST_SIZE, 2) &&
+                          putKeys(map, 2 * MAP_TEST_SIZE, 1, 0) &&
+                          putKeys(copy, MAP_TEST_SIZE, 2, 1),
+                          (mapDestroy(map), mapDestroy(copy)));
+    for (int key = 1 ; key <= 2 * MAP_TEST_SIZE ; key++)
+    {
+        int copy_data = key <= MAP_TEST_SIZE && key % 2 == 1 ? key + 1 : -1;
+        ASSERT_TEST_WITH_FREE(readInt(map, key) == key && readInt(copy, key) == copy_data,
+                              (mapDestroy(map), mapDestroy(copy)));
+    }
+
+    // The pool outlives the map that created it
+    mapDestroy(map);
+    ASSERT_TEST_WITH_FREE(mapClear(copy) == MAP_SUCCESS &&
+                          putKeys(copy, MAP_TEST_SIZE, 1, 0) &&
+                          readInt(copy, MAP_TEST_SIZE) == MAP_TEST_SIZE, mapDestroy(copy));
+    mapDestroy(copy);
+    return true;
+}
+
+
+bool testMapPoolReuse()
+{
+    return checkPoolReuse(false) && checkPoolReuse(true) &&
+           checkPoolReuseOnCopy(false) && checkPoolReuseOnCopy(true);
+}
+
+
+/** Checks that the internal iterator of a map visits exactly the given keys, in order */
+static bool isIterationEqual(Map map, const int *keys, int amount)
+{
+    int index = 0;
+    bool is_equal = true;
+    for (int *key = mapGetFirst(map) ; key != NULL ; key = mapGetNext(map))
+    {
+        is_equal = is_equal && index < amount && *key == keys[index];
+        index++;
+
+        // The key is a copy - changing it doesn't change the map's key
+        *key = 0;
+        free(key);
+    }
+    return is_equal && index == amount;
+}
+
+
+static bool checkIntKeys(bool is_hashed)
+{
+    const int sorted_keys[] = { INT_MIN, INT_MIN + 1, -1000, -1, 0, 1, 1000, INT_MAX - 1, INT_MAX };
+    const int amount = sizeof(sorted_keys) / sizeof(*sorted_keys);
+    Map map = createEmptyMap(is_hashed, freeInt);
+    ASSERT_TEST(map != NULL);
+
+    // Every key is passed through the same stack int, which the map doesn't hold on to
+    int key = 0;
+    for (int i = 0 ; i < amount ; i++)
+    {
+        key = sorted_keys[(5 * i) % amount];
+        int data = i;
+        ASSERT_TEST_WITH_FREE(mapPut(map, &key, &data) == MAP_SUCCESS, mapDestroy(map));
+    }
+    key = 42;
+    ASSERT_TEST_WITH_FREE(mapGetSize(map) == amount && !mapContains(map, &key) &&
+                          isIterationEqual(map, sorted_keys, amount), mapDestroy(map));
+    for (int i = 0 ; i < amount ; i++)
+    {
+        key = sorted_keys[(5 * i) % amount];
+        ASSERT_TEST_WITH_FREE(readInt(map, key) == i, mapDestroy(map));
+    }
+
+    // A copy keeps its keys after the keys it was made from change and the source is gone
+    Map copy = mapCopy(map);
+    ASSERT_TEST_WITH_FREE(copy != NULL, mapDestroy(map));
+    key = INT_MIN;
+    ASSERT_TEST_WITH_FREE(mapRemove(map, &key) == MAP_SUCCESS &&
+                          isIterationEqual(map, sorted_keys + 1, amount - 1),
+                          (mapDestroy(map), mapDestroy(copy)));
+    mapDestroy(map);
+    ASSERT_TEST_WITH_FREE(isIterationEqual(copy, sorted_keys, amount), mapDestroy(copy));
+
+    // Removing by a different int of the same value
+    int other_key = INT_MAX;
+    ASSERT_TEST_WITH_FREE(mapRemove(copy, &other_key) == MAP_SUCCESS &&
+                          mapRemove(copy, &other_key) == MAP_ITEM_DOES_NOT_EXIST &&
+                          isIterationEqual(copy, sorted_keys, amount - 1), mapDestroy(copy));
+    mapDestroy(copy);
+    return true;
+}
+
+
+bool testMapIntKeys()
+{
+    ASSERT_TEST(mapCreateIntKeyed(NULL, freeInt) == NULL &&
+                mapCreateIntKeyed(copyInt, NULL) == NULL &&
+                mapCreateIntKeyedHashed(NULL, freeInt) == NULL &&
+                mapCreateIntKeyedHashed(copyInt, NULL) == NULL);
+    return checkIntKeys(false) && checkIntKeys(true);
+}
+
+
+static bool checkBuildFromSorted(bool is_hashed)
+{
+    int keys[MAP_TEST_SIZE];
+    int data[MAP_TEST_SIZE];
+    MapKeyElement key_elements[MAP_TEST_SIZE];
+    MapDataElement data_elements[MAP_TEST_SIZE];
+    for (int i = 0 ; i < MAP_TEST_SIZE ; i++)
+    {
+        keys[i] = 2 * i + 1;
+        data[i] = 10 * keys[i];
+        key_elements[i]  = &keys[i];
+        data_elements[i] = &data[i];
+    }
+
+    Map map = is_hashed ? mapCreateIntKeyedHashed(copyInt, freeInt) :
+                          mapCreateIntKeyed(copyInt, freeInt);
+    ASSERT_TEST(map != NULL);
+    ASSERT_TEST_WITH_FREE(mapBuildFromSorted(map, key_elements, data_elements, MAP_TEST_SIZE) ==
+                          MAP_SUCCESS && mapGetSize(map) == MAP_TEST_SIZE, mapDestroy(map));
+
+    // Keys are found, and visited in order
+    int expected_key = 1;
+    MapCursor cursor;
+    for (bool has_key = mapCursorBegin(map, &cursor) ; has_key ; has_key = mapCursorNext(&cursor))
+    {
+        ASSERT_TEST_WITH_FREE(*(int*)mapCursorKey(&cursor) == expected_key &&
+                              *(int*)mapCursorData(&cursor) == 10 * expected_key,
+                              mapDestroy(map));
+        expected_key += 2;
+    }
+    ASSERT_TEST_WITH_FREE(expected_key == 2 * MAP_TEST_SIZE + 1, mapDestroy(map));
+    int missing_key = 2;
+    ASSERT_TEST_WITH_FREE(!mapContains(map, &missing_key) && readInt(map, 99) == 990,
+                          mapDestroy(map));
+
+    // Only an empty map is built
+    ASSERT_TEST_WITH_FREE(mapBuildFromSorted(map, key_elements, data_elements, 1) == MAP_ERROR,
+                          mapDestroy(map));
+
+    // Keys that aren't strictly ascending leave the map empty
+    mapClear(map);
+    key_elements[MAP_TEST_SIZE - 1] = &keys[0];
+    ASSERT_TEST_WITH_FREE(mapBuildFromSorted(map, key_elements, data_elements, MAP_TEST_SIZE) ==
+                          MAP_ERROR && mapGetSize(map) == 0, mapDestroy(map));
+    ASSERT_TEST_WITH_FREE(mapBuildFromSorted(map, key_elements, data_elements, -1) == MAP_ERROR &&
+                          mapBuildFromSorted(map, NULL, data_elements, 1) == MAP_NULL_ARGUMENT,
+                          mapDestroy(map));
+    mapDestroy(map);
+    return true;
+}
+
+
+static bool checkBuildFromSortedMove(bool is_hashed)
+{
+    int keys[MAP_TEST_SIZE];
+    MapKeyElement key_elements[MAP_TEST_SIZE];
+    MapDataElement data_elements[MAP_TEST_SIZE];
+    for (int i = 0 ; i < MAP_TEST_SIZE ; i++)
+    {
+        keys[i] = i + 1;
+        key_elements[i]  = &keys[i];
+        data_elements[i] = copyInt(&keys[i]);
+        ASSERT_TEST(data_elements[i] != NULL);
+    }
+
+    Map map = is_hashed ? mapCreateIntKeyedHashed(copyInt, freeInt) :
+                          mapCreateIntKeyed(copyInt, freeInt);
+    ASSERT_TEST(map != NULL);
+    ASSERT_TEST_WITH_FREE(mapBuildFromSortedMove(map, key_elements, data_elements,
+                                                 MAP_TEST_SIZE) == MAP_SUCCESS,
+                          mapDestroy(map));
+
+    // The map holds the data elements themselves, and frees them
+    ASSERT_TEST_WITH_FREE(mapGet(map, &keys[5]) == data_elements[5], mapDestroy(map));
+    mapDestroy(map);
+    return true;
+}
+
+
+static bool checkPutAscendingKeys(bool is_hashed)
+{
+    // Keys greater than all the keys in the map take the append path
+    Map map = createFilledMap(is_hashed, MAP_TEST_SIZE);
+    ASSERT_TEST(map != NULL);
+    int key = 0;
+    int data = 0;
+    ASSERT_TEST_WITH_FREE(mapPut(map, &key, &data) == MAP_SUCCESS, mapDestroy(map));
+
+    int expected_key = 0;
+    MapCursor cursor;
+    for (bool has_key = mapCursorBegin(map, &cursor) ; has_key ; has_key = mapCursorNext(&cursor))
+    {
+        ASSERT_TEST_WITH_FREE(*(int*)mapCursorKey(&cursor) == expected_key, mapDestroy(map));
+        expected_key++;
+    }
+    ASSERT_TEST_WITH_FREE(expected_key == MAP_TEST_SIZE + 1, mapDestroy(map));
+    mapDestroy(map);
+    return true;
+}
+
+
+bool testMapBuildFromSorted()
+{
+    return checkBuildFromSorted(false) && checkBuildFromSorted(true) &&
+           checkBuildFromSortedMove(false) && checkBuildFromSortedMove(true);
+}
+
+
+bool testMapPutAscendingKeys()
+{
+    return checkPutAscendingKeys(false) && checkPutAscendingKeys(true);
+}
+
+
+// Counts the keys from a cursor to the end of its range, checking they're the odd keys
+// that follow first_key. Returns -1 if a key is wrong
+static int countOddKeys(MapCursor *cursor, int first_key)
+{
+    int count = 0;
+    do
+    {
+        if (*(int*)mapCursorKey(cursor) != first_key + 2 * count)
+        {
+            return -1;
+        }
+        count++;
+    } while (mapCursorNext(cursor));
+    return count;
+}
+
+
+static bool checkRangeQueries(bool is_hashed)
+{
+    // The odd keys 1..2 * MAP_TEST_SIZE - 1
+    Map map = is_hashed ? mapCreateIntKeyedHashed(copyInt, freeInt) :
+                          mapCreateIntKeyed(copyInt, freeInt);
+    ASSERT_TEST(map != NULL);
+    for (int key = 1 ; key < 2 * MAP_TEST_SIZE ; key += 2)
+    {
+        ASSERT_TEST_WITH_FREE(mapPut(map, &key, &key) == MAP_SUCCESS, mapDestroy(map));
+    }
+
+    MapCursor cursor;
+    int key = 4;
+    ASSERT_TEST_WITH_FREE(mapCursorLowerBound(map, &key, &cursor) &&
+                          *(int*)mapCursorKey(&cursor) == 5, mapDestroy(map));
+    key = 5;
+    ASSERT_TEST_WITH_FREE(mapCursorLowerBound(map, &key, &cursor) &&
+                          countOddKeys(&cursor, 5) == MAP_TEST_SIZE - 2, mapDestroy(map));
+    ASSERT_TEST_WITH_FREE(mapCursorUpperBound(map, &key, &cursor) &&
+                          *(int*)mapCursorKey(&cursor) == 7, mapDestroy(map));
+    key = 2 * MAP_TEST_SIZE - 1;
+    ASSERT_TEST_WITH_FREE(!mapCursorUpperBound(map, &key, &cursor) &&
+                          mapCursorKey(&cursor) == NULL, mapDestroy(map));
+    key = 2 * MAP_TEST_SIZE;
+    ASSERT_TEST_WITH_FREE(!mapCursorLowerBound(map, &key, &cursor), mapDestroy(map));
+    key = -5;
+    ASSERT_TEST_WITH_FREE(mapCursorUpperBound(map, &key, &cursor) &&
+                          *(int*)mapCursorKey(&cursor) == 1, mapDestroy(map));
+
+    // Ranges include both of their ends
+    int low = 10;
+    int high = 20;
+    ASSERT_TEST_WITH_FREE(mapCursorRange(map, &low, &high, &cursor) &&
+                          countOddKeys(&cursor, 11) == 5, mapDestroy(map));
+    low = 11;
+    high = 19;
+    ASSERT_TEST_WITH_FREE(mapCursorRange(map, &low, &high, &cursor) &&
+                          countOddKeys(&cursor, 11) == 5, mapDestroy(map));
+    low = 0;
+    high = 3 * MAP_TEST_SIZE;
+    ASSERT_TEST_WITH_FREE(mapCursorRange(map, &low, &high, &cursor) &&
+                          countOddKeys(&cursor, 1) == MAP_TEST_SIZE, mapDestroy(map));
+
+    // Empty ranges
+    low = 2;
+    high = 2;
+    ASSERT_TEST_WITH_FREE(!mapCursorRange(map, &low, &high, &cursor), mapDestroy(map));
+    low = 20;
+    high = 10;
+    ASSERT_TEST_WITH_FREE(!mapCursorRange(map, &low, &high, &cursor), mapDestroy(map));
+    ASSERT_TEST_WITH_FREE(!mapCursorRange(map, NULL, &high, &cursor), mapDestroy(map));
+    mapDestroy(map);
+    return true;
+}
+
+
+/** Checks that a read only range query on a copied map keeps sharing its elements, and
+ *  (in MAP_STATS builds) passes O(log n) nodes. A cursor which may change the data makes
+ *  the map's elements its own, but only the first time */
+static bool checkRangeQueriesOnCopy(bool is_hashed)
+{
+    Map map = createFilledMap(is_hashed, MAP_BALANCE_TEST_SIZE);
+    ASSERT_TEST(map != NULL);
+    Map copy = mapCopy(map);
+    ASSERT_TEST_WITH_FREE(copy != NULL, mapDestroy(map));
+#ifdef MAP_STATS
+    // A seek, and the search for the end of the range
+    int max_nodes = 2 * (maxAvlHeight(MAP_BALANCE_TEST_SIZE) + 1);
+    MapStats stats;
+    mapResetStats(copy);
+#endif
+
+    MapCursor cursor;
+    int low = 100;
+    int high = 110;
+    ASSERT_TEST_WITH_FREE(mapCursorRangeReadOnly(copy, &low, &high, &cursor) &&
+                          *(int*)mapCursorKey(&cursor) == low &&
+                          mapCursorData(&cursor) == mapGetReadOnly(map, &low),
+                          (mapDestroy(map), mapDestroy(copy)));
+#ifdef MAP_STATS
+    mapGetStats(copy, &stats);
+    ASSERT_TEST_WITH_FREE(stats.nodes_traversed <= max_nodes && stats.copy_calls == 0,
+                          (mapDestroy(map), mapDestroy(copy)));
+#endif
+    ASSERT_TEST_WITH_FREE(mapCursorLowerBoundReadOnly(copy, &low, &cursor) &&
+                          mapCursorData(&cursor) == mapGetReadOnly(map, &low) &&
+                          mapCursorUpperBoundReadOnly(copy, &low, &cursor) &&
+                          *(int*)mapCursorKey(&cursor) == low + 1,
+                          (mapDestroy(map), mapDestroy(copy)));
+
+    // The data reached through the other cursors is the copy's own
+    ASSERT_TEST_WITH_FREE(mapCursorRange(copy, &low, &high, &cursor) &&
+                          mapCursorData(&cursor) != mapGetReadOnly(map, &low),
+                          (mapDestroy(map), mapDestroy(copy)));
+    *(int*)mapCursorData(&cursor) = -low;
+    ASSERT_TEST_WITH_FREE(readInt(map, low) == 10 * low && readInt(copy, low) == -low,
+                          (mapDestroy(map), mapDestroy(copy)));
+#ifdef MAP_STATS
+    mapResetStats(copy);
+#endif
+    ASSERT_TEST_WITH_FREE(mapCursorRange(copy, &low, &high, &cursor),
+                          (mapDestroy(map), mapDestroy(copy)));
+#ifdef MAP_STATS
+    mapGetStats(copy, &stats);
+    ASSERT_TEST_WITH_FREE(stats.nodes_traversed <= max_nodes && stats.copy_calls == 0,
+                          (mapDestroy(map), mapDestroy(copy)));
+#endif
+    mapDestroy(map);
+    mapDestroy(copy);
+    return true;
+}
+
+
+bool testMapRangeQueries()
+{
+    return checkRangeQueries(false) && checkRangeQueries(true) &&
+           checkRangeQueriesOnCopy(false) && checkRangeQueriesOnCopy(true);
+}
+
+
+static bool checkStats(bool is_hashed)
+{
+    Map map = createFilledMap(is_hashed, MAP_TEST_SIZE);
+    ASSERT_TEST(map != NULL);
+    MapStats stats;
+#ifdef MAP_STATS
+    ASSERT_TEST_WITH_FREE(mapGetStats(map, &stats) == MAP_SUCCESS &&
+                          stats.peak_size == MAP_TEST_SIZE &&
+                          stats.copy_calls == MAP_TEST_SIZE && stats.free_calls == 0,
+                          mapDestroy(map));
+
+    // Counters restart from a reset, and the peak size from the current size
+    ASSERT_TEST_WITH_FREE(mapResetStats(map) == MAP_SUCCESS, mapDestroy(map));
+    for (int key = 1 ; key <= MAP_TEST_SIZE / 2 ; key++)
+    {
+        ASSERT_TEST_WITH_FREE(mapGet(map, &key) != NULL && mapRemove(map, &key) == MAP_SUCCESS,
+                              mapDestroy(map));
+    }
+    ASSERT_TEST_WITH_FREE(mapGetStats(map, &stats) == MAP_SUCCESS &&
+                          stats.lookups >= MAP_TEST_SIZE / 2 &&
+                          stats.nodes_traversed >= stats.lookups &&
+                          stats.comparisons > 0 && stats.copy_calls == 0 &&
+                          stats.free_calls == MAP_TEST_SIZE / 2 &&
+                          stats.peak_size == MAP_TEST_SIZE, mapDestroy(map));
+    ASSERT_TEST_WITH_FREE(mapResetStats(map) == MAP_SUCCESS &&
+                          mapGetStats(map, &stats) == MAP_SUCCESS &&
+                          stats.lookups == 0 && stats.peak_size == MAP_TEST_SIZE / 2,
+                          mapDestroy(map));
+#else
+    // The counters aren't compiled in
+    ASSERT_TEST_WITH_FREE(mapGetStats(map, &stats) == MAP_ERROR &&
+                          mapResetStats(map) == MAP_ERROR, mapDestroy(map));
+#endif
+    ASSERT_TEST_WITH_FREE(mapGetStats(NULL, &stats) == MAP_NULL_ARGUMENT &&
+                          mapGetStats(map, NULL) == MAP_NULL_ARGUMENT &&
+                          mapResetStats(NULL) == MAP_NULL_ARGUMENT, mapDestroy(map));
+    mapDestroy(map);
+    return true;
+}
+
+
+bool testMapStats()
+{
+    return checkStats(false) && checkStats(true);
+}
+
+
+// Checks the functions of a typed map type, and the map they share with the Map functions
+#define CHECK_TYPED_MAP(name)                                                                 \
+    do {                                                                                      \
+        name map = name##Create();                                                            \
+        ASSERT_TEST(map != NULL);                                                             \
+        for (int key = 1 ; key <= MAP_TEST_SIZE ; key++)                                      \
+        {                                                                                     \
+            int data = 10 * key;                                                              \
+            ASSERT_TEST_WITH_FREE(name##Put(map, key, &data) == MAP_SUCCESS,                  \
+                                  name##Destroy(map));                                        \
+        }                                                                                     \
+        int *moved = copyIntPointer(&(int){ -1 });                                            \
+        ASSERT_TEST_WITH_FREE(moved != NULL && name##PutMove(map, 0, moved) == MAP_SUCCESS,   \
+                              (freeIntPointer(moved), name##Destroy(map)));                   \
+        ASSERT_TEST_WITH_FREE(name##GetSize(map) == MAP_TEST_SIZE + 1 &&                      \
+                              name##Get(map, 0) == moved && *name##Get(map, 7) == 70 &&       \
+                              name##Get(map, MAP_TEST_SIZE + 1) == NULL &&                    \
+                              name##Contains(map, 5) && !name##Contains(map, -5),             \
+                              name##Destroy(map));                                            \
+                                                                                              \
+        name copy = name##Copy(map);                                                          \
+        ASSERT_TEST_WITH_FREE(copy != NULL && name##Remove(map, 7) == MAP_SUCCESS &&          \
+                              name##Remove(map, 7) == MAP_ITEM_DOES_NOT_EXIST,                \
+                              (name##Destroy(map), name##Destroy(copy)));                     \
+        ASSERT_TEST_WITH_FREE(name##Contains(copy, 7) && !name##Contains(map, 7),             \
+                              (name##Destroy(map), name##Destroy(copy)));                     \
+                                                                                              \
+        MapCursor cursor;                                                                     \
+        int expected_key = 0;                                                                 \
+        for (bool has_key = mapCursorBegin(name##AsMap(copy), &cursor) ; has_key ;            \
+             has_key = mapCursorNext(&cursor))                                                \
+        {                                                                                     \
+            ASSERT_TEST_WITH_FREE(*(int*)mapCursorKey(&cursor) == expected_key,               \
+                                  (name##Destroy(map), name##Destroy(copy)));                 \
+            expected_key++;                                                                   \
+        }                                                                                     \
+        name##Destroy(map);                                                                   \
+        name##Destroy(copy);                                                                  \
+        ASSERT_TEST(expected_key == MAP_TEST_SIZE + 1);                                       \
+    } while (0)
+
+
+bool testTypedMap()
+{
+    CHECK_TYPED_MAP(IntTreeMap);
+    CHECK_TYPED_MAP(IntHashMap);
+    return true;
+}
+
+
+static bool checkGetMany(bool is_hashed)
+{
+    Map map = createFilledMap(is_hashed, MAP_TEST_SIZE);
+    ASSERT_TEST(map != NULL);
+
+    // Keys in any order, with duplicates, missing keys and NULLs, over several batches
+    int keys[3 * MAP_TEST_SIZE];
+    MapKeyElement key_elements[3 * MAP_TEST_SIZE];
+    MapDataElement data_elements[3 * MAP_TEST_SIZE];
+    for (int i = 0 ; i < 3 * MAP_TEST_SIZE ; i++)
+    {
+        keys[i] = (7 * i) % (2 * MAP_TEST_SIZE);
+        key_elements[i] = i % 10 == 9 ? NULL : &keys[i];
+    }
+    ASSERT_TEST_WITH_FREE(mapGetMany(map, key_elements, 3 * MAP_TEST_SIZE, data_elements) ==
+                          MAP_SUCCESS, mapDestroy(map));
+    for (int i = 0 ; i < 3 * MAP_TEST_SIZE ; i++)
+    {
+        bool is_found = key_elements[i] != NULL && keys[i] >= 1 && keys[i] <= MAP_TEST_SIZE;
+        ASSERT_TEST_WITH_FREE(is_found ? data_elements[i] == mapGet(map, &keys[i]) &&
+                                         *(int*)data_elements[i] == 10 * keys[i]
+                                       : data_elements[i] == NULL, mapDestroy(map));
+    }
+
+    ASSERT_TEST_WITH_FREE(mapGetMany(map, key_elements, 0, data_elements) == MAP_SUCCESS &&
+                          mapGetMany(map, key_elements, -1, data_elements) == MAP_ERROR &&
+                          mapGetMany(map, NULL, 1, data_elements) == MAP_NULL_ARGUMENT &&
+                          mapGetMany(map, key_elements, 1, NULL) == MAP_NULL_ARGUMENT &&
+                          mapGetMany(NULL, key_elements, 1, data_elements) == MAP_NULL_ARGUMENT,
+                          mapDestroy(map));
+    mapDestroy(map);
+    return true;
+}
+
+
+bool testMapGetMany()
+{
+    return checkGetMany(false) && checkGetMany(true);
+}
+
+
+static bool checkCopyIsSharedUntilChanged(bool is_hashed)
+{
+    Map map = createFilledMap(is_hashed, MAP_TEST_SIZE);
+    ASSERT_TEST(map != NULL);
+    Map copy = mapCopy(map);
+    ASSERT_TEST_WITH_FREE(copy != NULL, mapDestroy(map));
+
+    // Reads don't copy the elements - both maps still hand out the same data
+    int key = 7;
+    ASSERT_TEST_WITH_FREE(mapGetReadOnly(map, &key) == mapGetReadOnly(copy, &key),
+                          (mapDestroy(map), mapDestroy(copy)));
+    ASSERT_TEST_WITH_FREE(mapContains(copy, &key), (mapDestroy(map), mapDestroy(copy)));
+    MapCursor cursor;
+    ASSERT_TEST_WITH_FREE(mapCursorBeginReadOnly(copy, &cursor),
+                          (mapDestroy(map), mapDestroy(copy)));
+    int first_key = 1;
+    ASSERT_TEST_WITH_FREE(*(int*)mapCursorKey(&cursor) == first_key &&
+                          mapCursorData(&cursor) == mapGetReadOnly(map, &first_key),
+                          (mapDestroy(map), mapDestroy(copy)));
+
+    // Data that may be changed is the copy's own
+    int *data = mapGet(copy, &key);
+    ASSERT_TEST_WITH_FREE(data != NULL && (const void*)data != mapGetReadOnly(map, &key),
+                          (mapDestroy(map), mapDestroy(copy)));
+    *data = -7;
+    ASSERT_TEST_WITH_FREE(readInt(map, key) == 70 && readInt(copy, key) == -7,
+                          (mapDestroy(map), mapDestroy(copy)));
+
+    // Changes of one map don't reach the other
+    int new_data = 1;
+    ASSERT_TEST_WITH_FREE(mapPut(map, &key, &new_data) == MAP_SUCCESS &&
+                          mapRemove(map, &first_key) == MAP_SUCCESS,
+                          (mapDestroy(map), mapDestroy(copy)));
+    ASSERT_TEST_WITH_FREE(readInt(copy, key) == -7 && readInt(copy, first_key) == 10 &&
+                          mapGetSize(copy) == MAP_TEST_SIZE &&
+                          mapGetSize(map) == MAP_TEST_SIZE - 1,
+                          (mapDestroy(map), mapDestroy(copy)));
+    mapDestroy(map);
+    mapDestroy(copy);
+    return true;
+}
+
+
+static bool checkCopyOutlivesSource(bool is_hashed)
+{
+    Map map = createFilledMap(is_hashed, MAP_TEST_SIZE);
+    ASSERT_TEST(map != NULL);
+    Map copy = mapCopy(map);
+    Map copy_of_copy = mapCopy(copy);
+    mapDestroy(map);
+    ASSERT_TEST_WITH_FREE(copy != NULL && copy_of_copy != NULL,
+                          (mapDestroy(copy), mapDestroy(copy_of_copy)));
+
+    mapDestroy(copy);
+    int sum = 0;
+    MapCursor cursor;
+    for (bool has_key = mapCursorBegin(copy_of_copy, &cursor) ; has_key ;
+         has_key = mapCursorNext(&cursor))
+    {
+        sum += *(int*)mapCursorData(&cursor);
+    }
+    mapDestroy(copy_of_copy);
+    ASSERT_TEST(sum == 10 * MAP_TEST_SIZE * (MAP_TEST_SIZE + 1) / 2);
+    return true;
+}
+
+
+bool testMapCopyIsSharedUntilChanged()
+{
+    return checkCopyIsSharedUntilChanged(false) && checkCopyIsSharedUntilChanged(true);
+}
+
+
+bool testMapCopyOutlivesSource()
+{
+    return checkCopyOutlivesSource(false) && checkCopyOutlivesSource(true);
+}
+
+
+static bool checkCopyChangesOnlyPath(bool is_hashed)
+{
+    Map map = createFilledMap(is_hashed, MAP_TEST_SIZE);
+    ASSERT_TEST(map != NULL);
+    Map copy = mapCopy(map);
+    ASSERT_TEST_WITH_FREE(copy != NULL, mapDestroy(map));
+
+    // A map copies the node of a changed key (a tree map, the path to it), but the other
+    // keys keep sharing their data
+    int key = 50;
+    int new_data = -50;
+    int removed_key = 1;
+    ASSERT_TEST_WITH_FREE(mapPut(copy, &key, &new_data) == MAP_SUCCESS &&
+                          mapRemove(copy, &removed_key) == MAP_SUCCESS,
+                          (mapDestroy(map), mapDestroy(copy)));
+    int shared = 0;
+    void *context[] = { map, &shared };
+    ASSERT_TEST_WITH_FREE(mapForEachReadOnly(copy, countSharedData, context) == MAP_SUCCESS,
+                          (mapDestroy(map), mapDestroy(copy)));
+    ASSERT_TEST_WITH_FREE(shared == MAP_TEST_SIZE - 2, (mapDestroy(map), mapDestroy(copy)));
+    ASSERT_TEST_WITH_FREE(readInt(map, key) == 10 * key && readInt(copy, key) == new_data &&
+                          readInt(map, removed_key) == 10 && !mapContains(copy, &removed_key),
+                          (mapDestroy(map), mapDestroy(copy)));
+
+    // Once the source is gone the copy's elements are its own, and are changed in place
+    mapDestroy(map);
+    int other_key = 30;
+    const void *other_data = mapGetReadOnly(copy, &other_key);
+    ASSERT_TEST_WITH_FREE(mapGet(copy, &other_key) == other_data, mapDestroy(copy));
+    mapDestroy(copy);
+    return true;
+}
+
+
+bool testMapCopyChangesOnlyPath()
+{
+    return checkCopyChangesOnlyPath(false) && checkCopyChangesOnlyPath(true);
+}
+
+
+int main()
+{
+    RUN_TEST(testMapBalance, "testMapBalance");
+    RUN_TEST(testMapCreateHashed, "testMapCreateHashed");
+    RUN_TEST(testMapGetOrInsert, "testMapGetOrInsert");
+    RUN_TEST(testMapPutMove, "testMapPutMove");
+    RUN_TEST(testMapForEach, "testMapForEach");
+    RUN_TEST(testMapPoolReuse, "testMapPoolReuse");
+    RUN_TEST(testMapIntKeys, "testMapIntKeys");
+    RUN_TEST(testMapBuildFromSorted, "testMapBuildFromSorted");
+    RUN_TEST(testMapPutAscendingKeys, "testMapPutAscendingKeys");
+    RUN_TEST(testMapRangeQueries, "testMapRangeQueries");
+    RUN_TEST(testMapStats, "testMapStats");
+    RUN_TEST(testTypedMap, "testTypedMap");
+    RUN_TEST(testMapGetMany, "testMapGetMany");
+    RUN_TEST(testMapCopyIsSharedUntilChanged, "testMapCopyIsSharedUntilChanged");
+    RUN_TEST(testMapCopyOutlivesSource, "testMapCopyOutlivesSource");
+    RUN_TEST(testMapCopyChangesOnlyPath, "testMapCopyChangesOnlyPath");
+    return 0;
+}
@@ -0,0 +1,231 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "player.h"
+#include "test_utilities.h"
+
+#define PLAYER_TEST_TOURNAMENTS 8
+#define PLAYER_TEST_MANY_TOURNAMENTS 1000
+
+
+// Checks that a player's tournaments are the given ids, visited in ascending order
+static bool playerHasTournaments(Player player, const int *tournament_ids, int amount)
+{
+    int count = 0;
+    bool is_equal = true;
+    for (int *tournament_id = playerGetFirstTournamentID(player) ; tournament_id != NULL ;
+         tournament_id = playerGetNextTournamentID(player))
+    {
+        is_equal = is_equal && count < amount && *tournament_id == tournament_ids[count] &&
+                   playerIsPlayingInTournament(player, *tournament_id);
+        count++;
+        free(tournament_id);
+    }
+    return is_equal && count == amount;
+}
+
+
+bool testPlayerFewTournaments()
+{
+    Player player = playerCreate(1);
+    ASSERT_TEST(player != NULL);
+
+    // A few records, added in any order, are visited in order
+    ASSERT_TEST_WITH_FREE(playerAddTournament(player, 3, 2) == PLAYER_SUCCESS &&
+                          playerAddTournament(player, 1, 2) == PLAYER_SUCCESS &&
+                          playerAddTournament(player, 2, 2) == PLAYER_SUCCESS,
+                          playerDestroy(player));
+    ASSERT_TEST_WITH_FREE(playerHasTournaments(player, (int[]){ 1, 2, 3 }, 3) &&
+                          !playerIsPlayingInTournament(player, 4) &&
+                          playerCanPlayMoreGamesInTournament(player, 2),
+                          playerDestroy(player));
+
+    // A copy shares the records until either player changes them
+    Player copy = playerCopy(player);
+    ASSERT_TEST_WITH_FREE(copy != NULL, playerDestroy(player));
+    ASSERT_TEST_WITH_FREE(playerRemoveTournament(copy, 2) == PLAYER_SUCCESS &&
+                          playerRemoveTournament(copy, 2) == PLAYER_TOURNAMENT_NOT_EXIST,
+                          (playerDestroy(player), playerDestroy(copy)));
+    ASSERT_TEST_WITH_FREE(playerHasTournaments(copy, (int[]){ 1, 3 }, 2) &&
+                          playerHasTournaments(player, (int[]){ 1, 2, 3 }, 3),
+                          (playerDestroy(player), playerDestroy(copy)));
+    playerDestroy(copy);
+    playerDestroy(player);
+    return true;
+}
+
+
+bool testPlayerManyTournaments()
+{
+    Player player = playerCreate(1);
+    ASSERT_TEST(player != NULL);
+
+    // More records than are kept inline, added in descending order - after adding i + 1
+    // of them, the player has the last i + 1 ids
+    int tournament_ids[PLAYER_TEST_TOURNAMENTS];
+    for (int i = 0 ; i < PLAYER_TEST_TOURNAMENTS ; i++)
+    {
+        tournament_ids[i] = i + 1;
+    }
+    for (int i = 0 ; i < PLAYER_TEST_TOURNAMENTS ; i++)
+    {
+        int first = PLAYER_TEST_TOURNAMENTS - 1 - i;
+        ASSERT_TEST_WITH_FREE(playerAddTournament(player, tournament_ids[first], 2) ==
+                              PLAYER_SUCCESS, playerDestroy(player));
+        ASSERT_TEST_WITH_FREE(playerHasTournaments(player, tournament_ids + first, i + 1),
+                              playerDestroy(player));
+    }
+
+    Player copy = playerCopy(player);
+    ASSERT_TEST_WITH_FREE(copy != NULL, playerDestroy(player));
+
+    // Removing records, down to fewer than are kept inline
+    for (int i = 1 ; i < PLAYER_TEST_TOURNAMENTS ; i++)
+    {
+        ASSERT_TEST_WITH_FREE(playerRemoveTournament(player, i + 1) == PLAYER_SUCCESS,
+                              (playerDestroy(player), playerDestroy(copy)));
+    }
+    ASSERT_TEST_WITH_FREE(playerHasTournaments(player, (int[]){ 1 }, 1) &&
+                          playerAddTournament(player, 5, 2) == PLAYER_SUCCESS &&
+                          playerHasTournaments(player, (int[]){ 1, 5 }, 2),
+                          (playerDestroy(player), playerDestroy(copy)));
+    ASSERT_TEST_WITH_FREE(playerHasTournaments(copy, tournament_ids, PLAYER_TEST_TOURNAMENTS),
+                          (playerDestroy(player), playerDestroy(copy)));
+    playerDestroy(copy);
+    playerDestroy(player);
+    return true;
+}
+
+
+bool testPlayerCopySharesRecords()
+{
+    Player player = playerCreate(1);
+    ASSERT_TEST(player != NULL);
+    ASSERT_TEST_WITH_FREE(playerAddTournament(player, 1, 2) == PLAYER_SUCCESS &&
+                          playerAddTournament(player, 2, 2) == PLAYER_SUCCESS,
+                          playerDestroy(player));
+    Player copy = playerCopy(player);
+    ASSERT_TEST_WITH_FREE(copy != NULL, playerDestroy(player));
+    Player other_copy = playerCopy(copy);
+    ASSERT_TEST_WITH_FREE(other_copy != NULL, (playerDestroy(player), playerDestroy(copy)));
+
+    // A game of one copy isn't recorded by the others
+    Game game = gameCreate(1, 1, 2, GAME_FIRST_PLAYER, 10, 0);
+    ASSERT_TEST_WITH_FREE(game != NULL && playerAddGame(copy, game) == PLAYER_SUCCESS,
+                          (gameDestroy(game), playerDestroy(player), playerDestroy(copy),
+                           playerDestroy(other_copy)));
+    gameDestroy(game);
+    ASSERT_TEST_WITH_FREE(playerGetWinsInTournament(copy, 1) == 1 &&
+                          playerGetWinsInTournament(player, 1) == 0 &&
+                          playerGetWinsInTournament(other_copy, 1) == 0,
+                          (playerDestroy(player), playerDestroy(copy), playerDestroy(other_copy)));
+
+    // Records moved to a map by one copy stay inline in the others
+    ASSERT_TEST_WITH_FREE(playerAddTournament(other_copy, 3, 2) == PLAYER_SUCCESS &&
+                          playerAddTournament(other_copy, 4, 2) == PLAYER_SUCCESS,
+                          (playerDestroy(player), playerDestroy(copy), playerDestroy(other_copy)));
+    ASSERT_TEST_WITH_FREE(playerHasTournaments(other_copy, (int[]){ 1, 2, 3, 4 }, 4) &&
+                          playerHasTournaments(player, (int[]){ 1, 2 }, 2) &&
+                          playerHasTournaments(copy, (int[]){ 1, 2 }, 2),
+                          (playerDestroy(player), playerDestroy(copy), playerDestroy(other_copy)));
+
+    // The records the players still share outlive the player they were copied from
+    playerDestroy(player);
+    ASSERT_TEST_WITH_FREE(playerRemoveTournament(other_copy, 1) == PLAYER_SUCCESS &&
+                          playerGetWinsInTournament(copy, 1) == 1 &&
+                          playerHasTournaments(copy, (int[]){ 1, 2 }, 2),
+                          (playerDestroy(copy), playerDestroy(other_copy)));
+    playerDestroy(other_copy);
+    playerDestroy(copy);
+    return true;
+}
+
+
+bool testPlayerTournamentsStats()
+{
+    Player player = playerCreate(1);
+    ASSERT_TEST(player != NULL);
+    ASSERT_TEST_WITH_FREE(playerAddTournament(player, 1, 2) == PLAYER_SUCCESS &&
+                          playerAddTournament(player, 2, 2) == PLAYER_SUCCESS,
+                          playerDestroy(player));
+    MapStats stats;
+#ifdef MAP_STATS
+    // Scanning the inline records is counted, visiting every record for a missing id
+    playerResetTournamentsMapStats(player);
+    ASSERT_TEST_WITH_FREE(!playerIsPlayingInTournament(player, 3) &&
+                          playerGetTournamentsMapStats(player, &stats) == MAP_SUCCESS,
+                          playerDestroy(player));
+    ASSERT_TEST_WITH_FREE(stats.lookups == 1 && stats.nodes_traversed == 2 &&
+                          stats.comparisons == 2 && stats.peak_size == 2,
+                          playerDestroy(player));
+
+    // Once the records move to a map, its work is added
+    for (int tournament_id = 3 ; tournament_id <= PLAYER_TEST_TOURNAMENTS ; tournament_id++)
+    {
+        ASSERT_TEST_WITH_FREE(playerAddTournament(player, tournament_id, 2) == PLAYER_SUCCESS,
+                              playerDestroy(player));
+    }
+    MapStats spilled_stats;
+    ASSERT_TEST_WITH_FREE(playerIsPlayingInTournament(player, 5) &&
+                          playerGetTournamentsMapStats(player, &spilled_stats) == MAP_SUCCESS,
+                          playerDestroy(player));
+    ASSERT_TEST_WITH_FREE(spilled_stats.lookups > stats.lookups &&
+                          spilled_stats.peak_size == PLAYER_TEST_TOURNAMENTS,
+                          playerDestroy(player));
+#else
+    ASSERT_TEST_WITH_FREE(playerGetTournamentsMapStats(player, &stats) == MAP_ERROR,
+                          playerDestroy(player));
+#endif
+    ASSERT_TEST_WITH_FREE(playerGetTournamentsMapStats(NULL, &stats) == MAP_NULL_ARGUMENT &&
+                          playerGetTournamentsMapStats(player, NULL) == MAP_NULL_ARGUMENT,
+                          playerDestroy(player));
+    playerDestroy(player);
+    return true;
+}
+
+
+bool testPlayerCopyChangesOneRecord()
+{
+    Player player = playerCreate(1);
+    ASSERT_TEST(player != NULL);
+    for (int tournament_id = 1 ; tournament_id <= PLAYER_TEST_MANY_TOURNAMENTS ; tournament_id++)
+    {
+        ASSERT_TEST_WITH_FREE(playerAddTournament(player, tournament_id, 2) == PLAYER_SUCCESS,
+                              playerDestroy(player));
+    }
+    Player copy = playerCopy(player);
+    ASSERT_TEST_WITH_FREE(copy != NULL, playerDestroy(player));
+
+    // The first changes of the copy copy only the record they change, if any
+    playerResetTournamentsMapStats(copy);
+    Game game = gameCreate(1, 1, 2, GAME_FIRST_PLAYER, 10, 0);
+    ASSERT_TEST_WITH_FREE(game != NULL &&
+                          playerAddTournament(copy, PLAYER_TEST_MANY_TOURNAMENTS + 1, 2) ==
+                          PLAYER_SUCCESS && playerAddGame(copy, game) == PLAYER_SUCCESS,
+                          (gameDestroy(game), playerDestroy(player), playerDestroy(copy)));
+    gameDestroy(game);
+#ifdef MAP_STATS
+    MapStats stats;
+    ASSERT_TEST_WITH_FREE(playerGetTournamentsMapStats(copy, &stats) == MAP_SUCCESS &&
+                          stats.copy_calls <= 1, (playerDestroy(player), playerDestroy(copy)));
+#endif
+    ASSERT_TEST_WITH_FREE(playerGetWinsInTournament(copy, 1) == 1 &&
+                          playerGetWinsInTournament(player, 1) == 0 &&
+                          playerIsPlayingInTournament(copy, PLAYER_TEST_MANY_TOURNAMENTS + 1) &&
+                          !playerIsPlayingInTournament(player, PLAYER_TEST_MANY_TOURNAMENTS + 1),
+                          (playerDestroy(player), playerDestroy(copy)));
+    playerDestroy(copy);
+    playerDestroy(player);
+    return true;
+}
+
+
+int main()
+{
+    RUN_TEST(testPlayerFewTournaments, "testPlayerFewTournaments");
+    RUN_TEST(testPlayerManyTournaments, "testPlayerManyTournaments");
+    RUN_TEST(testPlayerCopySharesRecords, "testPlayerCopySharesRecords");
+    RUN_TEST(testPlayerTournamentsStats, "testPlayerTournamentsStats");
+    RUN_TEST(testPlayerCopyChangesOneRecord, "testPlayerCopyChangesOneRecord");
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "snapshot.h"
+#include "test_utilities.h"
+
+#define SNAPSHOT_TEST_VALUES 10000  // More than fit in the writer's buffer
+
+
+// Writes a whole snapshot of the ints first..first + amount - 1. Returns false on failure
+static bool writeIntsSnapshot(const char *path, int first, int amount)
+{
+    SnapshotWriter writer = snapshotWriterCreate(path);
+    if (writer == NULL)
+    {
+        return false;
+    }
+    snapshotWriteInt(writer, amount);
+    for (int i = 0 ; i < amount ; i++)
+    {
+        snapshotWriteInt(writer, first + i);
+    }
+    return snapshotWriterClose(writer) == SNAPSHOT_SUCCESS;
+}
+
+// Checks that a snapshot has the ints first..first + amount - 1
+static bool snapshotHasInts(const char *path, int first, int amount)
+{
+    SnapshotReader reader = snapshotReaderCreate(path);
+    if (reader == NULL)
+    {
+        return false;
+    }
+    int count = 0;
+    bool is_equal = snapshotReadCount(reader, amount, SNAPSHOT_INT_SIZE, &count) &&
+                    count == amount;
+    for (int i = 0 ; i < count && is_equal ; i++)
+    {
+        int value = 0;
+        is_equal = snapshotReadInt(reader, &value) && value == first + i;
+    }
+    return snapshotReaderClose(reader) == SNAPSHOT_SUCCESS && is_equal;
+}
+
+// Checks whether a file exists
+static bool fileExists(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        return false;
+    }
+    fclose(file);
+    return true;
+}
+
+
+bool testSnapshotAbortKeepsPrevious()
+{
+    char path[] = "unit_snapshot.bin";
+    ASSERT_TEST(writeIntsSnapshot(path, 1, SNAPSHOT_TEST_VALUES));
+
+    // A snapshot that is given up on part-way leaves no trace
+    SnapshotWriter writer = snapshotWriterCreate(path);
+    ASSERT_TEST_WITH_FREE(writer != NULL, remove(path));
+    snapshotWriteInt(writer, SNAPSHOT_TEST_VALUES);
+    for (int i = 0 ; i < SNAPSHOT_TEST_VALUES / 2 ; i++)
+    {
+        snapshotWriteInt(writer, -i);
+    }
+    snapshotWriterAbort(writer);
+    snapshotWriterAbort(NULL);
+    bool is_kept = snapshotHasInts(path, 1, SNAPSHOT_TEST_VALUES) &&
+                   !fileExists("unit_snapshot.bin.tmp");
+
+    // A whole snapshot replaces it
+    bool is_replaced = writeIntsSnapshot(path, 7, 3) && snapshotHasInts(path, 7, 3);
+    remove(path);
+    ASSERT_TEST(is_kept && is_replaced);
+    return true;
+}
+
+
+bool testSnapshotCountBounds()
+{
+    char path[] = "unit_snapshot.bin";
+    ASSERT_TEST(writeIntsSnapshot(path, 1, 3));
+
+    // The count is valid for 3 ints, but not for more than the rest of the file holds
+    SnapshotReader reader = snapshotReaderCreate(path);
+    ASSERT_TEST_WITH_FREE(reader != NULL, remove(path));
+    int count = 0;
+    bool is_rejected = !snapshotReadCount(reader, 10, 2 * SNAPSHOT_INT_SIZE, &count) &&
+                       count == 0;
+    bool is_failed = snapshotReaderClose(reader) == SNAPSHOT_INVALID_FILE;
+    remove(path);
+    ASSERT_TEST(is_rejected && is_failed);
+    return true;
+}
+
+
+int main()
+{
+    RUN_TEST(testSnapshotAbortKeepsPrevious, "testSnapshotAbortKeepsPrevious");
+    RUN_TEST(testSnapshotCountBounds, "testSnapshotCountBounds");
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "standings.h"
+#include "test_utilities.h"
+
+#define STANDINGS_TEST_PLAYERS 100
+
+
+bool testStandingsOrder()
+{
+    Standings standings = standingsCreate();
+    ASSERT_TEST(standings != NULL);
+    ASSERT_TEST_WITH_FREE(standingsGetLeader(standings) == STANDINGS_NO_LEADER &&
+                          standingsGetSize(standings) == 0, standingsDestroy(standings));
+    for (int player_id = 1 ; player_id <= 4 ; player_id++)
+    {
+        ASSERT_TEST_WITH_FREE(standingsAdd(standings, player_id) == STANDINGS_SUCCESS,
+                              standingsDestroy(standings));
+    }
+    ASSERT_TEST_WITH_FREE(standingsAdd(standings, 2) == STANDINGS_PLAYER_ALREADY_EXISTS &&
+                          standingsGetSize(standings) == 4, standingsDestroy(standings));
+
+    // With no games, the smallest id leads
+    ASSERT_TEST_WITH_FREE(standingsGetLeader(standings) == 1, standingsDestroy(standings));
+
+    // A higher score leads
+    ASSERT_TEST_WITH_FREE(standingsUpdate(standings, 4, 2, 1, 0) == STANDINGS_SUCCESS &&
+                          standingsGetLeader(standings) == 4, standingsDestroy(standings));
+
+    // On an equal score, fewer losses lead
+    ASSERT_TEST_WITH_FREE(standingsUpdate(standings, 4, 2, 2, 2) == STANDINGS_SUCCESS &&
+                          standingsUpdate(standings, 3, 2, 1, 1) == STANDINGS_SUCCESS &&
+                          standingsGetLeader(standings) == 3, standingsDestroy(standings));
+
+    // On equal losses, more wins lead
+    ASSERT_TEST_WITH_FREE(standingsUpdate(standings, 2, 2, 2, 1) == STANDINGS_SUCCESS &&
+                          standingsGetLeader(standings) == 2, standingsDestroy(standings));
+
+    // On an equal record, the smaller id leads
+    ASSERT_TEST_WITH_FREE(standingsUpdate(standings, 3, 2, 2, 1) == STANDINGS_SUCCESS &&
+                          standingsGetLeader(standings) == 2, standingsDestroy(standings));
+    ASSERT_TEST_WITH_FREE(standingsUpdate(standings, 1, 2, 2, 1) == STANDINGS_SUCCESS &&
+                          standingsGetLeader(standings) == 1, standingsDestroy(standings));
+
+    // A lower score moves the leader down
+    ASSERT_TEST_WITH_FREE(standingsUpdate(standings, 1, 0, 0, 3) == STANDINGS_SUCCESS &&
+                          standingsGetLeader(standings) == 2, standingsDestroy(standings));
+
+    ASSERT_TEST_WITH_FREE(standingsUpdate(standings, 5, 1, 1, 1) == STANDINGS_PLAYER_NOT_EXIST &&
+                          standingsRemove(standings, 5) == STANDINGS_PLAYER_NOT_EXIST,
+                          standingsDestroy(standings));
+    standingsDestroy(standings);
+
+    ASSERT_TEST(standingsAdd(NULL, 1) == STANDINGS_NULL_ARGUMENT &&
+                standingsGetLeader(NULL) == STANDINGS_INVALID_INPUT &&
+                standingsGetSize(NULL) == STANDINGS_INVALID_INPUT);
+    return true;
+}
+
+
+bool testStandingsRemoveAndCopy()
+{
+    Standings standings = standingsCreate();
+    ASSERT_TEST(standings != NULL);
+
+    // Player i has a score of i, so the last one added leads
+    for (int player_id = 1 ; player_id <= STANDINGS_TEST_PLAYERS ; player_id++)
+    {
+        ASSERT_TEST_WITH_FREE(standingsAdd(standings, player_id) == STANDINGS_SUCCESS &&
+                              standingsUpdate(standings, player_id, player_id, 0, 0) ==
+                              STANDINGS_SUCCESS, standingsDestroy(standings));
+        ASSERT_TEST_WITH_FREE(standingsGetLeader(standings) == player_id,
+                              standingsDestroy(standings));
+    }
+
+    Standings copy = standingsCopy(standings);
+    ASSERT_TEST_WITH_FREE(copy != NULL, standingsDestroy(standings));
+
+    // Removing the leader each time passes the lead to the next one
+    for (int player_id = STANDINGS_TEST_PLAYERS ; player_id > 1 ; player_id--)
+    {
+        ASSERT_TEST_WITH_FREE(standingsRemove(standings, player_id) == STANDINGS_SUCCESS &&
+                              standingsGetLeader(standings) == player_id - 1,
+                              (standingsDestroy(standings), standingsDestroy(copy)));
+    }
+    ASSERT_TEST_WITH_FREE(standingsRemove(standings, 1) == STANDINGS_SUCCESS &&
+                          standingsGetLeader(standings) == STANDINGS_NO_LEADER &&
+                          standingsGetSize(standings) == 0,
+                          (standingsDestroy(standings), standingsDestroy(copy)));
+
+    // The copy is unchanged, and changes on its own
+    ASSERT_TEST_WITH_FREE(standingsGetSize(copy) == STANDINGS_TEST_PLAYERS &&
+                          standingsGetLeader(copy) == STANDINGS_TEST_PLAYERS,
+                          (standingsDestroy(standings), standingsDestroy(copy)));
+    ASSERT_TEST_WITH_FREE(standingsUpdate(copy, 1, 2 * STANDINGS_TEST_PLAYERS, 0, 0) ==
+                          STANDINGS_SUCCESS && standingsGetLeader(copy) == 1,
+                          (standingsDestroy(standings), standingsDestroy(copy)));
+    standingsDestroy(copy);
+    standingsDestroy(standings);
+    return true;
+}
+
+
+int main()
+{
+    RUN_TEST(testStandingsOrder, "testStandingsOrder");
+    RUN_TEST(testStandingsRemoveAndCopy, "testStandingsRemoveAndCopy");
+    return 0;
+}
@@ -0,0 +1,308 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tournament.h"
+#include "test_utilities.h"
+
+#define TOURNAMENT_TEST_GAMES 100
+#define TOURNAMENT_TEST_PLAYERS 100
+
+
+// Adds games first_game_id..(last_game_id - 1) to a tournament. Game i is between the
+// players i + 1 and i + 2, and lasts i + 1
+static bool tournamentAddTestGames(Tournament tournament, int first_game_id, int last_game_id)
+{
+    for (int game_id = first_game_id ; game_id < last_game_id ; game_id++)
+    {
+        if (tournamentAddGame(tournament, game_id + 1, game_id + 2, GAME_FIRST_PLAYER,
+                              game_id + 1, 0) != TOURNAMENT_SUCCESS)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Checks that a tournament holds exactly the games 0..(amount_of_games - 1) of
+// tournamentAddTestGames
+static bool tournamentHasTestGames(Tournament tournament, int amount_of_games)
+{
+    if (tournamentGetSizeGames(tournament) != amount_of_games ||
+        tournamentGetGame(tournament, amount_of_games) != NULL ||
+        tournamentGetGame(tournament, -1) != NULL)
+    {
+        return false;
+    }
+    for (int game_id = 0 ; game_id < amount_of_games ; game_id++)
+    {
+        Game game = tournamentGetGame(tournament, game_id);
+        if (game == NULL || gameGetID(game) != game_id ||
+            gameGetIdOfWinner(game) != game_id + 1 ||
+            gameGetPlayersOpponent(game, game_id + 1) != game_id + 2 ||
+            gameGetPlayTime(game) != game_id + 1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Checks that a tournament's participants are the ids 1..amount_of_ids, apart from
+// the given removed id, in any order
+static bool tournamentHasParticipants(Tournament tournament, int amount_of_ids, int removed_id)
+{
+    int expected_size = amount_of_ids - (removed_id >= 1 && removed_id <= amount_of_ids);
+    if (tournamentGetSizeParticipants(tournament) != expected_size)
+    {
+        return false;
+    }
+
+    bool *is_seen = calloc(amount_of_ids + 1, sizeof(*is_seen));
+    if (is_seen == NULL)
+    {
+        return false;
+    }
+    bool is_equal = true;
+    int *participants = tournamentGetParticipants(tournament);
+    for (int i = 0 ; i < expected_size ; i++)
+    {
+        int player_id = participants[i];
+        is_equal = is_equal && player_id >= 1 && player_id <= amount_of_ids &&
+                   player_id != removed_id && !is_seen[player_id];
+        if (is_equal)
+        {
+            is_seen[player_id] = true;
+        }
+    }
+    free(is_seen);
+    return is_equal;
+}
+
+
+bool testTournamentGames()
+{
+    Tournament tournament = tournamentCreate(1, 2, "London");
+    ASSERT_TEST(tournament != NULL);
+    ASSERT_TEST_WITH_FREE(tournamentHasTestGames(tournament, 0), tournamentDestroy(tournament));
+
+    // Adding games past the room there is at first grows the games storage
+    ASSERT_TEST_WITH_FREE(tournamentAddTestGames(tournament, 0, TOURNAMENT_TEST_GAMES) &&
+                          tournamentHasTestGames(tournament, TOURNAMENT_TEST_GAMES),
+                          tournamentDestroy(tournament));
+
+    // Games added to a copy don't reach the source
+    Tournament copy = tournamentCopy(tournament);
+    ASSERT_TEST_WITH_FREE(copy != NULL, tournamentDestroy(tournament));
+    ASSERT_TEST_WITH_FREE(tournamentAddTestGames(copy, TOURNAMENT_TEST_GAMES,
+                                                 2 * TOURNAMENT_TEST_GAMES) &&
+                          tournamentHasTestGames(copy, 2 * TOURNAMENT_TEST_GAMES) &&
+                          tournamentHasTestGames(tournament, TOURNAMENT_TEST_GAMES),
+                          (tournamentDestroy(tournament), tournamentDestroy(copy)));
+    tournamentDestroy(copy);
+
+    // Once ended, no games are added
+    ASSERT_TEST_WITH_FREE(tournamentEnd(tournament, 1) == TOURNAMENT_SUCCESS &&
+                          tournamentAddGame(tournament, 1, 2, GAME_DRAW, 1, 0) ==
+                          TOURNAMENT_ENDED &&
+                          tournamentHasTestGames(tournament, TOURNAMENT_TEST_GAMES),
+                          tournamentDestroy(tournament));
+    tournamentDestroy(tournament);
+    ASSERT_TEST(tournamentAddGame(NULL, 1, 2, GAME_DRAW, 1, 0) == TOURNAMENT_NULL_ARGUMENT &&
+                tournamentGetGame(NULL, 0) == NULL);
+    return true;
+}
+
+
+bool testTournamentParticipants()
+{
+    Tournament tournament = tournamentCreate(1, 2, "London");
+    ASSERT_TEST(tournament != NULL);
+    ASSERT_TEST_WITH_FREE(tournamentGetSizeParticipants(tournament) == 0 &&
+                          tournamentGetLeader(tournament) == INVALID_PLAYER,
+                          tournamentDestroy(tournament));
+
+    // More participants than there's room for at first
+    for (int player_id = 1 ; player_id <= TOURNAMENT_TEST_PLAYERS ; player_id++)
+    {
+        ASSERT_TEST_WITH_FREE(tournamentAddParticipant(tournament, player_id) ==
+                              TOURNAMENT_SUCCESS, tournamentDestroy(tournament));
+    }
+    ASSERT_TEST_WITH_FREE(tournamentAddParticipant(tournament, 1) == TOURNAMENT_INVALID_ID &&
+                          tournamentAddParticipant(tournament, 0) == TOURNAMENT_INVALID_ID,
+                          tournamentDestroy(tournament));
+    ASSERT_TEST_WITH_FREE(tournamentHasParticipants(tournament, TOURNAMENT_TEST_PLAYERS, 0) &&
+                          tournamentGetLeader(tournament) == 1, tournamentDestroy(tournament));
+
+    // A copy shares the participants until either tournament changes them
+    Tournament copy = tournamentCopy(tournament);
+    ASSERT_TEST_WITH_FREE(copy != NULL, tournamentDestroy(tournament));
+    ASSERT_TEST_WITH_FREE(tournamentGetParticipants(copy) == tournamentGetParticipants(tournament),
+                          (tournamentDestroy(tournament), tournamentDestroy(copy)));
+
+    // Removing a participant removes it from the standings too
+    ASSERT_TEST_WITH_FREE(tournamentRemoveParticipant(tournament, 1) == TOURNAMENT_SUCCESS &&
+                          tournamentRemoveParticipant(tournament, 1) == TOURNAMENT_INVALID_ID,
+                          (tournamentDestroy(tournament), tournamentDestroy(copy)));
+    ASSERT_TEST_WITH_FREE(tournamentHasParticipants(tournament, TOURNAMENT_TEST_PLAYERS, 1) &&
+                          tournamentGetLeader(tournament) == 2,
+                          (tournamentDestroy(tournament), tournamentDestroy(copy)));
+    ASSERT_TEST_WITH_FREE(tournamentHasParticipants(copy, TOURNAMENT_TEST_PLAYERS, 0) &&
+                          tournamentGetLeader(copy) == 1,
+                          (tournamentDestroy(tournament), tournamentDestroy(copy)));
+
+    // Standings changed or dropped by one tournament stay in the other
+    Tournament other_copy = tournamentCopy(copy);
+    ASSERT_TEST_WITH_FREE(other_copy != NULL,
+                          (tournamentDestroy(tournament), tournamentDestroy(copy)));
+    ASSERT_TEST_WITH_FREE(tournamentUpdateStanding(copy, 5, 1, 0, 0) == TOURNAMENT_SUCCESS &&
+                          tournamentGetLeader(copy) == 5 && tournamentGetLeader(other_copy) == 1,
+                          (tournamentDestroy(tournament), tournamentDestroy(copy),
+                           tournamentDestroy(other_copy)));
+    ASSERT_TEST_WITH_FREE(tournamentAddGame(other_copy, 1, 2, GAME_DRAW, 10, 2) ==
+                          TOURNAMENT_SUCCESS &&
+                          tournamentEnd(other_copy, 1) == TOURNAMENT_SUCCESS &&
+                          tournamentGetLeader(copy) == 5,
+                          (tournamentDestroy(tournament), tournamentDestroy(copy),
+                           tournamentDestroy(other_copy)));
+    tournamentDestroy(other_copy);
+    tournamentDestroy(copy);
+    tournamentDestroy(tournament);
+
+    ASSERT_TEST(tournamentAddParticipant(NULL, 1) == TOURNAMENT_NULL_ARGUMENT &&
+                tournamentGetParticipants(NULL) == NULL &&
+                tournamentGetSizeParticipants(NULL) == TOURNAMENT_INVALID_INPUT);
+    return true;
+}
+
+
+bool testTournamentRemovePlayer()
+{
+    Tournament tournament = tournamentCreate(1, 2, "London");
+    ASSERT_TEST(tournament != NULL);
+    ASSERT_TEST_WITH_FREE(tournamentAddParticipant(tournament, 1) == TOURNAMENT_SUCCESS &&
+                          tournamentAddParticipant(tournament, 2) == TOURNAMENT_SUCCESS &&
+                          tournamentAddParticipant(tournament, 3) == TOURNAMENT_SUCCESS,
+                          tournamentDestroy(tournament));
+    ASSERT_TEST_WITH_FREE(tournamentAddGame(tournament, 1, 2, GAME_FIRST_PLAYER, 10, 2) ==
+                          TOURNAMENT_SUCCESS &&
+                          tournamentAddGame(tournament, 2, 3, GAME_DRAW, 10, 1) ==
+                          TOURNAMENT_SUCCESS, tournamentDestroy(tournament));
+
+    // Player 1 is removed from the participants, and its game goes to player 2
+    int game_ids[2] = { 0, INVALID_GAME_ID };
+    ASSERT_TEST_WITH_FREE(tournamentRemovePlayer(tournament, 1, game_ids) == TOURNAMENT_SUCCESS,
+                          tournamentDestroy(tournament));
+    ASSERT_TEST_WITH_FREE(tournamentGetSizeParticipants(tournament) == 2 &&
+                          tournamentGetSizePlayers(tournament) == 3,
+                          tournamentDestroy(tournament));
+    int *participants = tournamentGetParticipants(tournament);
+    ASSERT_TEST_WITH_FREE((participants[0] == 2 && participants[1] == 3) ||
+                          (participants[0] == 3 && participants[1] == 2),
+                          tournamentDestroy(tournament));
+
+    // Once ended, no participants are added
+    ASSERT_TEST_WITH_FREE(tournamentEnd(tournament, 2) == TOURNAMENT_SUCCESS &&
+                          tournamentAddParticipant(tournament, 4) == TOURNAMENT_ENDED &&
+                          tournamentGetLeader(tournament) == 2, tournamentDestroy(tournament));
+    tournamentDestroy(tournament);
+    return true;
+}
+
+
+bool testTournamentCopySharesGames()
+{
+    Tournament tournament = tournamentCreate(1, 2, "London");
+    ASSERT_TEST(tournament != NULL);
+    ASSERT_TEST_WITH_FREE(tournamentAddParticipant(tournament, 1) == TOURNAMENT_SUCCESS &&
+                          tournamentAddParticipant(tournament, 2) == TOURNAMENT_SUCCESS &&
+                          tournamentAddParticipant(tournament, 3) == TOURNAMENT_SUCCESS,
+                          tournamentDestroy(tournament));
+    ASSERT_TEST_WITH_FREE(tournamentAddGame(tournament, 1, 2, GAME_FIRST_PLAYER, 10, 2) ==
+                          TOURNAMENT_SUCCESS &&
+                          tournamentAddGame(tournament, 2, 3, GAME_DRAW, 10, 1) ==
+                          TOURNAMENT_SUCCESS, tournamentDestroy(tournament));
+    Tournament copy = tournamentCopy(tournament);
+    ASSERT_TEST_WITH_FREE(copy != NULL, tournamentDestroy(tournament));
+
+    // Reading the games doesn't copy them
+    ASSERT_TEST_WITH_FREE(tournamentGetGame(copy, 0) == tournamentGetGame(tournament, 0) &&
+                          tournamentGetGame(copy, 1) == tournamentGetGame(tournament, 1),
+                          (tournamentDestroy(tournament), tournamentDestroy(copy)));
+
+    // Removing a player copies only the games of that player
+    int game_ids[2] = { 0, INVALID_GAME_ID };
+    ASSERT_TEST_WITH_FREE(tournamentRemovePlayer(copy, 1, game_ids) == TOURNAMENT_SUCCESS,
+                          (tournamentDestroy(tournament), tournamentDestroy(copy)));
+    ASSERT_TEST_WITH_FREE(gameGetIdOfWinner(tournamentGetGame(copy, 0)) == 2 &&
+                          gameGetIdOfWinner(tournamentGetGame(tournament, 0)) == 1 &&
+                          gameisPlayerInGame(tournamentGetGame(tournament, 0), 1) &&
+                          tournamentGetGame(copy, 1) == tournamentGetGame(tournament, 1),
+                          (tournamentDestroy(tournament), tournamentDestroy(copy)));
+
+    // The games the tournaments still share outlive either of them
+    tournamentDestroy(tournament);
+    ASSERT_TEST_WITH_FREE(gameGetIdOfWinner(tournamentGetGame(copy, 1)) == INVALID_PLAYER &&
+                          gameisPlayerInGame(tournamentGetGame(copy, 1), 3),
+                          tournamentDestroy(copy));
+    tournamentDestroy(copy);
+    return true;
+}
+
+
+bool testTournamentReserveGames()
+{
+    Tournament tournament = tournamentCreate(1, 2, "London");
+    ASSERT_TEST(tournament != NULL);
+
+    // Adding games past the room there is at first grows the games storage
+    ASSERT_TEST_WITH_FREE(tournamentAddTestGames(tournament, 0, TOURNAMENT_TEST_GAMES / 4) &&
+                          tournamentHasTestGames(tournament, TOURNAMENT_TEST_GAMES / 4),
+                          tournamentDestroy(tournament));
+
+    // Reserving room for many games at once, and more than the room left
+    ASSERT_TEST_WITH_FREE(tournamentReserveGames(tournament, 0) == TOURNAMENT_SUCCESS &&
+                          tournamentReserveGames(tournament, TOURNAMENT_TEST_GAMES / 4) ==
+                          TOURNAMENT_SUCCESS &&
+                          tournamentHasTestGames(tournament, TOURNAMENT_TEST_GAMES / 4),
+                          tournamentDestroy(tournament));
+    ASSERT_TEST_WITH_FREE(tournamentAddTestGames(tournament, TOURNAMENT_TEST_GAMES / 4,
+                                                 TOURNAMENT_TEST_GAMES / 2) &&
+                          tournamentReserveGames(tournament, TOURNAMENT_TEST_GAMES) ==
+                          TOURNAMENT_SUCCESS &&
+                          tournamentAddTestGames(tournament, TOURNAMENT_TEST_GAMES / 2,
+                                                 TOURNAMENT_TEST_GAMES) &&
+                          tournamentHasTestGames(tournament, TOURNAMENT_TEST_GAMES),
+                          tournamentDestroy(tournament));
+
+    // Reserving for a copy leaves the games of the source as they are
+    Tournament copy = tournamentCopy(tournament);
+    ASSERT_TEST_WITH_FREE(copy != NULL, tournamentDestroy(tournament));
+    ASSERT_TEST_WITH_FREE(tournamentReserveGames(copy, 2 * TOURNAMENT_TEST_GAMES) ==
+                          TOURNAMENT_SUCCESS &&
+                          tournamentAddTestGames(copy, TOURNAMENT_TEST_GAMES,
+                                                 2 * TOURNAMENT_TEST_GAMES) &&
+                          tournamentHasTestGames(copy, 2 * TOURNAMENT_TEST_GAMES) &&
+                          tournamentHasTestGames(tournament, TOURNAMENT_TEST_GAMES) &&
+                          tournamentGetGame(copy, 0) == tournamentGetGame(tournament, 0),
+                          (tournamentDestroy(tournament), tournamentDestroy(copy)));
+    tournamentDestroy(copy);
+
+    // Once ended, no room is reserved
+    ASSERT_TEST_WITH_FREE(tournamentEnd(tournament, 1) == TOURNAMENT_SUCCESS &&
+                          tournamentReserveGames(tournament, 1) == TOURNAMENT_ENDED,
+                          tournamentDestroy(tournament));
+    tournamentDestroy(tournament);
+    ASSERT_TEST(tournamentReserveGames(NULL, 1) == TOURNAMENT_NULL_ARGUMENT);
+    return true;
+}
+
+
+int main()
+{
+    RUN_TEST(testTournamentGames, "testTournamentGames");
+    RUN_TEST(testTournamentParticipants, "testTournamentParticipants");
+    RUN_TEST(testTournamentRemovePlayer, "testTournamentRemovePlayer");
+    RUN_TEST(testTournamentCopySharesGames, "testTournamentCopySharesGames");
+    RUN_TEST(testTournamentReserveGames, "testTournamentReserveGames");
+    return 0;
+}
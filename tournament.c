@@ -2,15 +2,19 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <string.h>
+#include <limits.h>
 
-#include "./mtm_map/map.h"
-#include "mapUtil.h"
 #include "tournament.h"
+#include "standings.h"
 
+#define TOURNAMENT_INITIAL_GAMES_CAPACITY 4
+#define TOURNAMENT_INITIAL_PARTICIPANTS_CAPACITY 4
 
 struct tournament_t {
     int tournament_id;
-    Map games;
+    Game *games;          // Indexed by game id - ids are given sequentially from 0
+    int games_capacity;
+    int *games_share_count; // Copies share the games until one of them changes, NULL if not shared
     int max_games_per_player;
     int winner;
     int longest_game;
@@ -18,6 +22,12 @@ struct tournament_t {
     char *location;
     int current_game_id;
     int amount_of_players;
+    int *participants;      // The ids of the players in the tournament, unordered
+    int participants_capacity;
+    int amount_of_participants;
+    int *participants_share_count; // Like games_share_count, for the participants
+    Standings standings;    // The live standings of the participants, NULL once ended
+    int *standings_share_count;    // Like games_share_count, for the standings
 };
 
 
@@ -58,6 +68,170 @@ static bool isSpace(const char *character)
     return *character == ' ';
 }
 
+// Makes sure the games array has room for one more game, doubling it if needed
+static bool tournamentReserveGame(Tournament tournament)
+{
+    if (tournament->current_game_id < tournament->games_capacity)
+    {
+        return true;
+    }
+
+    int new_capacity = tournament->games_capacity * 2;
+    Game *new_games  = realloc(tournament->games, new_capacity * sizeof(*new_games));
+    if (new_games == NULL)
+    {
+        return false;
+    }
+
+    tournament->games          = new_games;
+    tournament->games_capacity = new_capacity;
+    return true;
+}
+
+// Makes sure the participants array has room for one more participant, doubling it if needed
+static bool tournamentReserveParticipant(Tournament tournament)
+{
+    assert(tournament->participants_share_count == NULL);
+    if (tournament->amount_of_participants < tournament->participants_capacity)
+    {
+        return true;
+    }
+
+    int new_capacity  = tournament->participants_capacity * 2;
+    int *new_participants = realloc(tournament->participants,
+                                    new_capacity * sizeof(*new_participants));
+    if (new_participants == NULL)
+    {
+        return false;
+    }
+
+    tournament->participants          = new_participants;
+    tournament->participants_capacity = new_capacity;
+    return true;
+}
+
+// Makes sure a part of the tournament has a share count, so that copies can share it
+static bool tournamentCreateShareCount(int **share_count)
+{
+    if (*share_count == NULL)
+    {
+        *share_count = malloc(sizeof(**share_count));
+        if (*share_count == NULL)
+        {
+            return false;
+        }
+        **share_count = 1;
+    }
+    return true;
+}
+
+// Gives up the tournament's hold on a part it may share with copies of it. Returns true
+// if no copy holds the part anymore - the part is the tournament's own then
+static bool tournamentReleaseShared(int **share_count)
+{
+    if (*share_count == NULL)
+    {
+        return true;
+    }
+
+    (**share_count)--;
+    bool is_last = **share_count == 0;
+    if (is_last)
+    {
+        free(*share_count);
+    }
+    *share_count = NULL;
+    return is_last;
+}
+
+// Returns whether other tournaments hold a part of the tournament
+static bool tournamentIsShared(const int *share_count)
+{
+    return share_count != NULL && *share_count > 1;
+}
+
+// Gives the tournament a games array of its own if it shares it with copies of it.
+// The games themselves stay shared (see gameShare) until one of them changes
+static bool tournamentUnshareGames(Tournament tournament)
+{
+    // Not shared (or the other tournaments are gone), the array is this tournament's own
+    if (!tournamentIsShared(tournament->games_share_count))
+    {
+        tournamentReleaseShared(&(tournament->games_share_count));
+        return true;
+    }
+
+    Game *games = malloc(tournament->games_capacity * sizeof(*games));
+    if (games == NULL)
+    {
+        return false;
+    }
+
+    for (int i = 0 ; i < tournament->current_game_id ; i++)
+    {
+        games[i] = gameShare(tournament->games[i]);
+    }
+
+    tournamentReleaseShared(&(tournament->games_share_count));
+    tournament->games = games;
+    return true;
+}
+
+// Gives the tournament participants and standings of its own, if it shares them with
+// copies of it. Nothing changes if an allocation fails
+static bool tournamentUnshareParticipants(Tournament tournament)
+{
+    int *participants = tournament->participants;
+    if (tournamentIsShared(tournament->participants_share_count))
+    {
+        participants = malloc(tournament->participants_capacity * sizeof(*participants));
+        if (participants == NULL)
+        {
+            return false;
+        }
+        memcpy(participants, tournament->participants,
+               tournament->amount_of_participants * sizeof(*participants));
+    }
+
+    Standings standings = tournament->standings;
+    if (tournamentIsShared(tournament->standings_share_count))
+    {
+        standings = standingsCopy(tournament->standings);
+        if (standings == NULL)
+        {
+            if (participants != tournament->participants)
+            {
+                free(participants);
+            }
+            return false;
+        }
+    }
+
+    tournamentReleaseShared(&(tournament->participants_share_count));
+    tournamentReleaseShared(&(tournament->standings_share_count));
+    tournament->participants = participants;
+    tournament->standings    = standings;
+    return true;
+}
+
+// Returns a game of the tournament that may be changed, copying it first if it is shared
+// with copies of the tournament. The games array must be the tournament's own
+static Game tournamentGetOwnGame(Tournament tournament, int game_id)
+{
+    assert(tournament->games_share_count == NULL);
+    if (game_id < 0 || game_id >= tournament->current_game_id)
+    {
+        return NULL;
+    }
+
+    Game game = gameUnshare(tournament->games[game_id]);
+    if (game != NULL)
+    {
+        tournament->games[game_id] = game;
+    }
+    return game;
+}
+
 // Copies the location string (if valid), returning the copy
 static char* copyLocation (const char *location)
 {
@@ -92,23 +266,35 @@ Tournament tournamentCreate(int tournament_id, int max_games_per_player,
         return NULL;
     }
     
-    // Allocate new game map
-    tournament->games = createGamesMap();
+    // Allocate new games array
+    tournament->games = malloc(TOURNAMENT_INITIAL_GAMES_CAPACITY * sizeof(*(tournament->games)));
     if(tournament->games == NULL)
     {
         free(tournament);
         return NULL;
     }
+    tournament->games_capacity    = TOURNAMENT_INITIAL_GAMES_CAPACITY;
+    tournament->games_share_count = NULL;
 
     // Validating location, copy it to the struct
-    if (!tournamentValidateLocation(tournament_location))
+    tournament->location     = copyLocation(tournament_location);
+    if (tournament->location == NULL)
     {
+        free(tournament->games);
+        free(tournament);
         return NULL;
     }
 
-    tournament->location     = copyLocation(tournament_location);
-    if (tournament->location == NULL)
+    tournament->participants = malloc(TOURNAMENT_INITIAL_PARTICIPANTS_CAPACITY *
+                                      sizeof(*(tournament->participants)));
+    tournament->standings    = standingsCreate();
+    if (tournament->participants == NULL || tournament->standings == NULL)
     {
+        standingsDestroy(tournament->standings);
+        free(tournament->participants);
+        free(tournament->location);
+        free(tournament->games);
+        free(tournament);
         return NULL;
     }
 
@@ -120,6 +306,10 @@ Tournament tournamentCreate(int tournament_id, int max_games_per_player,
     tournament->total_game_time      = 0;
     tournament->current_game_id      = 0;
     tournament->amount_of_players    = 0;
+    tournament->participants_capacity  = TOURNAMENT_INITIAL_PARTICIPANTS_CAPACITY;
+    tournament->amount_of_participants = 0;
+    tournament->participants_share_count = NULL;
+    tournament->standings_share_count    = NULL;
 
     return tournament;
 } 
@@ -131,7 +321,24 @@ void tournamentDestroy(Tournament tournament)
     {
         return;
     }
-    mapDestroy(tournament->games);
+
+    // The parts that copies still use are left to them
+    if (tournamentReleaseShared(&(tournament->games_share_count)))
+    {
+        for (int i = 0 ; i < tournament->current_game_id ; i++)
+        {
+            gameDestroy(tournament->games[i]);
+        }
+        free(tournament->games);
+    }
+    if (tournamentReleaseShared(&(tournament->standings_share_count)))
+    {
+        standingsDestroy(tournament->standings);
+    }
+    if (tournamentReleaseShared(&(tournament->participants_share_count)))
+    {
+        free(tournament->participants);
+    }
     free(tournament->location);
     free(tournament);
 }
@@ -145,31 +352,35 @@ Tournament tournamentCopy(Tournament tournament)
         return NULL;
     }
 
-    // Creating coppied struct
-    Tournament new_tournament = tournamentCreate(tournament->tournament_id,
-                                tournament->max_games_per_player, tournament->location);
-    if (new_tournament == NULL)
+    // The copy shares the games, participants and standings (an ended tournament has none).
+    // They are copied once either tournament changes them
+    if (!tournamentCreateShareCount(&(tournament->games_share_count)) ||
+        !tournamentCreateShareCount(&(tournament->participants_share_count)) ||
+        (tournament->standings != NULL &&
+         !tournamentCreateShareCount(&(tournament->standings_share_count))))
     {
         return NULL;
     }
 
-    // Copy map, freeing the previous one
-    Map game_map = mapCopy(tournament->games);
-    if (game_map == NULL)
+    Tournament new_tournament = malloc(sizeof(*new_tournament));
+    if (new_tournament == NULL)
+    {
+        return NULL;
+    }
+    *new_tournament = *tournament;
+    new_tournament->location = copyLocation(tournament->location);
+    if (new_tournament->location == NULL)
     {
         free(new_tournament);
         return NULL;
     }
-    mapDestroy(new_tournament->games);
-    new_tournament->games = game_map;
-
-    // Copy fields
-    new_tournament->amount_of_players = tournament->amount_of_players;
-    new_tournament->current_game_id   = tournament->current_game_id;
-    new_tournament->longest_game      = tournament->longest_game;
-    new_tournament->total_game_time   = tournament->total_game_time;
-    new_tournament->winner            = tournament->winner;
 
+    (*(tournament->games_share_count))++;
+    (*(tournament->participants_share_count))++;
+    if (tournament->standings != NULL)
+    {
+        (*(tournament->standings_share_count))++;
+    }
     return new_tournament;
 }
 
@@ -198,22 +409,20 @@ TournamentResult tournamentAddGame(Tournament tournament, int first_player, int
         return TOURNAMENT_ENDED;
     }
 
-    // Creating game struct & adding it to the games map
-    Game new_game = gameCreate(tournament->tournament_id, first_player, second_player,
-               winner, play_time, tournament->current_game_id);
-    
-    if (new_game == NULL)
+    // Creating game struct & appending it to the games array (its id is its index)
+    if (!tournamentUnshareGames(tournament) || !tournamentReserveGame(tournament))
     {
         return TOURNAMENT_OUT_OF_MEMORY;
     }
 
-    MapResult map_put_result = mapPut(tournament->games, &(tournament->current_game_id), new_game);
-    gameDestroy(new_game);
-
-    if (map_put_result == MAP_OUT_OF_MEMORY)  // Otherwise assuming MAP_SUCCESS
+    Game new_game = gameCreate(tournament->tournament_id, first_player, second_player,
+               winner, play_time, tournament->current_game_id);
+    
+    if (new_game == NULL)
     {
         return TOURNAMENT_OUT_OF_MEMORY;
     }
+    tournament->games[tournament->current_game_id] = new_game;
 
     // Update statistics
     if (play_time > tournament->longest_game)
@@ -228,6 +437,46 @@ TournamentResult tournamentAddGame(Tournament tournament, int first_player, int
 }
 
 
+TournamentResult tournamentReserveGames(Tournament tournament, int amount_of_games)
+{
+    if (tournament == NULL)
+    {
+        return TOURNAMENT_NULL_ARGUMENT;
+    }
+
+    if (tournament->winner != INVALID_PLAYER)
+    {
+        return TOURNAMENT_ENDED;
+    }
+
+    // The games are about to change, copy them first if they are shared
+    if (!tournamentUnshareGames(tournament))
+    {
+        return TOURNAMENT_OUT_OF_MEMORY;
+    }
+
+    int new_capacity = tournament->games_capacity;
+    while (new_capacity - tournament->current_game_id < amount_of_games)
+    {
+        new_capacity *= 2;
+    }
+    if (new_capacity == tournament->games_capacity)
+    {
+        return TOURNAMENT_SUCCESS;
+    }
+
+    Game *new_games = realloc(tournament->games, new_capacity * sizeof(*new_games));
+    if (new_games == NULL)
+    {
+        return TOURNAMENT_OUT_OF_MEMORY;
+    }
+
+    tournament->games          = new_games;
+    tournament->games_capacity = new_capacity;
+    return TOURNAMENT_SUCCESS;
+}
+
+
 TournamentResult tournamentRemovePlayer(Tournament tournament, int player_id, int game_ids[])
 {
     // Input verification
@@ -246,24 +495,35 @@ TournamentResult tournamentRemovePlayer(Tournament tournament, int player_id, in
         return TOURNAMENT_ENDED;
     }
 
+    if (!tournamentUnshareGames(tournament) || !tournamentUnshareParticipants(tournament))
+    {
+        return TOURNAMENT_OUT_OF_MEMORY;
+    }
 
-    // Scan games, remove player from games
-    for (int i = 0 ; i < tournament->max_games_per_player ; i++)
+    // Get games of the tournament's own first, so that nothing changes if that fails
+    int amount_of_games = 0;
+    while (amount_of_games < tournament->max_games_per_player &&
+           game_ids[amount_of_games] != INVALID_GAME_ID)
     {
-        // Extra breaking point
-        if (game_ids[i] == INVALID_GAME_ID)
+        if (game_ids[amount_of_games] < 0 ||
+            game_ids[amount_of_games] >= tournament->current_game_id)
         {
-            break;
+            return TOURNAMENT_INVALID_ID; // Program should never get here
         }
-        Game game = mapGet(tournament->games, &game_ids[i]);
-        if (game == NULL)
+        if (tournamentGetOwnGame(tournament, game_ids[amount_of_games]) == NULL)
         {
-            return TOURNAMENT_INVALID_ID; // Program should never get here
+            return TOURNAMENT_OUT_OF_MEMORY;
         }
+        amount_of_games++;
+    }
 
-        gameRemovePlayer(game, player_id);
+    // Scan games, remove player from games
+    for (int i = 0 ; i < amount_of_games ; i++)
+    {
+        gameRemovePlayer(tournament->games[game_ids[i]], player_id);
     }
 
+    tournamentRemoveParticipant(tournament, player_id);
     return TOURNAMENT_SUCCESS;
 }
 
@@ -282,12 +542,149 @@ TournamentResult tournamentEnd (Tournament tournament, int winner_id)
         
     }
     
-    // Update winner field
+    // Update winner field. The standings aren't needed anymore once there's a winner -
+    // without one (no participants are left) the tournament stays active
     tournament->winner = winner_id;
+    if (winner_id != INVALID_PLAYER)
+    {
+        if (tournamentReleaseShared(&(tournament->standings_share_count)))
+        {
+            standingsDestroy(tournament->standings);
+        }
+        tournament->standings = NULL;
+    }
+    return TOURNAMENT_SUCCESS;
+}
+
+
+TournamentResult tournamentAddParticipant(Tournament tournament, int player_id)
+{
+    if (tournament == NULL)
+    {
+        return TOURNAMENT_NULL_ARGUMENT;
+    }
+
+    if (player_id <= 0)
+    {
+        return TOURNAMENT_INVALID_ID;
+    }
+
+    if (tournament->winner != INVALID_PLAYER)
+    {
+        return TOURNAMENT_ENDED;
+    }
+
+    // Allocate everything before changing anything
+    if (!tournamentUnshareParticipants(tournament) || !tournamentReserveParticipant(tournament))
+    {
+        return TOURNAMENT_OUT_OF_MEMORY;
+    }
+    StandingsResult add_result = standingsAdd(tournament->standings, player_id);
+    if (add_result != STANDINGS_SUCCESS)
+    {
+        return add_result == STANDINGS_OUT_OF_MEMORY ? TOURNAMENT_OUT_OF_MEMORY :
+                                                       TOURNAMENT_INVALID_ID;
+    }
+
+    tournament->participants[tournament->amount_of_participants] = player_id;
+    (tournament->amount_of_participants)++;
+    return TOURNAMENT_SUCCESS;
+}
+
+
+TournamentResult tournamentRemoveParticipant(Tournament tournament, int player_id)
+{
+    if (tournament == NULL)
+    {
+        return TOURNAMENT_NULL_ARGUMENT;
+    }
+
+    // The last participant takes the removed one's place
+    for (int i = 0 ; i < tournament->amount_of_participants ; i++)
+    {
+        if (tournament->participants[i] == player_id)
+        {
+            if (!tournamentUnshareParticipants(tournament))
+            {
+                return TOURNAMENT_OUT_OF_MEMORY;
+            }
+            (tournament->amount_of_participants)--;
+            tournament->participants[i] =
+                tournament->participants[tournament->amount_of_participants];
+            standingsRemove(tournament->standings, player_id);
+            return TOURNAMENT_SUCCESS;
+        }
+    }
+    return TOURNAMENT_INVALID_ID;
+}
+
+
+int *tournamentGetParticipants(Tournament tournament)
+{
+    if (tournament == NULL)
+    {
+        return NULL;
+    }
+    return tournament->participants;
+}
+
+
+int tournamentGetSizeParticipants(Tournament tournament)
+{
+    if (tournament == NULL)
+    {
+        return TOURNAMENT_INVALID_INPUT;
+    }
+    return tournament->amount_of_participants;
+}
+
+
+TournamentResult tournamentUpdateStanding(Tournament tournament, int player_id,
+                                          int wins, int draws, int losses)
+{
+    if (tournament == NULL)
+    {
+        return TOURNAMENT_NULL_ARGUMENT;
+    }
+
+    if (tournament->winner != INVALID_PLAYER)
+    {
+        return TOURNAMENT_ENDED;
+    }
+
+    if (!tournamentUnshareParticipants(tournament))
+    {
+        return TOURNAMENT_OUT_OF_MEMORY;
+    }
+
+    int score = wins   * TOURNAMENT_WIN_WEIGHT  +
+                draws  * TOURNAMENT_DRAW_WEIGHT +
+                losses * TOURNAMENT_LOSS_WEIGHT;
+    if (standingsUpdate(tournament->standings, player_id, score, wins, losses) != STANDINGS_SUCCESS)
+    {
+        return TOURNAMENT_INVALID_ID;
+    }
     return TOURNAMENT_SUCCESS;
 }
 
 
+int tournamentGetLeader(Tournament tournament)
+{
+    if (tournament == NULL)
+    {
+        return TOURNAMENT_INVALID_INPUT;
+    }
+
+    if (tournament->winner != INVALID_PLAYER)
+    {
+        return tournament->winner;
+    }
+
+    int leader = standingsGetLeader(tournament->standings);
+    return leader == STANDINGS_NO_LEADER ? INVALID_PLAYER : leader;
+}
+
+
 int tournamentGetSizePlayers (Tournament tournament)
 {
     if (tournament == NULL)
@@ -308,6 +705,16 @@ int tournamentGetSizeGames (Tournament tournament)
 }
 
 
+int tournamentGetID(Tournament tournament)
+{
+    if (tournament == NULL)
+    {
+        return TOURNAMENT_INVALID_INPUT;
+    }
+    return tournament->tournament_id;
+}
+
+
 int tournamentGetWinner(Tournament tournament)
 {
     if (tournament == NULL)
@@ -374,12 +781,11 @@ int tournamentGetMaxGamesPerPlayer(Tournament tournament)
 
 Game tournamentGetGame(Tournament tournament, int game_id)
 {
-    if (tournament == NULL)
+    if (tournament == NULL || game_id < 0 || game_id >= tournament->current_game_id)
     {
         return NULL;
     }
-
-    return mapGet(tournament->games, &game_id);
+    return tournament->games[game_id];
 }
 
 
@@ -411,4 +817,137 @@ bool tournamentPrintStatsToFile(Tournament tournament, FILE *output_file)
     }
 
     return true;
-}
\ No newline at end of file
+}
+
+
+void tournamentWriteSnapshot(Tournament tournament, SnapshotWriter writer)
+{
+    if (tournament == NULL)
+    {
+        return;
+    }
+
+    snapshotWriteInt(writer, tournament->tournament_id);
+    snapshotWriteInt(writer, tournament->max_games_per_player);
+    snapshotWriteString(writer, tournament->location);
+    snapshotWriteInt(writer, tournament->winner);
+    snapshotWriteInt(writer, tournament->longest_game);
+    snapshotWriteInt(writer, tournament->total_game_time);
+    snapshotWriteInt(writer, tournament->amount_of_players);
+
+    snapshotWriteInt(writer, tournament->current_game_id);
+    for (int i = 0 ; i < tournament->current_game_id ; i++)
+    {
+        gameWriteSnapshot(tournament->games[i], writer);
+    }
+
+    snapshotWriteInt(writer, tournament->amount_of_participants);
+    snapshotWriteInts(writer, tournament->participants, tournament->amount_of_participants);
+}
+
+
+Tournament tournamentReadSnapshot(SnapshotReader reader)
+{
+    int tournament_id        = 0;
+    int max_games_per_player = 0;
+    if (!snapshotReadInt(reader, &tournament_id) || !snapshotReadInt(reader, &max_games_per_player))
+    {
+        return NULL;
+    }
+
+    char *location = snapshotReadString(reader);
+    if (location == NULL)
+    {
+        return NULL;
+    }
+    if (max_games_per_player <= 0 || !tournamentValidateLocation(location))
+    {
+        free(location);
+        snapshotReaderFail(reader, SNAPSHOT_INVALID_FILE);
+        return NULL;
+    }
+
+    Tournament tournament = tournamentCreate(tournament_id, max_games_per_player, location);
+    free(location);
+    if (tournament == NULL)
+    {
+        snapshotReaderFail(reader, SNAPSHOT_OUT_OF_MEMORY);
+        return NULL;
+    }
+
+    int winner          = INVALID_PLAYER;
+    int amount_of_games = 0;
+    if (!snapshotReadInt(reader, &winner)                          ||
+        !snapshotReadInt(reader, &(tournament->longest_game))      ||
+        !snapshotReadInt(reader, &(tournament->total_game_time))   ||
+        !snapshotReadInt(reader, &(tournament->amount_of_players)) ||
+        !snapshotReadCount(reader, INT_MAX / (int)sizeof(Game), SNAPSHOT_INT_SIZE,
+                           &amount_of_games))
+    {
+        tournamentDestroy(tournament);
+        return NULL;
+    }
+
+    // The games, with room for all of them at once
+    if (tournamentReserveGames(tournament, amount_of_games) != TOURNAMENT_SUCCESS &&
+        amount_of_games > 0)
+    {
+        snapshotReaderFail(reader, SNAPSHOT_OUT_OF_MEMORY);
+        tournamentDestroy(tournament);
+        return NULL;
+    }
+    for ( ; tournament->current_game_id < amount_of_games ; (tournament->current_game_id)++)
+    {
+        Game game = gameReadSnapshot(reader, tournament_id, tournament->current_game_id);
+        if (game == NULL)
+        {
+            tournamentDestroy(tournament);
+            return NULL;
+        }
+        tournament->games[tournament->current_game_id] = game;
+    }
+
+    // The participants. An ended tournament has no standings
+    int amount_of_participants = 0;
+    if (!snapshotReadCount(reader, INT_MAX / (int)sizeof(int), SNAPSHOT_INT_SIZE,
+                           &amount_of_participants))
+    {
+        tournamentDestroy(tournament);
+        return NULL;
+    }
+    if (winner != INVALID_PLAYER)
+    {
+        tournament->winner = winner;
+        standingsDestroy(tournament->standings);
+        tournament->standings = NULL;
+    }
+    for (int i = 0 ; i < amount_of_participants ; i++)
+    {
+        int player_id = 0;
+        if (!snapshotReadInt(reader, &player_id))
+        {
+            tournamentDestroy(tournament);
+            return NULL;
+        }
+
+        StandingsResult add_result = STANDINGS_SUCCESS;
+        if (!tournamentReserveParticipant(tournament))
+        {
+            add_result = STANDINGS_OUT_OF_MEMORY;
+        }
+        else if (tournament->standings != NULL)
+        {
+            add_result = standingsAdd(tournament->standings, player_id);
+        }
+        if (add_result != STANDINGS_SUCCESS)
+        {
+            snapshotReaderFail(reader, add_result == STANDINGS_OUT_OF_MEMORY ?
+                                       SNAPSHOT_OUT_OF_MEMORY : SNAPSHOT_INVALID_FILE);
+            tournamentDestroy(tournament);
+            return NULL;
+        }
+        tournament->participants[tournament->amount_of_participants] = player_id;
+        (tournament->amount_of_participants)++;
+    }
+    return tournament;
+}
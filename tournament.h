@@ -9,6 +9,7 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include "game.h"
+#include "snapshot.h"
 
 typedef enum {
     TOURNAMENT_OUT_OF_MEMORY,
@@ -54,6 +55,9 @@ void tournamentDestroy(Tournament tournament);
 
 /**
  * tournamentCopy: copies a given tournament
+ *                 The copy shares the games, participants and standings of the source
+ *                 tournament until either of them changes them, so copying doesn't
+ *                 depend on the amount of games or participants.
  *
  * @param tournament - the tournament to copy
  * @return
@@ -87,7 +91,23 @@ TournamentResult tournamentAddGame(Tournament tournament, int first_player, int
 
 
 /**
- * tournamentRemovePlayer: removes the player from the tournament.
+ * tournamentReserveGames: makes room for more games in the tournament, so adding them
+ *                         doesn't grow the games storage again.
+ *
+ * @param tournament - the tournament. Must be non-NULL.
+ * @param amount_of_games - the amount of games about to be added.
+ *
+ * @return
+ *     TOURNAMENT_NULL_ARGUMENT - if tournament is NULL.
+ *     TOURNAMENT_ENDED         - if the tournament has already ended
+ *     TOURNAMENT_OUT_OF_MEMORY - if there was an allocation issue
+ *     TOURNAMENT_SUCCESS       - otherwise
+ */
+TournamentResult tournamentReserveGames(Tournament tournament, int amount_of_games);
+
+
+/**
+ * tournamentRemovePlayer: removes the player from the tournament (see tournamentRemoveParticipant).
  *                      In games where the player has participated and not yet ended,
  *                      the opponent is the winner automatically after removal.
  *
@@ -99,6 +119,7 @@ TournamentResult tournamentAddGame(Tournament tournament, int first_player, int
  * @return
  *     TOURNAMENT_NULL_ARGUMENT - if tournament is NULL.
  *     TOURNAMENT_INVALID_ID - if the player ID number is invalid.
+ *     TOURNAMENT_OUT_OF_MEMORY - if there was an allocation issue
  *     TOURNAMENT_SUCCESS - if player was removed successfully.
  */
 TournamentResult tournamentRemovePlayer(Tournament tournament, int player_id, int game_ids[]);
@@ -120,6 +141,110 @@ TournamentResult tournamentRemovePlayer(Tournament tournament, int player_id, in
 TournamentResult tournamentEnd (Tournament tournament, int winner_id);
 
 
+/**
+ * tournamentAddParticipant: adds a player to the participants of the tournament, and to
+ *                           its live standings with no wins, draws or losses.
+ *                           Nothing is changed on failure.
+ *
+ * @param tournament - the tournament
+ * @param player_id  - the id of the player. Must not be a participant already.
+ *
+ * @return
+ *     TOURNAMENT_NULL_ARGUMENT - if tournament is NULL.
+ *     TOURNAMENT_INVALID_ID    - if the id is invalid, or the player is a participant already
+ *     TOURNAMENT_ENDED         - if the tournament has already ended
+ *     TOURNAMENT_OUT_OF_MEMORY - if there was an allocation issue
+ *     TOURNAMENT_SUCCESS       - otherwise
+ */
+TournamentResult tournamentAddParticipant(Tournament tournament, int player_id);
+
+
+/**
+ * tournamentRemoveParticipant: removes a player from the participants of the tournament
+ *                              (and its standings). The games are left as they are -
+ *                              see tournamentRemovePlayer.
+ *
+ * @param tournament - the tournament
+ * @param player_id  - the id of the participant
+ *
+ * @return
+ *     TOURNAMENT_NULL_ARGUMENT - if tournament is NULL.
+ *     TOURNAMENT_INVALID_ID    - if the player is not a participant
+ *     TOURNAMENT_OUT_OF_MEMORY - if the participants were shared with a copy of the
+ *                                tournament, and copying them failed
+ *     TOURNAMENT_SUCCESS       - otherwise
+ */
+TournamentResult tournamentRemoveParticipant(Tournament tournament, int player_id);
+
+
+/**
+ * tournamentGetParticipants: returns the ids of the tournament's participants, in no
+ *                            particular order. The array belongs to the tournament, and
+ *                            is valid until its participants change.
+ *
+ * @param tournament - the tournament
+ *
+ * @return
+ *     NULL - if tournament is NULL
+ *     The participants array (of size tournamentGetSizeParticipants) otherwise
+ */
+int *tournamentGetParticipants(Tournament tournament);
+
+
+/**
+ * tournamentGetSizeParticipants: returns the amount of current participants in the
+ *                                tournament. Unlike tournamentGetSizePlayers, removed
+ *                                players are not counted.
+ *
+ * @param tournament - the tournament
+ *
+ * @return
+ *     TOURNAMENT_INVALID_INPUT - if the input tournament is not valid
+ *     The amount of participants otherwise
+ */
+int tournamentGetSizeParticipants(Tournament tournament);
+
+
+/**
+ * tournamentUpdateStanding: sets the record of a participant in the live standings.
+ *                           The participant is ranked by their score, then by fewer
+ *                           losses, then by more wins, then by smaller id.
+ *                           Allocates memory only if the standings are shared with a
+ *                           copy of the tournament.
+ *
+ * @param tournament - the tournament
+ * @param player_id  - the id of the participant
+ * @param wins       - the participant's wins in the tournament
+ * @param draws      - the participant's draws in the tournament
+ * @param losses     - the participant's losses in the tournament
+ *
+ * @return
+ *     TOURNAMENT_NULL_ARGUMENT - if tournament is NULL.
+ *     TOURNAMENT_INVALID_ID    - if the player is not in the standings
+ *     TOURNAMENT_ENDED         - if the tournament has already ended
+ *     TOURNAMENT_OUT_OF_MEMORY - if copying the shared standings failed
+ *     TOURNAMENT_SUCCESS       - otherwise
+ */
+TournamentResult tournamentUpdateStanding(Tournament tournament, int player_id,
+                                          int wins, int draws, int losses);
+
+
+/**
+ * tournamentGetLeader: returns the participant leading the live standings, in constant
+ *                      time. Participants are removed from the standings by
+ *                      tournamentRemovePlayer.
+ *
+ * @param tournament - the tournament
+ *
+ * @return
+ *     The winner - if the tournament has ended
+ *     INVALID_PLAYER - if the tournament has no participants
+ *     TOURNAMENT_INVALID_INPUT - if the input tournament is not valid
+ *     The id of the leading participant otherwise
+ */
+int tournamentGetLeader(Tournament tournament);
+
+
 /**
  * tournamentGetSizePlayers: The function will return the number of unique players
  *                  in a given tournament
@@ -146,6 +271,18 @@ int tournamentGetSizePlayers (Tournament tournament);
 int tournamentGetSizeGames (Tournament tournament);
 
 
+/**
+ * tournamentGetID: The function will return the ID of a given tournament
+ *
+ * @param tournament - the tournament
+ *
+ * @return
+ *     The ID of the tournament
+ *     TOURNAMENT_INVALID_INPUT - if the input tournament is not valid
+ */
+int tournamentGetID(Tournament tournament);
+
+
 /**
  * tournamentGetWinner: The function will return the winner of
  *                     a given tournament
@@ -197,14 +334,17 @@ int tournamentGetMaxGamesPerPlayer(Tournament tournament);
 
 
 /**
- * tournamentGetGame: The function returns a game with a given ID from a given tournament
+ * tournamentGetGame: The function returns a game with a given ID from a given tournament.
+ *                    Games are stored by id, so this is a constant time lookup.
+ *                    The game may be shared with copies of the tournament, so it
+ *                    must not be changed (tournamentRemovePlayer changes games).
  *
  * @param tournament - the tournament
  * @param game_id    - the id of the needed game
  *
  * @return
  *     The game with the given ID
- *     NULL - if the tournament is NULL
+ *     NULL - if the tournament is NULL or has no game with that ID
  */
 Game tournamentGetGame(Tournament tournament, int game_id);
 
@@ -222,4 +362,27 @@ Game tournamentGetGame(Tournament tournament, int game_id);
  */
 bool tournamentPrintStatsToFile(Tournament tournament, FILE *output_file);
 
+
+/**
+ * tournamentWriteSnapshot: writes a tournament, with its games and participants, to a
+ *                          snapshot. The standings aren't written - see tournamentReadSnapshot.
+ *
+ * @param tournament - the tournament
+ * @param writer - the snapshot writer
+ */
+void tournamentWriteSnapshot(Tournament tournament, SnapshotWriter writer);
+
+
+/**
+ * tournamentReadSnapshot: reads a tournament written by tournamentWriteSnapshot. If the
+ *                         tournament is active, its participants are put in its standings
+ *                         with no wins, draws or losses - their records should be set by
+ *                         tournamentUpdateStanding.
+ *
+ * @param reader - the snapshot reader
+ * @return
+ *     A new Tournament in case of success, and NULL otherwise (the reader then fails)
+ */
+Tournament tournamentReadSnapshot(SnapshotReader reader);
+
 #endif //  _TOURNAMENT_H
\ No newline at end of file